@@ -0,0 +1,57 @@
+// Measures the time to parse a single escape-heavy string. Decoding escape
+// sequences used to copy the rest of the string for each backslash, which
+// took quadratic time.
+//
+// usage: bench_escape [size in MiB (default: 1)]
+
+#include <toml.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <cstdlib>
+
+// a string that contains an escape sequence every few characters
+std::string escaped_body(const std::size_t size, const bool multiline)
+{
+    std::string body;
+    body.reserve(size + 64);
+    while(body.size() < size)
+    {
+        body += "tab\\tquote\\\"uni\\u00E9\\U0001F600 ";
+        if(multiline)
+        {
+            body += "line \\\n    continued\n";
+        }
+    }
+    return body;
+}
+
+void run(const std::string& name, const std::string& content)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto v = toml::parse_str(content);
+    const auto stop = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> sec = stop - start;
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(8) << sec.count() << " sec, "
+              << std::setprecision(1) << std::setw(8)
+              << static_cast<double>(content.size()) / sec.count() / (1024.0 * 1024.0)
+              << " MiB/s (" << v.at("s").as_string().size() << " bytes)\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = 1024 * 1024;
+    if(argc == 2)
+    {
+        size = static_cast<std::size_t>(std::atol(argv[1])) * 1024 * 1024;
+    }
+
+    run("basic",     "s = \""   + escaped_body(size, false) + "\"\n");
+    run("multiline", "s = \"\"\"" + escaped_body(size, true)  + "\"\"\"\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Compares the size of the values and the throughput of parsing and copying a
+// document between toml::type_config and a type_config with discard_format.
+//
+// usage: bench_format [size in MiB (default: 8)]
+
+#include <toml.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <cstdlib>
+
+struct no_format_config : toml::type_config
+{
+    using format_type = toml::discard_format;
+};
+
+// tables of scalar values
+std::string scalars(const std::size_t size)
+{
+    std::ostringstream oss;
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "[item" << i << "]\n";
+        oss << "id      = " << i << "\n";
+        oss << "mask    = 0x" << std::hex << i << std::dec << "\n";
+        oss << "ratio   = " << static_cast<double>(i) * 0.125 << "\n";
+        oss << "name    = \"item " << i << "\"\n";
+        oss << "enabled = true\n";
+        oss << "updated = 1979-05-27T07:32:00Z\n";
+        oss << "values  = [" << i << ", " << i + 1 << ", " << i + 2 << "]\n";
+        ++i;
+    }
+    return oss.str();
+}
+
+double mib_per_second(const std::size_t bytes, const std::chrono::duration<double> sec)
+{
+    return static_cast<double>(bytes) / sec.count() / (1024.0 * 1024.0);
+}
+
+template<typename TC>
+void run(const std::string& name, const std::string& content)
+{
+    const auto parse_start = std::chrono::steady_clock::now();
+    const auto v = toml::parse_str<TC>(content);
+    const auto parse_stop = std::chrono::steady_clock::now();
+
+    const auto copy_start = std::chrono::steady_clock::now();
+    const auto w = v;
+    const auto copy_stop = std::chrono::steady_clock::now();
+
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+              << "sizeof: " << std::setw(4) << sizeof(toml::basic_value<TC>)
+              << std::setprecision(1)
+              << ", parse: " << std::setw(8) << mib_per_second(content.size(), parse_stop - parse_start)
+              << " MiB/s, copy: " << std::setw(8) << mib_per_second(content.size(), copy_stop - copy_start)
+              << " MiB/s (" << w.as_table().size() << " tables)\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = 8 * 1024 * 1024;
+    if(argc == 2)
+    {
+        size = static_cast<std::size_t>(std::atol(argv[1])) * 1024 * 1024;
+    }
+
+    const auto content = scalars(size);
+    run<toml::type_config>("preserve_format", content);
+    run<no_format_config >("discard_format",  content);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Measures the throughput of toml::parse for synthetic documents.
+//
+// usage: bench_parse [size in MiB (default: 8)]
+
+#include <toml.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <cstdlib>
+
+// indented tables with many comment lines
+std::string commented(const std::size_t size)
+{
+    std::ostringstream oss;
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "# ------------------------------------------------------------\n";
+        oss << "# section " << i << ". this comment describes the table below\n";
+        oss << "# ------------------------------------------------------------\n";
+        oss << "[section" << i << "]\n";
+        oss << "    # the name of this section\n";
+        oss << "    name    = \"section " << i << "\" # trailing comment\n";
+        oss << "\n";
+        oss << "    # whether it is enabled or not\n";
+        oss << "    enabled = true\n";
+        oss << "    count   = " << i << "\n";
+        ++i;
+    }
+    return oss.str();
+}
+
+// long arrays of numbers
+std::string numeric(const std::size_t size)
+{
+    std::ostringstream oss;
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "series" << i << " = [";
+        for(std::size_t j=0; j<64; ++j)
+        {
+            oss << (j == 0 ? "" : ", ") << (i * 64 + j) * 0.125 << ", " << i * 64 + j;
+        }
+        oss << "]\n";
+        ++i;
+    }
+    return oss.str();
+}
+
+// a large array of integers in various formats
+std::string integers(const std::size_t size)
+{
+    std::ostringstream oss;
+    oss << "ints = [\n";
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "    " << i * 7919 << ", -" << i << ", 1_000_" << (i % 1000 + 100)
+            << ", 0x" << std::hex << i << std::dec << ", 0o755, 0b1010_0101,\n";
+        ++i;
+    }
+    oss << "]\n";
+    return oss.str();
+}
+
+// a large array of floating-point numbers with full precision
+std::string floats(const std::size_t size)
+{
+    std::ostringstream oss;
+    oss << std::setprecision(17) << "floats = [\n";
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        const double x = static_cast<double>(i) + 0.1;
+        oss << "    " << x / 3.0 << ", " << -x * 1.0e-300 << ", " << x * 6.02e23
+            << ", " << std::fixed << x / 7.0 << std::defaultfloat << ",\n";
+        ++i;
+    }
+    oss << "]\n";
+    return oss.str();
+}
+
+// long strings
+std::string strings(const std::size_t size)
+{
+    const std::string blob(4000, 'A');
+    std::ostringstream oss;
+    std::size_t i = 0;
+    while(static_cast<std::size_t>(oss.tellp()) < size)
+    {
+        oss << "cert" << i << " = \"" << blob << "\"\n";
+        oss << "sql"  << i << " = '" << "SELECT * FROM table WHERE id = ? AND name = ?" << "'\n";
+        ++i;
+    }
+    return oss.str();
+}
+
+void run(const std::string& name, const std::string& content)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto v = toml::parse_str(content);
+    const auto stop = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> sec = stop - start;
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(8)
+              << static_cast<double>(content.size()) / sec.count() / (1024.0 * 1024.0)
+              << " MiB/s (" << v.as_table().size() << " keys)\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = 8 * 1024 * 1024;
+    if(argc == 2)
+    {
+        size = static_cast<std::size_t>(std::atol(argv[1])) * 1024 * 1024;
+    }
+
+    run("commented", commented(size));
+    run("numeric",   numeric(size));
+    run("integers",  integers(size));
+    run("floats",    floats(size));
+    run("strings",   strings(size));
+    return 0;
+}
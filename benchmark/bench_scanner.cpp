@@ -0,0 +1,107 @@
+// Compares the throughput of the virtual scanners in syntax.hpp and the
+// statically composed scanners in static_scanner.hpp.
+//
+// usage: bench_scanner [size in MiB (default: 16)]
+
+#include <toml11/static_scanner.hpp>
+#include <toml11/syntax.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+using char_type = toml::detail::location::char_type;
+
+// repeat tokens separated by newlines until it reaches `size` bytes.
+toml::detail::location
+make_input(const std::vector<std::string>& tokens, const std::size_t size)
+{
+    std::vector<char_type> buf;
+    buf.reserve(size + 128);
+    while(buf.size() < size)
+    {
+        for(const auto& tk : tokens)
+        {
+            buf.insert(buf.end(), tk.begin(), tk.end());
+            buf.push_back(char_type('\n'));
+        }
+    }
+    return toml::detail::location(
+        toml::detail::make_source(std::move(buf)), "benchmark");
+}
+
+template<typename F>
+double bytes_per_second(toml::detail::location loc, F scan)
+{
+    const auto size = loc.source()->size();
+    const auto start = std::chrono::steady_clock::now();
+    while( ! loc.eof())
+    {
+        if( ! scan(loc).is_ok())
+        {
+            std::cerr << "failed to scan at " << loc.get_location() << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        loc.advance(); // newline
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> sec = stop - start;
+    return static_cast<double>(size) / sec.count();
+}
+
+template<typename StaticScanner>
+void run(const std::string& name, const toml::detail::scanner_base& before,
+         const std::vector<std::string>& tokens, const std::size_t size)
+{
+    const auto spec = toml::spec::default_version();
+    const auto input = make_input(tokens, size);
+
+    const auto b = bytes_per_second(input, [&before](toml::detail::location& loc) {
+            return before.scan(loc);
+        });
+    const auto a = bytes_per_second(input, [&spec](toml::detail::location& loc) {
+            return toml::detail::static_scanner::scan<StaticScanner>(loc, spec);
+        });
+
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+              << std::setprecision(1)
+              << " before: " << std::setw(8) << b / (1024.0 * 1024.0) << " MiB/s"
+              << ", after: " << std::setw(8) << a / (1024.0 * 1024.0) << " MiB/s"
+              << " (x" << std::setprecision(2) << a / b << ")\n";
+}
+
+int main(int argc, char** argv)
+{
+    namespace ss = toml::detail::static_scanner;
+
+    std::size_t size = 16 * 1024 * 1024;
+    if(argc == 2)
+    {
+        size = static_cast<std::size_t>(std::atol(argv[1])) * 1024 * 1024;
+    }
+    const auto spec = toml::spec::default_version();
+
+    run<ss::key>("key", toml::detail::syntax::key(spec), {
+            "name", "server.host", "a.b.\"c.d\".e", "'literal key'",
+            "database.connection_max", "owner . name"
+        }, size);
+
+    run<ss::basic_string>("basic_string", toml::detail::syntax::basic_string(spec), {
+            "\"\"", "\"hello, world\"", "\"tab\\tand newline\\n\"",
+            "\"\\u00E9t\\u00E9 \\U0001F600\"",
+            "\"Lorem ipsum dolor sit amet, consectetur adipiscing elit\"",
+            "\"\xE3\x81\x93\xE3\x82\x93\xE3\x81\xAB\xE3\x81\xA1\xE3\x81\xAF\""
+        }, size);
+
+    run<ss::floating>("floating", toml::detail::syntax::floating(spec), {
+            "3.14159", "-0.01", "6.626e-34", "5e+22", "224_617.445_991_228",
+            "+inf", "nan", "1.0"
+        }, size);
+
+    return 0;
+}
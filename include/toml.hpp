@@ -24,6 +24,7 @@
 // THE SOFTWARE.
 
 // IWYU pragma: begin_exports
+#include "toml11/arena.hpp"
 #include "toml11/color.hpp"
 #include "toml11/comments.hpp"
 #include "toml11/compat.hpp"
@@ -31,23 +32,34 @@
 #include "toml11/conversion.hpp"
 #include "toml11/datetime.hpp"
 #include "toml11/error_info.hpp"
+#include "toml11/event_handler.hpp"
 #include "toml11/exception.hpp"
+#include "toml11/fail_fast.hpp"
 #include "toml11/find.hpp"
+#include "toml11/float_parser.hpp"
 #include "toml11/format.hpp"
 #include "toml11/from.hpp"
 #include "toml11/get.hpp"
 #include "toml11/into.hpp"
+#include "toml11/key_pool.hpp"
+#include "toml11/lazy_document.hpp"
 #include "toml11/literal.hpp"
 #include "toml11/location.hpp"
 #include "toml11/ordered_map.hpp"
+#include "toml11/parallel.hpp"
 #include "toml11/parser.hpp"
 #include "toml11/region.hpp"
 #include "toml11/result.hpp"
 #include "toml11/scanner.hpp"
+#include "toml11/section_reader.hpp"
+#include "toml11/select.hpp"
 #include "toml11/serializer.hpp"
+#include "toml11/simd.hpp"
 #include "toml11/skip.hpp"
+#include "toml11/source_buffer.hpp"
 #include "toml11/source_location.hpp"
 #include "toml11/spec.hpp"
+#include "toml11/static_scanner.hpp"
 #include "toml11/storage.hpp"
 #include "toml11/syntax.hpp"
 #include "toml11/traits.hpp"
@@ -0,0 +1,10 @@
+#ifndef TOML11_ARENA_HPP
+#define TOML11_ARENA_HPP
+
+#include "fwd/arena_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/arena_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_ARENA_HPP
@@ -1,23 +1,85 @@
 #ifndef TOML11_CONTEXT_HPP
 #define TOML11_CONTEXT_HPP
 
+#include "comments.hpp"
 #include "error_info.hpp"
+#include "fail_fast.hpp"
+#include "key_pool.hpp"
+#include "select.hpp"
 #include "spec.hpp"
+#include "traits.hpp"
+#include "utility.hpp"
 
+#include <string>
 #include <vector>
 
+#include <cstddef>
+
 namespace toml
 {
+
+template<typename TypeConfig>
+class event_handler;
+
 namespace detail
 {
 
+// makes a key from a parsed string.
+template<typename Key>
+struct key_builder
+{
+    template<typename S>
+    static Key invoke(key_pool&, S&& s)
+    {
+        return string_conv<Key>(std::forward<S>(s));
+    }
+};
+
+// the keys in a document share their bytes.
+template<>
+struct key_builder<interned_key>
+{
+    template<typename S>
+    static interned_key invoke(key_pool& pool, const S& s)
+    {
+        return pool.intern(std::string(s.begin(), s.end()));
+    }
+};
+
+// appends a comment line.
+template<typename Comments>
+struct comment_appender
+{
+    static void invoke(comment_pool_ptr&, Comments& com, std::string c)
+    {
+        com.push_back(std::move(c));
+    }
+};
+
+// the comments in a document share one pool.
+template<>
+struct comment_appender<pooled_comments>
+{
+    static void invoke(comment_pool_ptr& pool, pooled_comments& com, std::string c)
+    {
+        if( ! pool)
+        {
+            pool = make_comment_pool();
+        }
+        com.append(pool, c);
+    }
+};
+
 template<typename TypeConfig>
 class context
 {
   public:
 
     explicit context(const spec& toml_spec)
-        : toml_spec_(toml_spec), errors_{}
+        : toml_spec_(toml_spec), errors_{}, handler_(nullptr),
+          filter_(nullptr), filter_node_(0), fail_fast_(false), failed_(false),
+          failure_code_(parse_error_code::syntax), failure_offset_(0),
+          failure_source_(nullptr), keys_{}, comments_{}
     {}
 
     bool has_error() const noexcept {return !errors_.empty();}
@@ -30,8 +92,20 @@ class context
     spec&       toml_spec()       noexcept {return toml_spec_;}
     spec const& toml_spec() const noexcept {return toml_spec_;}
 
-    void report_error(error_info err)
+    void report_error(error_info err,
+                      const parse_error_code code = parse_error_code::syntax)
     {
+        if(this->fail_fast_ && ! this->failed_)
+        {
+            this->failed_       = true;
+            this->failure_code_ = code;
+            if( ! err.locations().empty())
+            {
+                const auto& r = err.locations().front().first.region();
+                this->failure_offset_ = r.first();
+                this->failure_source_ = r.source();
+            }
+        }
         this->errors_.push_back(std::move(err));
     }
 
@@ -43,10 +117,83 @@ class context
         return e;
     }
 
+    // if set, the parser reports the values to the handler instead of
+    // keeping them in the tree. See parse_events.
+    event_handler<TypeConfig>* handler() const noexcept {return handler_;}
+    void set_handler(event_handler<TypeConfig>* h) noexcept {handler_ = h;}
+
+    // if set, the parser builds only the selected keys. `filter_node` is the
+    // node of the table that is being parsed. See toml::select.
+    key_filter<TypeConfig> const* filter() const noexcept {return filter_;}
+    void set_filter(const key_filter<TypeConfig>* f) noexcept
+    {
+        filter_      = f;
+        filter_node_ = key_filter<TypeConfig>::root();
+    }
+
+    std::size_t filter_node() const noexcept {return filter_node_;}
+    void set_filter_node(const std::size_t n) noexcept {filter_node_ = n;}
+
+    // if set, the parser stops at the first error instead of recovering from
+    // it. Only the kind and the position of the first error are kept after
+    // the error is popped. See try_parse(..., fail_fast).
+    bool fail_fast() const noexcept {return fail_fast_;}
+    void set_fail_fast(const bool b) noexcept {fail_fast_ = b;}
+
+    bool should_stop() const noexcept {return fail_fast_ && failed_;}
+
+    parse_error_code failure_code()   const noexcept {return failure_code_;}
+    std::size_t      failure_offset() const noexcept {return failure_offset_;}
+    // the source (or the section of it) that failure_offset() points into
+    source_ptr const& failure_source() const noexcept {return failure_source_;}
+
+    // The parser calls it with a const context. `TC` delays the instantiation
+    // until TypeConfig becomes complete.
+    template<typename S, typename TC = TypeConfig>
+    typename config_key_type<TC>::type make_key(S&& s) const
+    {
+        using key_type = typename config_key_type<TC>::type;
+        return key_builder<key_type>::invoke(this->keys_, std::forward<S>(s));
+    }
+
+    // appends a comment line to the comments of a value.
+    template<typename Comments>
+    void push_comment(Comments& com, std::string c) const
+    {
+        comment_appender<Comments>::invoke(this->comments_, com, std::move(c));
+    }
+    // moves the comments in `src` to the end of `dst`.
+    template<typename Comments>
+    void move_comments(Comments& dst, Comments& src) const
+    {
+        if(dst.empty())
+        {
+            dst = std::move(src);
+        }
+        else
+        {
+            for(std::string c : src)
+            {
+                this->push_comment(dst, std::move(c));
+            }
+        }
+        src.clear();
+    }
+
   private:
 
     spec toml_spec_;
     std::vector<error_info> errors_;
+    event_handler<TypeConfig>* handler_;
+    key_filter<TypeConfig> const* filter_;
+    std::size_t filter_node_;
+    bool fail_fast_;
+    bool failed_;
+    parse_error_code failure_code_;
+    std::size_t failure_offset_;
+    source_ptr  failure_source_;
+    mutable key_pool keys_; // used if the key_type is interned_key
+    mutable comment_pool_ptr comments_; // used if the comment_type is pooled_comments
 };
 
 } // detail
@@ -0,0 +1,103 @@
+#ifndef TOML11_EVENT_HANDLER_HPP
+#define TOML11_EVENT_HANDLER_HPP
+
+#include "value.hpp"
+
+#include <string>
+#include <vector>
+
+namespace toml
+{
+
+// Receives the contents of a TOML file from `toml::parse_events` without
+// constructing a `basic_value` tree.
+//
+// The events are reported in the order of the file while it is parsed. All the
+// member functions do nothing by default, so override the ones you need.
+//
+// If the file has an error, the events that precede the error are reported,
+// and the last value may be reported partially (e.g. `on_array_begin()`
+// without `on_array_end()`). Then `parse_events` reports the error.
+//
+// ```toml
+// # comment
+// a.b = [1, {c = "foo"}]
+// [[table]]
+// ```
+//
+// is reported as
+//
+// ```
+// on_comment("# comment")
+// on_key({"a", "b"})
+// on_array_begin()
+//     on_integer(1)
+//     on_inline_table_begin()
+//         on_key({"c"})
+//         on_string("foo")
+//     on_inline_table_end()
+// on_array_end()
+// on_table_header({"table"}, true)
+// ```
+//
+template<typename TypeConfig>
+class event_handler
+{
+  public:
+
+    using config_type          = TypeConfig;
+    using value_type           = basic_value<config_type>;
+    using key_type             = typename value_type::key_type;
+    using boolean_type         = typename value_type::boolean_type;
+    using integer_type         = typename value_type::integer_type;
+    using floating_type        = typename value_type::floating_type;
+    using string_type          = typename value_type::string_type;
+    using local_time_type      = typename value_type::local_time_type;
+    using local_date_type      = typename value_type::local_date_type;
+    using local_datetime_type  = typename value_type::local_datetime_type;
+    using offset_datetime_type = typename value_type::offset_datetime_type;
+
+  public:
+
+    virtual ~event_handler() = default;
+
+    // [table.keys] or [[array.of.tables]]
+    virtual void on_table_header(const std::vector<key_type>& keys,
+                                 const bool is_array_of_tables)
+    {
+        (void)keys; (void)is_array_of_tables;
+    }
+
+    // `keys = ` of a key-value pair. The value follows.
+    // In an inline table, the keys are relative to the inline table.
+    virtual void on_key(const std::vector<key_type>& keys) {(void)keys;}
+
+    // `null`. Only with `spec::ext_null_value`.
+    virtual void on_null() {}
+
+    virtual void on_boolean        (const boolean_type         x) {(void)x;}
+    virtual void on_integer        (const integer_type         x) {(void)x;}
+    virtual void on_floating       (const floating_type        x) {(void)x;}
+    virtual void on_string         (const string_type&         x) {(void)x;}
+    virtual void on_offset_datetime(const offset_datetime_type& x) {(void)x;}
+    virtual void on_local_datetime (const local_datetime_type&  x) {(void)x;}
+    virtual void on_local_date     (const local_date_type&      x) {(void)x;}
+    virtual void on_local_time     (const local_time_type&      x) {(void)x;}
+
+    virtual void on_array_begin() {}
+    virtual void on_array_end()   {}
+
+    // the keys in an inline table are reported in the order of the file.
+    virtual void on_inline_table_begin() {}
+    virtual void on_inline_table_end()   {}
+
+    // a comment is reported before the key, the table header, or the array
+    // element it belongs to. A comment that follows a value (e.g. `a = 1 # c`)
+    // is reported after the value. The comments before the first key-value
+    // pair that are separated by an empty line belong to the root table and
+    // are reported first.
+    virtual void on_comment(const std::string& com) {(void)com;}
+};
+
+} // toml
+#endif // TOML11_EVENT_HANDLER_HPP
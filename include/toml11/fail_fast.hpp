@@ -0,0 +1,10 @@
+#ifndef TOML11_FAIL_FAST_HPP
+#define TOML11_FAIL_FAST_HPP
+
+#include "fwd/fail_fast_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/fail_fast_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_FAIL_FAST_HPP
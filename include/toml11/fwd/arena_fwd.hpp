@@ -0,0 +1,181 @@
+#ifndef TOML11_ARENA_FWD_HPP
+#define TOML11_ARENA_FWD_HPP
+
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+
+namespace toml
+{
+
+//
+// A memory pool for the values that are parsed in an arena_scope.
+//
+// It reserves memory in large blocks and hands out chunks whose sizes are
+// rounded up to a power of two. A deallocated chunk is kept in a free list of
+// its size and reused, so the temporaries of the parser do not pile up. The
+// blocks are released at once when the arena is destroyed.
+//
+// The values must be destroyed or moved out before the arena is destroyed.
+// It is not thread-safe.
+//
+class value_arena
+{
+  public:
+
+    explicit value_arena(const std::size_t block_size = 64 * 1024);
+    ~value_arena() = default;
+
+    value_arena(const value_arena&) = delete;
+    value_arena(value_arena&&)      = delete;
+    value_arena& operator=(const value_arena&) = delete;
+    value_arena& operator=(value_arena&&)      = delete;
+
+    // `bytes` must be the same in allocate and deallocate. It throws
+    // std::bad_alloc if `bytes` exceeds max_chunk_size().
+    void* allocate(const std::size_t bytes);
+    void  deallocate(void* p, const std::size_t bytes) noexcept;
+
+    // the number of bytes reserved from the system
+    std::size_t capacity() const noexcept {return capacity_;}
+
+    // every chunk is aligned to this
+    static constexpr std::size_t alignment() noexcept {return alignof(std::max_align_t);}
+
+    // the largest chunk, the largest power of two in std::size_t
+    static constexpr std::size_t max_chunk_size() noexcept
+    {
+        return (std::numeric_limits<std::size_t>::max)() / 2 + 1;
+    }
+
+  private:
+
+    struct free_chunk
+    {
+        free_chunk* next;
+    };
+
+    static std::size_t size_class(const std::size_t bytes) noexcept;
+
+  private:
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks_;
+    std::vector<free_chunk*> free_lists_; // indexed by size_class
+    unsigned char* current_;
+    std::size_t    rest_;
+    std::size_t    block_size_;
+    std::size_t    capacity_;
+};
+
+//
+// While it is alive, the arena_allocators that are constructed in this thread
+// draw from the arena. The scopes can be nested.
+//
+class arena_scope
+{
+  public:
+
+    explicit arena_scope(value_arena& arena) noexcept;
+    ~arena_scope() noexcept;
+
+    arena_scope(const arena_scope&) = delete;
+    arena_scope(arena_scope&&)      = delete;
+    arena_scope& operator=(const arena_scope&) = delete;
+    arena_scope& operator=(arena_scope&&)      = delete;
+
+  private:
+
+    value_arena* previous_;
+};
+
+namespace detail
+{
+// the arena of the innermost arena_scope in this thread, or nullptr
+value_arena*& current_arena() noexcept;
+} // detail
+
+//
+// An allocator that draws from the arena of the current arena_scope when it
+// is constructed. If there is no scope, it uses the global operator new.
+//
+// Since the containers in basic_value are constructed without an allocator,
+// the arena is passed through the scope. A copy of a container uses the arena
+// of the scope where it is copied. A moved container keeps its arena.
+//
+template<typename T>
+class arena_allocator
+{
+    template<typename U>
+    friend class arena_allocator;
+
+  public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template<typename U>
+    struct rebind {using other = arena_allocator<U>;};
+
+  public:
+
+    arena_allocator() noexcept: arena_(detail::current_arena()) {}
+    explicit arena_allocator(value_arena* a) noexcept: arena_(a) {}
+
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept: arena_(other.arena_) {}
+
+    T* allocate(const std::size_t n)
+    {
+        static_assert(alignof(T) <= value_arena::alignment(),
+                      "toml::arena_allocator does not support over-aligned types");
+        if(this->arena_)
+        {
+            return static_cast<T*>(this->arena_->allocate(n * sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, const std::size_t n) noexcept
+    {
+        if(this->arena_)
+        {
+            this->arena_->deallocate(p, n * sizeof(T));
+        }
+        else
+        {
+            ::operator delete(p);
+        }
+        return;
+    }
+
+    arena_allocator select_on_container_copy_construction() const noexcept
+    {
+        return arena_allocator();
+    }
+
+    value_arena* arena() const noexcept {return arena_;}
+
+  private:
+
+    value_arena* arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+{
+    return lhs.arena() == rhs.arena();
+}
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+{
+    return lhs.arena() != rhs.arena();
+}
+
+} // toml
+#endif // TOML11_ARENA_FWD_HPP
@@ -4,6 +4,7 @@
 // to use __has_builtin
 #include "../version.hpp" // IWYU pragma: keep
 
+#include <atomic>
 #include <exception>
 #include <initializer_list>
 #include <iterator>
@@ -14,6 +15,8 @@
 #include <vector>
 #include <ostream>
 
+#include <cstdint>
+
 // This file provides mainly two classes, `preserve_comments` and `discard_comments`.
 // Those two are a container that have the same interface as `std::vector<std::string>`
 // but bahaves in the opposite way. `preserve_comments` is just the same as
@@ -21,9 +24,14 @@
 // Conversely, `discard_comments` discards all the strings and ignores everything
 // assigned in it. `discard_comments` is always empty and you will encounter an
 // error whenever you access to the element.
+//
+// It also provides `pooled_comments`, that keeps the comments like
+// `preserve_comments` but stores the text of all the comments in a document
+// in one buffer.
 namespace toml
 {
 class discard_comments; // forward decl
+class pooled_comments;  // forward decl
 
 class preserve_comments
 {
@@ -69,6 +77,7 @@ class preserve_comments
     }
 
     explicit preserve_comments(const discard_comments&) {}
+    explicit preserve_comments(const pooled_comments&);
 
     explicit preserve_comments(size_type n): comments(n) {}
     preserve_comments(size_type n, const std::string& x): comments(n, x) {}
@@ -350,6 +359,7 @@ class discard_comments
     discard_comments& operator=(std::vector<std::string>&&)      noexcept {return *this;}
 
     explicit discard_comments(const preserve_comments&)        noexcept {}
+    explicit discard_comments(const pooled_comments&)          noexcept {}
 
     explicit discard_comments(size_type) noexcept {}
     discard_comments(size_type, const std::string&) noexcept {}
@@ -447,5 +457,441 @@ inline void swap(const discard_comments&, const discard_comments&) noexcept {ret
 
 inline std::ostream& operator<<(std::ostream& os, const discard_comments&) {return os;}
 
+namespace detail
+{
+
+// The text of comment lines stored in one buffer. The i-th line is
+// `text_[ends_[i-1], ends_[i])`. Lines are only appended, never removed.
+//
+// It is reference-counted by comment_pool_ptr. The parser appends the comments
+// in a document to the same pool, so it is not thread-safe to append while
+// another thread reads the lines.
+class comment_pool
+{
+  public:
+
+    comment_pool() noexcept: refs_(1) {}
+    ~comment_pool() = default;
+    comment_pool(const comment_pool&) = delete;
+    comment_pool(comment_pool&&)      = delete;
+    comment_pool& operator=(const comment_pool&) = delete;
+    comment_pool& operator=(comment_pool&&)      = delete;
+
+    // the number of lines
+    std::size_t size() const noexcept {return this->ends_.size();}
+
+    // throws std::length_error if the text exceeds 4 GiB.
+    void append(const std::string& line);
+
+    char const* data(const std::size_t i) const noexcept
+    {
+        return this->text_.data() + this->first_of(i);
+    }
+    std::size_t length(const std::size_t i) const noexcept
+    {
+        return this->ends_[i] - this->first_of(i);
+    }
+    std::string line(const std::size_t i) const
+    {
+        return std::string(this->data(i), this->length(i));
+    }
+
+    void add_ref() noexcept {this->refs_.fetch_add(1, std::memory_order_relaxed);}
+    // returns true if it was the last reference
+    bool release() noexcept {return this->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1;}
+    bool unique() const noexcept {return this->refs_.load(std::memory_order_acquire) == 1;}
+
+  private:
+
+    std::size_t first_of(const std::size_t i) const noexcept
+    {
+        return i == 0 ? 0 : this->ends_[i-1];
+    }
+
+  private:
+
+    std::string                text_;
+    std::vector<std::uint32_t> ends_;
+    std::atomic<std::size_t>   refs_;
+};
+
+// an intrusive pointer to a comment_pool, to keep pooled_comments small.
+class comment_pool_ptr
+{
+  public:
+
+    comment_pool_ptr() noexcept: ptr_(nullptr) {}
+    // takes the ownership of a newly allocated pool
+    explicit comment_pool_ptr(comment_pool* p) noexcept: ptr_(p) {}
+    ~comment_pool_ptr() noexcept {this->reset();}
+
+    comment_pool_ptr(const comment_pool_ptr& other) noexcept: ptr_(other.ptr_)
+    {
+        if(this->ptr_) {this->ptr_->add_ref();}
+    }
+    comment_pool_ptr(comment_pool_ptr&& other) noexcept: ptr_(other.ptr_)
+    {
+        other.ptr_ = nullptr;
+    }
+    comment_pool_ptr& operator=(const comment_pool_ptr& other) noexcept
+    {
+        comment_pool_ptr tmp(other);
+        this->swap(tmp);
+        return *this;
+    }
+    comment_pool_ptr& operator=(comment_pool_ptr&& other) noexcept
+    {
+        comment_pool_ptr tmp(std::move(other));
+        this->swap(tmp);
+        return *this;
+    }
+
+    void swap(comment_pool_ptr& other) noexcept {std::swap(this->ptr_, other.ptr_);}
+
+    void reset() noexcept
+    {
+        if(this->ptr_ && this->ptr_->release())
+        {
+            delete this->ptr_;
+        }
+        this->ptr_ = nullptr;
+    }
+
+    comment_pool* get()        const noexcept {return this->ptr_;}
+    comment_pool* operator->() const noexcept {return this->ptr_;}
+    explicit operator bool()   const noexcept {return this->ptr_ != nullptr;}
+
+    bool unique() const noexcept {return this->ptr_ && this->ptr_->unique();}
+
+  private:
+
+    comment_pool* ptr_;
+};
+
+comment_pool_ptr make_comment_pool();
+
+// A read-only view of a line in a comment_pool, like std::string_view. It is
+// returned instead of a std::string to avoid an allocation per access. It
+// converts to std::string if a copy is needed. It is valid while the pool is.
+class pooled_comment_line
+{
+  public:
+    using value_type     = char;
+    using size_type      = std::size_t;
+    using iterator       = char const*;
+    using const_iterator = char const*;
+
+  public:
+
+    pooled_comment_line(char const* p, const std::size_t n) noexcept
+        : data_(p), size_(n)
+    {}
+
+    char const* data()   const noexcept {return this->data_;}
+    size_type   size()   const noexcept {return this->size_;}
+    size_type   length() const noexcept {return this->size_;}
+    bool        empty()  const noexcept {return this->size_ == 0;}
+
+    char operator[](const size_type i) const noexcept {return this->data_[i];}
+    char front() const noexcept {return this->data_[0];}
+    char back()  const noexcept {return this->data_[this->size_ - 1];}
+
+    const_iterator begin() const noexcept {return this->data_;}
+    const_iterator end()   const noexcept {return this->data_ + this->size_;}
+
+    std::string str() const {return std::string(this->data_, this->size_);}
+    operator std::string() const {return this->str();}
+
+    // compares the lines like std::string::compare
+    int compare(char const* p, const std::size_t n) const noexcept;
+
+  private:
+
+    char const* data_;
+    size_type   size_;
+};
+
+bool operator==(const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept;
+bool operator==(const pooled_comment_line& lhs, const std::string&         rhs) noexcept;
+bool operator==(const std::string&         lhs, const pooled_comment_line& rhs) noexcept;
+bool operator==(const pooled_comment_line& lhs, char const*                rhs) noexcept;
+bool operator==(char const*                lhs, const pooled_comment_line& rhs) noexcept;
+bool operator!=(const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept;
+bool operator!=(const pooled_comment_line& lhs, const std::string&         rhs) noexcept;
+bool operator!=(const std::string&         lhs, const pooled_comment_line& rhs) noexcept;
+bool operator!=(const pooled_comment_line& lhs, char const*                rhs) noexcept;
+bool operator!=(char const*                lhs, const pooled_comment_line& rhs) noexcept;
+bool operator< (const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept;
+
+std::ostream& operator<<(std::ostream& os, const pooled_comment_line& line);
+
+// Dereferencing it returns a pooled_comment_line, not a reference to a
+// std::string, so it is only an input iterator as a legacy iterator.
+// It supports the random-access operations and, since C++20, models
+// std::random_access_iterator.
+class pooled_comment_iterator
+{
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag; // since C++20
+    using value_type        = std::string;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = const pooled_comment_line;
+
+  public:
+
+    pooled_comment_iterator() noexcept: pool_(nullptr), index_(0) {}
+    pooled_comment_iterator(const comment_pool* p, const std::size_t i) noexcept
+        : pool_(p), index_(i)
+    {}
+
+    reference operator*() const noexcept
+    {
+        return pooled_comment_line(this->pool_->data(this->index_), this->pool_->length(this->index_));
+    }
+    reference operator[](const difference_type n) const noexcept {return *(*this + n);}
+
+    pooled_comment_iterator& operator++() noexcept {++index_; return *this;}
+    pooled_comment_iterator& operator--() noexcept {--index_; return *this;}
+    pooled_comment_iterator  operator++(int) noexcept {auto tmp(*this); ++index_; return tmp;}
+    pooled_comment_iterator  operator--(int) noexcept {auto tmp(*this); --index_; return tmp;}
+
+    pooled_comment_iterator& operator+=(const difference_type n) noexcept
+    {
+        this->index_ = static_cast<std::size_t>(static_cast<difference_type>(this->index_) + n);
+        return *this;
+    }
+    pooled_comment_iterator& operator-=(const difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+    pooled_comment_iterator operator+(const difference_type n) const noexcept
+    {
+        auto tmp(*this); tmp += n; return tmp;
+    }
+    pooled_comment_iterator operator-(const difference_type n) const noexcept
+    {
+        auto tmp(*this); tmp -= n; return tmp;
+    }
+    friend pooled_comment_iterator
+    operator+(const difference_type n, const pooled_comment_iterator& it) noexcept
+    {
+        return it + n;
+    }
+    friend difference_type
+    operator-(const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs.index_) -
+               static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!=(const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ != rhs.index_;
+    }
+    friend bool operator< (const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ <  rhs.index_;
+    }
+    friend bool operator<=(const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ <= rhs.index_;
+    }
+    friend bool operator> (const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ >  rhs.index_;
+    }
+    friend bool operator>=(const pooled_comment_iterator& lhs, const pooled_comment_iterator& rhs) noexcept
+    {
+        return lhs.index_ >= rhs.index_;
+    }
+
+  private:
+
+    const comment_pool* pool_;
+    std::size_t         index_; // in the pool
+};
+
+} // detail
+
+// It keeps comments like preserve_comments, but it only has a pointer to a
+// comment_pool and the range of its lines in it. The comments in a document
+// parsed by toml::parse share one pool, so a value takes 16 bytes and a
+// comment line takes its length plus 4 bytes, instead of a std::string.
+//
+// It works as a read-only view of the lines. Accessing a line returns a
+// detail::pooled_comment_line that refers to the pool, so `com[0] = "# foo"`
+// does not compile. `push_back`, `emplace_back`, `pop_back`, `clear`, and
+// `assign` are supported. Modifying comments that share their pool with others
+// copies the lines to a new pool, so it does not affect the other values.
+//
+// A pool is never compacted. The lines removed by `pop_back` or left behind
+// by the copy stay in the pool until all the comments referring to it are
+// destroyed.
+class pooled_comments
+{
+  public:
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using value_type             = std::string;
+    using reference              = const detail::pooled_comment_line;
+    using const_reference        = const detail::pooled_comment_line;
+    using iterator               = detail::pooled_comment_iterator;
+    using const_iterator         = detail::pooled_comment_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  public:
+
+    pooled_comments() noexcept: pool_{}, first_(0), size_(0) {}
+    ~pooled_comments() = default;
+    pooled_comments(pooled_comments const&) = default;
+    pooled_comments(pooled_comments&& other) noexcept
+        : pool_(std::move(other.pool_)), first_(other.first_), size_(other.size_)
+    {
+        other.first_ = 0;
+        other.size_  = 0;
+    }
+    pooled_comments& operator=(pooled_comments const&) = default;
+    pooled_comments& operator=(pooled_comments&& other) noexcept
+    {
+        pooled_comments tmp(std::move(other));
+        this->swap(tmp);
+        return *this;
+    }
+
+    explicit pooled_comments(const std::vector<std::string>& c);
+    pooled_comments& operator=(const std::vector<std::string>& c);
+
+    explicit pooled_comments(const preserve_comments& c);
+    explicit pooled_comments(const discard_comments&) noexcept
+        : pool_{}, first_(0), size_(0)
+    {}
+
+    pooled_comments(std::initializer_list<std::string> x);
+    template<typename InputIterator>
+    pooled_comments(InputIterator first, InputIterator last)
+        : pool_{}, first_(0), size_(0)
+    {
+        for(; first != last; ++first)
+        {
+            this->push_back(*first);
+        }
+    }
+
+    template<typename InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        pooled_comments tmp(first, last);
+        this->swap(tmp);
+    }
+    void assign(std::initializer_list<std::string> ini)
+    {
+        pooled_comments tmp(ini);
+        this->swap(tmp);
+    }
+
+    void swap(pooled_comments& other) noexcept
+    {
+        this->pool_.swap(other.pool_);
+        std::swap(this->first_, other.first_);
+        std::swap(this->size_,  other.size_);
+    }
+
+    void push_back(const std::string& c);
+    template<typename ... Ts>
+    void emplace_back(Ts&& ... args)
+    {
+        this->push_back(std::string(std::forward<Ts>(args)...));
+    }
+    void pop_back() noexcept
+    {
+        this->size_ -= 1;
+        if(this->size_ == 0) {this->clear();}
+    }
+    void clear() noexcept
+    {
+        this->pool_.reset();
+        this->first_ = 0;
+        this->size_  = 0;
+    }
+
+    // appends a line to the given pool. If the lines are in another pool or
+    // are not at the end of it, they are moved to the end of it first. The
+    // parser uses it to store the comments in a document in one pool.
+    void append(const detail::comment_pool_ptr& pool, const std::string& c);
+
+    size_type size()     const noexcept {return this->size_;}
+    size_type max_size() const noexcept {return 0xFFFFFFFF;}
+    bool      empty()    const noexcept {return this->size_ == 0;}
+
+    const_reference operator[](const size_type n) const noexcept
+    {
+        return *(this->begin() + static_cast<difference_type>(n));
+    }
+    const_reference at(const size_type n) const
+    {
+        if(this->size_ <= n)
+        {
+            throw std::out_of_range("toml::pooled_comments::at: index out of range");
+        }
+        return (*this)[n];
+    }
+    const_reference front() const noexcept {return (*this)[0];}
+    const_reference back()  const noexcept {return (*this)[this->size_ - 1];}
+
+    const_iterator begin()  const noexcept {return const_iterator(this->pool_.get(), this->first_);}
+    const_iterator end()    const noexcept {return const_iterator(this->pool_.get(), std::size_t(this->first_) + this->size_);}
+    const_iterator cbegin() const noexcept {return this->begin();}
+    const_iterator cend()   const noexcept {return this->end();}
+
+    const_reverse_iterator rbegin()  const noexcept {return const_reverse_iterator(this->end());}
+    const_reverse_iterator rend()    const noexcept {return const_reverse_iterator(this->begin());}
+    const_reverse_iterator crbegin() const noexcept {return this->rbegin();}
+    const_reverse_iterator crend()   const noexcept {return this->rend();}
+
+    // the pool that stores the lines. nullptr if it is empty.
+    detail::comment_pool const* pool() const noexcept {return this->pool_.get();}
+
+    friend bool operator==(const pooled_comments&, const pooled_comments&) noexcept;
+    friend bool operator< (const pooled_comments&, const pooled_comments&) noexcept;
+
+  private:
+
+    // the lines are at the end of the pool, so a new line can be appended
+    bool at_end() const noexcept
+    {
+        return this->pool_ && std::size_t(this->first_) + this->size_ == this->pool_->size();
+    }
+    // copies the lines to the end of `pool` and refers to them
+    void move_to(const detail::comment_pool_ptr& pool);
+
+    // compares the i-th lines of the two
+    static int compare_line(const pooled_comments& lhs, const pooled_comments& rhs,
+                            const std::size_t i) noexcept;
+
+  private:
+
+    detail::comment_pool_ptr pool_;
+    std::uint32_t            first_;
+    std::uint32_t            size_;
+};
+
+bool operator==(const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+bool operator!=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+bool operator< (const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+bool operator<=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+bool operator> (const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+bool operator>=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept;
+
+void swap(pooled_comments& lhs, pooled_comments& rhs) noexcept;
+
+std::ostream& operator<<(std::ostream& os, const pooled_comments& com);
+
 } // toml11
 #endif // TOML11_COMMENTS_FWD_HPP
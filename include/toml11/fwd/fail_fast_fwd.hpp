@@ -0,0 +1,101 @@
+#ifndef TOML11_FAIL_FAST_FWD_HPP
+#define TOML11_FAIL_FAST_FWD_HPP
+
+#include "error_info_fwd.hpp"
+#include "source_buffer_fwd.hpp"
+#include "../spec.hpp"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace toml
+{
+
+// ----------------------------------------------------------------------------
+// the kind of the first error found in fail-fast mode
+
+enum class parse_error_code : std::uint8_t
+{
+    file_io      = 0, // failed to open or read the file
+    syntax       = 1, // a key, a value, or a comment is invalid
+    table_header = 2, // a table header is invalid
+    redefinition = 3  // a key or a table is defined twice or conflicts
+};
+
+std::ostream& operator<<(std::ostream& os, parse_error_code c);
+std::string to_string(parse_error_code c);
+
+// ----------------------------------------------------------------------------
+// `toml::try_parse(fname, spec, toml::fail_fast)` stops at the first error
+// without recovering from it. See parse_failure.
+
+struct fail_fast_t {};
+constexpr fail_fast_t fail_fast{};
+
+// ----------------------------------------------------------------------------
+// The first error found in fail-fast mode.
+//
+// It only records the kind and the byte offset of the error. The messages are
+// built by `errors()`, that parses the source again in the normal mode. The
+// source is kept until this is destroyed.
+
+class parse_failure
+{
+  public:
+
+    using reparse_type = std::vector<error_info>(*)(
+            const detail::source_ptr&, const std::string&, const spec&);
+
+  public:
+
+    parse_failure(parse_error_code code, std::size_t offset, std::string fname,
+                  detail::source_ptr src, spec s, reparse_type reparse)
+        : code_(code), offset_(offset), file_name_(std::move(fname)),
+          source_(std::move(src)), spec_(s), reparse_(reparse)
+    {}
+
+    // failed to read a file
+    parse_failure(std::string fname, std::string io_error)
+        : code_(parse_error_code::file_io), offset_(0),
+          file_name_(std::move(fname)), source_(nullptr),
+          spec_(spec::default_version()), reparse_(nullptr),
+          io_error_(std::move(io_error))
+    {}
+
+    parse_error_code   code()      const noexcept {return code_;}
+    std::string const& file_name() const noexcept {return file_name_;}
+
+    // from the beginning of the file. It points the same location as the
+    // first error in `errors()`.
+    std::size_t offset() const noexcept {return offset_;}
+
+    // the same errors as `try_parse` without fail_fast
+    std::vector<error_info> errors() const;
+
+    // the same message as the exception thrown by `parse`
+    std::string message() const;
+
+  private:
+
+    parse_error_code   code_;
+    std::size_t        offset_;
+    std::string        file_name_;
+    detail::source_ptr source_;
+    spec               spec_;
+    reparse_type       reparse_;
+    std::string        io_error_;
+};
+
+namespace detail
+{
+// the byte offset in `src` of the `offset`-th byte in `sec`, that is `src`
+// itself or a section split from it
+std::size_t error_offset(const source_buffer& src, const source_ptr& sec,
+                         const std::size_t offset) noexcept;
+} // detail
+} // toml
+#endif // TOML11_FAIL_FAST_FWD_HPP
@@ -214,11 +214,55 @@ struct table_format_info
 bool operator==(const table_format_info&, const table_format_info&) noexcept;
 bool operator!=(const table_format_info&, const table_format_info&) noexcept;
 
+// ----------------------------------------------------------------------------
+// format policies
+//
+// `format_type` of a type_config. With discard_format, the values other than
+// arrays and tables do not store their format info, and the serializer uses
+// the default. Arrays and tables always store it because the parser needs to
+// know how they are defined (e.g. inline tables cannot be extended).
+
+struct preserve_format {};
+struct discard_format  {};
+
 // ----------------------------------------------------------------------------
 // wrapper
 
 namespace detail
 {
+template<typename T, typename F>
+struct value_with_format;
+
+// stores only the value. The format is always the default one.
+template<typename T, typename F>
+struct value_without_format
+{
+    using value_type  = T;
+    using format_type = F;
+
+    value_without_format()  = default;
+    ~value_without_format() = default;
+    value_without_format(const value_without_format&) = default;
+    value_without_format(value_without_format&&)      = default;
+    value_without_format& operator=(const value_without_format&) = default;
+    value_without_format& operator=(value_without_format&&)      = default;
+
+    value_without_format(value_type v, const format_type&)
+        : value{std::move(v)}
+    {}
+
+    template<typename U>
+    value_without_format(value_without_format<U, format_type> other)
+        : value{std::move(other.value)}
+    {}
+    template<typename U>
+    value_without_format(value_with_format<U, format_type> other)
+        : value{std::move(other.value)}
+    {}
+
+    value_type value;
+};
+
 template<typename T, typename F>
 struct value_with_format
 {
@@ -240,10 +284,50 @@ struct value_with_format
     value_with_format(value_with_format<U, format_type> other)
         : value{std::move(other.value)}, format{std::move(other.format)}
     {}
+    template<typename U>
+    value_with_format(value_without_format<U, format_type> other)
+        : value{std::move(other.value)}, format{}
+    {}
 
     value_type  value;
     format_type format;
 };
+
+template<typename T, typename F>
+F& format_of(value_with_format<T, F>& v) noexcept
+{
+    return v.format;
+}
+template<typename T, typename F>
+F const& format_of(const value_with_format<T, F>& v) noexcept
+{
+    return v.format;
+}
+
+// The format is not stored. The default is returned by value so that it cannot
+// be modified in place. See also format_reference in value.hpp.
+template<typename T, typename F>
+F format_of(value_without_format<T, F>&) noexcept
+{
+    return F{};
+}
+template<typename T, typename F>
+F const& format_of(const value_without_format<T, F>&) noexcept
+{
+    static const F default_format{};
+    return default_format;
+}
+
+template<typename T, typename F, typename Policy>
+struct format_storage
+{
+    using type = value_with_format<T, F>;
+};
+template<typename T, typename F>
+struct format_storage<T, F, discard_format>
+{
+    using type = value_without_format<T, F>;
+};
 } // detail
 
 } // namespace toml
@@ -0,0 +1,155 @@
+#ifndef TOML11_KEY_POOL_FWD_HPP
+#define TOML11_KEY_POOL_FWD_HPP
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include <cstddef>
+
+namespace toml
+{
+namespace detail
+{
+struct interned_string
+{
+    std::string str;
+    std::size_t hash;
+};
+} // detail
+
+//
+// A key that shares its bytes with the other keys made by the same key_pool.
+//
+// Its hash is computed once when it is made. Two keys from the same pool are
+// equal if and only if they point to the same bytes. Keys from different
+// pools (or made without a pool) are compared by their hashes and contents.
+//
+// It owns its bytes with the others, so it can outlive the pool.
+//
+class interned_key
+{
+  public:
+
+    using value_type     = char;
+    using traits_type    = std::string::traits_type;
+    using size_type      = std::string::size_type;
+    using const_iterator = std::string::const_iterator;
+    using iterator       = const_iterator;
+
+  public:
+
+    interned_key() = default;
+    ~interned_key() = default;
+    interned_key(const interned_key&) = default;
+    interned_key(interned_key&&)      = default;
+    interned_key& operator=(const interned_key&) = default;
+    interned_key& operator=(interned_key&&)      = default;
+
+    // without a pool. It does not share the bytes.
+    interned_key(std::string s);
+    interned_key(const char* s);
+
+    std::string const& str() const noexcept;
+    operator std::string const&() const noexcept {return this->str();}
+
+    std::size_t hash() const noexcept;
+
+    // true if both share the same bytes
+    bool same_bytes(const interned_key& other) const noexcept
+    {
+        return this->node_ == other.node_;
+    }
+
+    bool        empty() const noexcept {return this->str().empty();}
+    size_type   size()  const noexcept {return this->str().size();}
+    char const* data()  const noexcept {return this->str().data();}
+    char const* c_str() const noexcept {return this->str().c_str();}
+
+    const_iterator begin()  const noexcept {return this->str().begin();}
+    const_iterator end()    const noexcept {return this->str().end();}
+    const_iterator cbegin() const noexcept {return this->str().cbegin();}
+    const_iterator cend()   const noexcept {return this->str().cend();}
+
+    char operator[](const size_type i) const noexcept {return this->str()[i];}
+
+  private:
+
+    friend class key_pool;
+
+    explicit interned_key(std::shared_ptr<const detail::interned_string> n) noexcept
+        : node_(std::move(n))
+    {}
+
+  private:
+
+    std::shared_ptr<const detail::interned_string> node_;
+};
+
+bool operator==(const interned_key& lhs, const interned_key& rhs) noexcept;
+bool operator!=(const interned_key& lhs, const interned_key& rhs) noexcept;
+bool operator< (const interned_key& lhs, const interned_key& rhs) noexcept;
+bool operator<=(const interned_key& lhs, const interned_key& rhs) noexcept;
+bool operator> (const interned_key& lhs, const interned_key& rhs) noexcept;
+bool operator>=(const interned_key& lhs, const interned_key& rhs) noexcept;
+
+bool operator==(const interned_key& lhs, const std::string& rhs) noexcept;
+bool operator==(const std::string& lhs, const interned_key& rhs) noexcept;
+bool operator!=(const interned_key& lhs, const std::string& rhs) noexcept;
+bool operator!=(const std::string& lhs, const interned_key& rhs) noexcept;
+bool operator==(const interned_key& lhs, const char* rhs) noexcept;
+bool operator==(const char* lhs, const interned_key& rhs) noexcept;
+bool operator!=(const interned_key& lhs, const char* rhs) noexcept;
+bool operator!=(const char* lhs, const interned_key& rhs) noexcept;
+
+std::string operator+(const std::string& lhs, const interned_key& rhs);
+std::string operator+(const interned_key& lhs, const std::string& rhs);
+std::string operator+(const char* lhs, const interned_key& rhs);
+std::string operator+(const interned_key& lhs, const char* rhs);
+
+std::ostream& operator<<(std::ostream& os, const interned_key& k);
+
+//
+// It makes interned_keys that share their bytes if they have the same
+// contents. The parser makes one for each document when the key_type of the
+// type_config is interned_key. It is not thread-safe.
+//
+class key_pool
+{
+  public:
+
+    key_pool() = default;
+    ~key_pool() = default;
+    key_pool(const key_pool&) = default;
+    key_pool(key_pool&&)      = default;
+    key_pool& operator=(const key_pool&) = default;
+    key_pool& operator=(key_pool&&)      = default;
+
+    interned_key intern(const std::string& s);
+
+    // the number of distinct keys
+    std::size_t size() const noexcept {return this->keys_.size();}
+
+  private:
+
+    std::unordered_multimap<std::size_t,
+        std::shared_ptr<const detail::interned_string>> keys_;
+};
+
+} // toml
+
+namespace std
+{
+template<>
+struct hash<::toml::interned_key>
+{
+    std::size_t operator()(const ::toml::interned_key& k) const noexcept
+    {
+        return k.hash();
+    }
+};
+} // std
+
+#endif // TOML11_KEY_POOL_FWD_HPP
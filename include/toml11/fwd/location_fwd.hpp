@@ -2,8 +2,11 @@
 #define TOML11_LOCATION_FWD_HPP
 
 #include "../result.hpp"
+#include "source_buffer_fwd.hpp"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,6 +17,61 @@ namespace detail
 
 class region; // fwd decl
 
+//
+// Offsets of the newlines in a source.
+// It is shared by the locations and regions that point the same source and
+// built when a line or column number is requested at the first time. So a
+// parser does not need to count lines unless it reports an error.
+//
+class newline_index
+{
+  public:
+
+    newline_index(): built_(false) {}
+    ~newline_index() = default;
+    newline_index(const newline_index&) = delete;
+    newline_index(newline_index&&)      = delete;
+    newline_index& operator=(const newline_index&) = delete;
+    newline_index& operator=(newline_index&&)      = delete;
+
+    // 1-origin line and column number of the character at `offset` in `src`.
+    // `src` must be the source that this index is made for.
+    std::size_t line_number  (const source_buffer& src, const std::size_t offset);
+    std::size_t column_number(const source_buffer& src, const std::size_t offset);
+
+  private:
+
+    // the number of newlines in [0, offset)
+    std::size_t count_newlines(const source_buffer& src, const std::size_t offset);
+
+    void build(const source_buffer& src);
+
+  private:
+
+    // std::call_once requires libpthread on some platforms.
+    std::atomic<bool>        built_;
+    std::mutex               mtx_;
+    std::vector<std::size_t> newlines_;
+};
+
+//
+// A source, its name, and the index of its lines. It is made once for each
+// source that is parsed and shared by the locations and regions in it, so
+// copying a location or a region only copies a pointer to this and an offset.
+//
+struct source_record
+{
+    source_record(source_ptr src, std::string src_name)
+        : source(std::move(src)), name(std::move(src_name))
+    {}
+
+    source_ptr    source;
+    std::string   name;
+    newline_index lines; // built lazily, so it is mutable through the pointer
+};
+
+using record_ptr = std::shared_ptr<source_record>;
+
 //
 // To represent where we are reading in the parse functions.
 // Since it "points" somewhere in the input stream, the length is always 1.
@@ -22,16 +80,17 @@ class location
 {
   public:
 
-    using char_type       = unsigned char; // must be unsigned
-    using container_type  = std::vector<char_type>;
+    using char_type       = source_buffer::char_type; // must be unsigned
+    using container_type  = source_buffer::container_type;
     using difference_type = typename container_type::difference_type; // to suppress sign-conversion warning
-    using source_ptr      = std::shared_ptr<const container_type>;
+    using source_ptr      = ::toml::detail::source_ptr;
+    using record_ptr      = ::toml::detail::record_ptr;
 
   public:
 
     location(source_ptr src, std::string src_name)
-        : source_(std::move(src)), source_name_(std::move(src_name)),
-          location_(0), line_number_(1)
+        : record_(std::make_shared<source_record>(std::move(src), std::move(src_name))),
+          location_(0)
     {}
 
     location(const location&) = default;
@@ -43,7 +102,10 @@ class location
     void advance(std::size_t n = 1) noexcept;
     void retrace(std::size_t n = 1) noexcept;
 
-    bool is_ok() const noexcept { return static_cast<bool>(this->source_); }
+    bool is_ok() const noexcept
+    {
+        return static_cast<bool>(this->record_) && static_cast<bool>(this->record_->source);
+    }
 
     bool eof() const noexcept;
     char_type current() const;
@@ -56,20 +118,14 @@ class location
     }
     void set_location(const std::size_t loc) noexcept;
 
-    std::size_t line_number() const noexcept
-    {
-        return this->line_number_;
-    }
+    // those are calculated from the offset when requested
+    std::size_t line_number() const;
     std::string get_line() const;
-    std::size_t column_number() const noexcept;
-
-    source_ptr const&  source()      const noexcept {return this->source_;}
-    std::string const& source_name() const noexcept {return this->source_name_;}
-
-  private:
+    std::size_t column_number() const;
 
-    void advance_line_number(const std::size_t n);
-    void retrace_line_number(const std::size_t n);
+    source_ptr  const& source()      const noexcept {return this->record_->source;}
+    std::string const& source_name() const noexcept {return this->record_->name;}
+    record_ptr  const& record()      const noexcept {return this->record_;}
 
   private:
 
@@ -77,10 +133,8 @@ class location
 
   private:
 
-    source_ptr  source_;
-    std::string source_name_;
+    record_ptr  record_;
     std::size_t location_; // std::vector<>::difference_type is signed
-    std::size_t line_number_;
 };
 
 bool operator==(const location& lhs, const location& rhs) noexcept;
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <cassert>
+#include <cstdint>
 
 namespace toml
 {
@@ -17,6 +18,11 @@ namespace detail
 // To represent where is a toml::value defined, or where does an error occur.
 // Stored in toml::value. source_location will be constructed based on this.
 //
+// Since every value has one, it only has a pointer to the source_record shared
+// in the document and 32-bit offsets. The line and column numbers are
+// calculated from them when requested. So a source must not be longer than
+// max_source_size() bytes. The parse functions check it.
+//
 class region
 {
   public:
@@ -25,17 +31,16 @@ class region
     using container_type  = location::container_type;
     using difference_type = location::difference_type;
     using source_ptr      = location::source_ptr;
+    using record_ptr      = location::record_ptr;
 
-    using iterator       = typename container_type::iterator;
-    using const_iterator = typename container_type::const_iterator;
+    using iterator       = const char_type*;
+    using const_iterator = const char_type*;
 
   public:
 
     // a value that is constructed manually does not have input stream info
-    region()
-        : source_(nullptr), source_name_(""), length_(0),
-          first_(0), first_line_(0), first_column_(0), last_(0), last_line_(0),
-          last_column_(0)
+    region() noexcept
+        : record_(nullptr), first_(0), length_(0), is_char_(0)
     {}
 
     // a value defined in [first, last).
@@ -51,28 +56,26 @@ class region
     region& operator=(const region&) = default;
     region& operator=(region&&)      = default;
 
-    bool is_ok() const noexcept { return static_cast<bool>(this->source_); }
+    // the offsets and the length are stored in 31 bits
+    static constexpr std::size_t max_source_size() noexcept
+    {
+        return 0x7FFFFFFF;
+    }
+
+    bool is_ok() const noexcept
+    {
+        return static_cast<bool>(this->record_) && static_cast<bool>(this->record_->source);
+    }
 
     operator bool() const noexcept { return this->is_ok(); }
 
     std::size_t length() const noexcept {return this->length_;}
 
-    std::size_t first_line_number() const noexcept
-    {
-        return this->first_line_;
-    }
-    std::size_t first_column_number() const noexcept
-    {
-        return this->first_column_;
-    }
-    std::size_t last_line_number() const noexcept
-    {
-        return this->last_line_;
-    }
-    std::size_t last_column_number() const noexcept
-    {
-        return this->last_column_;
-    }
+    // those are calculated from the offsets when requested
+    std::size_t first_line_number() const;
+    std::size_t first_column_number() const;
+    std::size_t last_line_number() const;
+    std::size_t last_column_number() const;
 
     char_type at(std::size_t i) const;
 
@@ -84,22 +87,50 @@ class region
     std::string as_string() const;
     std::vector<std::string> as_lines() const;
 
-    source_ptr const&  source()      const noexcept {return this->source_;}
-    std::string const& source_name() const noexcept {return this->source_name_;}
+    source_ptr  const& source()      const noexcept;
+    std::string const& source_name() const noexcept;
+
+    // [first, last) in source()
+    std::size_t first() const noexcept {return this->first_;}
+    std::size_t last()  const noexcept {return std::size_t(this->first_) + this->length_;}
 
   private:
 
-    source_ptr  source_;
-    std::string source_name_;
-    std::size_t length_;
-    std::size_t first_;
-    std::size_t first_line_;
-    std::size_t first_column_;
-    std::size_t last_;
-    std::size_t last_line_;
-    std::size_t last_column_;
+    record_ptr    record_;
+    std::uint32_t first_;
+    std::uint32_t length_  : 31;
+    std::uint32_t is_char_ : 1; // constructed by region(loc). see below
 };
 
 } // namespace detail
+
+//
+// Use it as `region_type` of a type_config to drop where the values are
+// defined. The values do not keep the source after the parser returns, and
+// their `location()` returns an empty source_location.
+//
+// It is an empty class. basic_value puts it in the padding after the type tag.
+//
+class discard_region
+{
+  public:
+
+    discard_region() noexcept = default;
+    ~discard_region() noexcept = default;
+    discard_region(const discard_region&) = default;
+    discard_region(discard_region&&)      = default;
+    discard_region& operator=(const discard_region&) = default;
+    discard_region& operator=(discard_region&&)      = default;
+
+    // discards the region made by the parser
+    discard_region(const detail::region&) noexcept {}
+    discard_region& operator=(const detail::region&) noexcept {return *this;}
+
+    // an empty region
+    operator detail::region() const noexcept {return detail::region{};}
+
+    bool is_ok() const noexcept {return false;}
+};
+
 } // namespace toml
 #endif // TOML11_REGION_FWD_HPP
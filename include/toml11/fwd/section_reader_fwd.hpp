@@ -0,0 +1,162 @@
+#ifndef TOML11_SECTION_READER_FWD_HPP
+#define TOML11_SECTION_READER_FWD_HPP
+
+#include "../result.hpp"
+#include "../spec.hpp"
+#include "../version.hpp"
+#include "source_buffer_fwd.hpp"
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace toml
+{
+namespace detail
+{
+
+//
+// Scans a TOML file line by line and finds top-level table headers.
+//
+// To find headers, it tracks strings, comments, and brackets, and checks the
+// syntax of the header line. If it is confused by an invalid file, it finds
+// fewer headers, not more, because it only accepts a valid header line outside
+// of any string or bracket.
+//
+class header_scanner
+{
+  public:
+
+    using char_type = source_buffer::char_type;
+
+  public:
+
+    explicit header_scanner(spec s)
+        : spec_(std::move(s)), state_(state::normal), depth_(0), has_content_(false)
+    {}
+
+    // scans a line [first, last) that ends with a newline, or the last line
+    // of the file. returns true if the line is a top-level table header.
+    bool scan_line(const char_type* first, const char_type* last);
+
+    // true if the last line has something other than whitespace and comments
+    bool has_content() const noexcept {return this->has_content_;}
+
+  private:
+
+    enum class state : std::uint8_t
+    {
+        normal,
+        basic_string,
+        literal_string,
+        ml_basic_string,
+        ml_literal_string
+    };
+
+    spec        spec_;
+    state       state_;
+    std::size_t depth_; // nesting of [] and {}
+    bool        has_content_;
+};
+
+// the position of a top-level table header in a file
+struct table_header_position
+{
+    std::size_t section_first; // the comments and empty lines before the header
+    std::size_t header_first;  // the line of the header
+};
+
+// returns the positions of all the top-level table headers in a file.
+std::vector<table_header_position>
+find_table_headers(const source_buffer& src, const spec& s);
+
+// returns the offsets where the file can be split into sections. A section
+// ends just before the comments and the empty lines that precede a top-level
+// table header, and is at least `min_size` bytes long unless it is the last
+// one. The sections are the same as the ones section_reader returns.
+std::vector<std::size_t> find_section_boundaries(const source_buffer& src,
+        const spec& s, const std::size_t min_size);
+
+// splits a file at the boundaries. The sections refer to the bytes in `src`
+// and keep it alive. Each section knows the number of lines before it.
+std::vector<source_ptr> split_source(const source_ptr& src,
+        const std::vector<std::size_t>& boundaries);
+
+//
+// Reads a TOML file from a stream that might not be seekable (a pipe, a
+// socket, std::cin, ...) and splits it into sections.
+//
+// A section ends just before the comments and the empty lines that precede a
+// top-level table header, so each section except the first one starts with a
+// (possibly commented) table header. The bytes are read in chunks and only
+// the current section is buffered. Each section becomes a source_buffer that
+// knows the number of lines before it, so the line numbers are the same as
+// the ones in the whole file. The headers are found by header_scanner.
+//
+class section_reader
+{
+  public:
+
+    using char_type      = source_buffer::char_type;
+    using container_type = source_buffer::container_type;
+
+    // reads at most `len` bytes into `buf` and returns the number of bytes
+    // read. 0 means EOF. On failure, returns an error message.
+    using read_function = std::function<
+        result<std::size_t, std::string>(char_type* buf, const std::size_t len)>;
+
+    static constexpr std::size_t default_chunk_size   = 64 * 1024;
+    static constexpr std::size_t default_section_size = 1024 * 1024;
+
+  public:
+
+    // a section is at least `section_size` bytes long unless it is the last one
+    section_reader(read_function read, spec s,
+        const std::size_t section_size = default_section_size,
+        const std::size_t chunk_size   = default_chunk_size);
+
+    // returns the next section. After the last one, returns nullptr.
+    // If the file is empty, the first section is an empty source_buffer.
+    result<source_ptr, std::string> next();
+
+  private:
+
+    // scans complete lines (and the last line at EOF) and returns the
+    // offset of the first boundary after `min_size`, or 0 if not found.
+    std::size_t scan_lines(const std::size_t min_size);
+
+    // scans a line that starts from buffer_[first] and ends with a newline.
+    // returns true if the line is a table header.
+    bool scan_line(const std::size_t first, const std::size_t last);
+
+    source_ptr make_section(container_type bytes, const bool is_last);
+
+  private:
+
+    read_function  read_;
+    header_scanner scanner_;
+    std::size_t    section_size_;
+    std::size_t    chunk_size_;
+
+    container_type buffer_;
+    std::size_t    scanned_;      // buffer_[0, scanned_) is already scanned
+    std::size_t    content_end_;  // the end of the last non-empty line
+    std::size_t    line_offset_;  // the number of lines already returned
+    bool           eof_;
+    bool           done_;
+};
+
+section_reader::read_function make_read_function(std::istream& is);
+section_reader::read_function make_read_function(FILE* fp);
+#if defined(TOML11_HAS_POSIX_FD)
+section_reader::read_function make_read_function(const int fd);
+#endif
+
+} // detail
+} // toml
+#endif // TOML11_SECTION_READER_FWD_HPP
@@ -0,0 +1,140 @@
+#ifndef TOML11_SOURCE_BUFFER_FWD_HPP
+#define TOML11_SOURCE_BUFFER_FWD_HPP
+
+#include "../result.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace toml
+{
+namespace detail
+{
+
+//
+// The bytes of a TOML file that is being parsed.
+//
+// It owns the bytes (a std::vector or a memory-mapped file), or refers to a
+// buffer that is owned by the caller and must outlive all the values parsed
+// from it. The bytes are never modified.
+//
+// To simplify the parser, a file that does not end with a newline is treated
+// as if it had one if `append_newline` is true. The newline is appended
+// logically: `size()` includes it and `at(size()-1)` returns it, but the bytes
+// are not copied. Only the last line is copied with the newline so that the
+// scanners that read the bytes through pointers can see it at the end of the
+// last line.
+//
+class source_buffer
+{
+  public:
+
+    using char_type      = unsigned char; // must be unsigned
+    using container_type = std::vector<char_type>;
+
+  public:
+
+    // owns the bytes
+    source_buffer(container_type cont, const bool append_newline);
+
+    // refers to [first, first+len) owned by someone else. `keep` keeps it
+    // alive (e.g. a memory mapping), or is nullptr if the caller guarantees
+    // the lifetime.
+    source_buffer(const char_type* first, const std::size_t len,
+                  const bool append_newline, std::shared_ptr<const void> keep = nullptr);
+
+    source_buffer(const source_buffer&) = delete;
+    source_buffer(source_buffer&&)      = delete;
+    source_buffer& operator=(const source_buffer&) = delete;
+    source_buffer& operator=(source_buffer&&)      = delete;
+    ~source_buffer() = default;
+
+    // the number of bytes including the logical newline
+    std::size_t size() const noexcept
+    {
+        return this->size_ + (this->tail_.empty() ? 0 : 1);
+    }
+    bool empty() const noexcept {return this->size() == 0;}
+
+    // true if the newline at the end is not in the bytes
+    bool appends_newline() const noexcept {return ! this->tail_.empty();}
+
+    // the bytes, without the logical newline
+    const char_type* data() const noexcept {return this->data_;}
+
+    char_type at(const std::size_t i) const;
+    char_type operator[](const std::size_t i) const noexcept
+    {
+        return *this->pointer_to(i);
+    }
+
+    // [pointer_to(i), end_from(i)) is a contiguous range that starts from the
+    // i-th byte. It reaches the logical newline if the i-th byte is in the
+    // last line. Otherwise, it ends at the end of the bytes.
+    const char_type* pointer_to(const std::size_t i) const noexcept
+    {
+        return (i < this->tail_first_) ? this->data_ + i :
+            this->tail_.data() + (i - this->tail_first_);
+    }
+    const char_type* end_from(const std::size_t i) const noexcept
+    {
+        return (i < this->tail_first_) ? this->data_ + this->size_ :
+            this->tail_.data() + this->tail_.size();
+    }
+
+    // [first, last)
+    std::string substr(const std::size_t first, const std::size_t last) const;
+
+    // the number of lines before this buffer. If a file is split into several
+    // buffers, the line numbers in the later buffers are shifted by this.
+    std::size_t line_offset() const noexcept {return this->line_offset_;}
+    void set_line_offset(const std::size_t n) noexcept {this->line_offset_ = n;}
+
+    // the offset of the first character of the line that contains i-th byte
+    std::size_t line_first(const std::size_t i) const noexcept;
+    // the offset of the newline at the end of the line that contains i-th
+    // byte, or size() if there is no newline.
+    std::size_t line_last(const std::size_t i) const noexcept;
+
+  private:
+
+    void append_newline_if_needed(const bool append_newline);
+
+  private:
+
+    container_type              storage_; // empty if it does not own the bytes
+    std::shared_ptr<const void> keep_;
+    const char_type*            data_;
+    std::size_t                 size_;    // without the logical newline
+
+    // if the bytes do not end with a newline, a copy of the last line with a
+    // newline. the first byte corresponds to data_[tail_first_].
+    container_type              tail_;
+    std::size_t                 tail_first_;
+
+    std::size_t                 line_offset_;
+};
+
+using source_ptr = std::shared_ptr<const source_buffer>;
+
+source_ptr make_source(source_buffer::container_type cont,
+                       const bool append_newline = false);
+source_ptr make_source(const source_buffer::char_type* first, const std::size_t len,
+                       const bool append_newline = false);
+
+// maps a file read-only. If the platform does not support it, reads the file.
+// On failure, returns an error message.
+result<source_ptr, std::string>
+map_source_file(const std::string& fname, const bool append_newline = false);
+
+// reads a whole file into a buffer of the same size by a single read. It is
+// cheaper than mapping for small files. On failure, returns an error message.
+result<source_ptr, std::string>
+read_source_file(const std::string& fname, const bool append_newline = false);
+
+} // detail
+} // toml
+#endif // TOML11_SOURCE_BUFFER_FWD_HPP
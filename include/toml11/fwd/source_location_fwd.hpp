@@ -11,6 +11,10 @@ namespace toml
 {
 
 // A struct to contain location in a toml file.
+//
+// It keeps the region and the source, and the lines are copied from the source
+// only when they are requested (e.g. by format_error). A source that does not
+// own its bytes must outlive the source_locations made from it.
 struct source_location
 {
   public:
@@ -30,14 +34,17 @@ struct source_location
     std::size_t last_line_number()    const noexcept {return this->last_line_;}
     std::size_t last_column_number()  const noexcept {return this->last_column_;}
 
-    std::string const& file_name()  const noexcept {return this->file_name_;}
+    std::string const& file_name() const noexcept;
 
-    std::size_t num_lines() const noexcept {return this->line_str_.size();}
+    detail::region const& region() const noexcept {return this->region_;}
 
-    std::string const& first_line() const;
-    std::string const& last_line() const;
+    // those are copied from the source when requested
+    std::size_t num_lines() const {return this->lines().size();}
 
-    std::vector<std::string> const& lines() const noexcept {return line_str_;}
+    std::string first_line() const;
+    std::string last_line() const;
+
+    std::vector<std::string> lines() const;
 
   private:
 
@@ -47,8 +54,7 @@ struct source_location
     std::size_t last_line_;
     std::size_t last_column_;
     std::size_t length_;
-    std::string file_name_;
-    std::vector<std::string> line_str_;
+    detail::region region_;
 };
 
 namespace detail
@@ -13,15 +13,55 @@ namespace syntax
 
 using char_type = location::char_type;
 
+// ===========================================================================
+// syntax_cache
+//
+// Constructing a scanner tree allocates every node via `scanner_storage`.
+// To avoid rebuilding the same tree on each call, each factory keeps the
+// scanner it built last, together with the spec it was built for, and returns
+// a reference to it. The cache is `thread_local`, so scanners can be used
+// concurrently without locking. If a different spec is passed, the scanner
+// is rebuilt and the previous one is discarded.
+
+template<typename F>
+struct syntax_cache
+{
+    using value_type = cxx::return_type_of_t<F, const spec&>;
+    static_assert(std::is_base_of<scanner_base, value_type>::value, "");
+
+    explicit syntax_cache(F f)
+        : func_(std::move(f)), cache_(cxx::make_nullopt())
+    {}
+
+    value_type const& at(const spec& s)
+    {
+        if( ! this->cache_.has_value() || this->cache_.value().first != s)
+        {
+            this->cache_ = std::make_pair(s, func_(s));
+        }
+        return this->cache_.value().second;
+    }
+
+  private:
+    F func_;
+    cxx::optional<std::pair<spec, value_type>> cache_;
+};
+
+template<typename F>
+syntax_cache<cxx::remove_cvref_t<F>> make_cache(F&& f)
+{
+    return syntax_cache<cxx::remove_cvref_t<F>>(std::forward<F>(f));
+}
+
 // ===========================================================================
 // UTF-8
 
 // avoid redundant representation and out-of-unicode sequence
 
-character_in_range utf8_1byte (const spec&);
-sequence           utf8_2bytes(const spec&);
-sequence           utf8_3bytes(const spec&);
-sequence           utf8_4bytes(const spec&);
+character_in_range const& utf8_1byte (const spec&);
+sequence           const& utf8_2bytes(const spec&);
+sequence           const& utf8_3bytes(const spec&);
+sequence           const& utf8_4bytes(const spec&);
 
 class non_ascii final : public scanner_base
 {
@@ -62,27 +102,27 @@ class non_ascii final : public scanner_base
 // ===========================================================================
 // Whitespace
 
-character_either wschar(const spec&);
+character_either const& wschar(const spec&);
 
-repeat_at_least ws(const spec& s);
+repeat_at_least const& ws(const spec& s);
 
 // ===========================================================================
 // Newline
 
-either newline(const spec&);
+either const& newline(const spec&);
 
 // ===========================================================================
 // Comments
 
-either allowed_comment_char(const spec& s);
+either const& allowed_comment_char(const spec& s);
 
 // XXX Note that it does not take newline
-sequence comment(const spec& s);
+sequence const& comment(const spec& s);
 
 // ===========================================================================
 // Boolean
 
-either boolean(const spec&);
+either const& boolean(const spec&);
 
 // ===========================================================================
 // Integer
@@ -195,58 +235,58 @@ class hexdig final : public scanner_base
     either scanner_;
 };
 
-sequence num_suffix(const spec& s);
+sequence const& num_suffix(const spec& s);
 
-sequence dec_int(const spec& s);
-sequence hex_int(const spec& s);
-sequence oct_int(const spec&);
-sequence bin_int(const spec&);
-either   integer(const spec& s);
+sequence const& dec_int(const spec& s);
+sequence const& hex_int(const spec& s);
+sequence const& oct_int(const spec&);
+sequence const& bin_int(const spec&);
+either   const& integer(const spec& s);
 
 // ===========================================================================
 // Floating
 
-sequence zero_prefixable_int(const spec& s);
-sequence fractional_part(const spec& s);
-sequence exponent_part(const spec& s);
-sequence hex_floating(const spec& s);
-either   floating(const spec& s);
+sequence const& zero_prefixable_int(const spec& s);
+sequence const& fractional_part(const spec& s);
+sequence const& exponent_part(const spec& s);
+sequence const& hex_floating(const spec& s);
+either   const& floating(const spec& s);
 
 // ===========================================================================
 // Datetime
 
-sequence local_date(const spec& s);
-sequence local_time(const spec& s);
-either time_offset(const spec& s);
-sequence full_time(const spec& s);
-character_either time_delim(const spec&);
-sequence local_datetime(const spec& s);
-sequence offset_datetime(const spec& s);
+sequence const& local_date(const spec& s);
+sequence const& local_time(const spec& s);
+either const& time_offset(const spec& s);
+sequence const& full_time(const spec& s);
+character_either const& time_delim(const spec&);
+sequence const& local_datetime(const spec& s);
+sequence const& offset_datetime(const spec& s);
 
 // ===========================================================================
 // String
 
-sequence escaped(const spec& s);
+sequence const& escaped(const spec& s);
 
-either basic_char(const spec& s);
+either const& basic_char(const spec& s);
 
-sequence basic_string(const spec& s);
+sequence const& basic_string(const spec& s);
 
 // ---------------------------------------------------------------------------
 // multiline string
 
-sequence escaped_newline(const spec& s);
-sequence ml_basic_string(const spec& s);
+sequence const& escaped_newline(const spec& s);
+sequence const& ml_basic_string(const spec& s);
 
 // ---------------------------------------------------------------------------
 // literal string
 
-either literal_char(const spec& s);
-sequence literal_string(const spec& s);
+either const& literal_char(const spec& s);
+sequence const& literal_string(const spec& s);
 
-sequence ml_literal_string(const spec& s);
+sequence const& ml_literal_string(const spec& s);
 
-either string(const spec& s);
+either const& string(const spec& s);
 
 // ===========================================================================
 // Keys
@@ -283,22 +323,18 @@ class non_ascii_key_char final : public scanner_base
     {
         return "non-ASCII bare key";
     }
-
-  private:
-
-    std::uint32_t read_utf8(location& loc) const;
 };
 
 
-repeat_at_least unquoted_key(const spec& s);
+repeat_at_least const& unquoted_key(const spec& s);
 
-either quoted_key(const spec& s);
+either const& quoted_key(const spec& s);
 
-either simple_key(const spec& s);
+either const& simple_key(const spec& s);
 
-sequence dot_sep(const spec& s);
+sequence const& dot_sep(const spec& s);
 
-sequence dotted_key(const spec& s);
+sequence const& dotted_key(const spec& s);
 
 
 class key final : public scanner_base
@@ -337,19 +373,19 @@ class key final : public scanner_base
     either scanner_;
 };
 
-sequence keyval_sep(const spec& s);
+sequence const& keyval_sep(const spec& s);
 
 // ===========================================================================
 // Table key
 
-sequence std_table(const spec& s);
+sequence const& std_table(const spec& s);
 
-sequence array_table(const spec& s);
+sequence const& array_table(const spec& s);
 
 // ===========================================================================
 // extension: null
 
-literal null_value(const spec&);
+literal const& null_value(const spec&);
 
 } // namespace syntax
 } // namespace detail
@@ -0,0 +1,103 @@
+#ifndef TOML11_ARENA_IMPL_HPP
+#define TOML11_ARENA_IMPL_HPP
+
+#include "../fwd/arena_fwd.hpp"
+#include "../version.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace toml
+{
+
+TOML11_INLINE value_arena::value_arena(const std::size_t block_size)
+    : blocks_{}, free_lists_{}, current_(nullptr), rest_(0),
+      block_size_((std::max)(block_size, std::size_t(256))), capacity_(0)
+{}
+
+TOML11_INLINE std::size_t value_arena::size_class(const std::size_t bytes) noexcept
+{
+    std::size_t cls  = 0;
+    std::size_t size = alignment();
+    while(size < bytes && size < max_chunk_size())
+    {
+        size <<= 1;
+        cls  += 1;
+    }
+    return cls;
+}
+
+TOML11_INLINE void* value_arena::allocate(const std::size_t bytes)
+{
+    if(bytes > max_chunk_size())
+    {
+        throw std::bad_alloc();
+    }
+    const auto cls = size_class(bytes);
+    if(cls < this->free_lists_.size() && this->free_lists_[cls] != nullptr)
+    {
+        free_chunk* chunk = this->free_lists_[cls];
+        this->free_lists_[cls] = chunk->next;
+        return chunk;
+    }
+
+    // the size of a chunk is a multiple of alignment(), so current_ is always
+    // aligned if the block is.
+    const std::size_t size = alignment() << cls;
+    if(this->rest_ < size)
+    {
+        // operator new[] aligns the block for any fundamental type
+        const auto block = (std::max)(this->block_size_, size);
+        this->blocks_.emplace_back(new unsigned char[block]);
+        this->current_   = this->blocks_.back().get();
+        this->rest_      = block;
+        this->capacity_ += block;
+    }
+    void* p = this->current_;
+    this->current_ += size;
+    this->rest_    -= size;
+    return p;
+}
+
+TOML11_INLINE void value_arena::deallocate(void* p, const std::size_t bytes) noexcept
+{
+    if(p == nullptr)
+    {
+        return;
+    }
+    const auto cls = size_class(bytes);
+    if(this->free_lists_.size() <= cls)
+    {
+        try
+        {
+            this->free_lists_.resize(cls + 1, nullptr);
+        }
+        catch(...)
+        {
+            return; // leave it to the destructor of the arena
+        }
+    }
+    this->free_lists_[cls] = ::new(p) free_chunk{this->free_lists_[cls]};
+    return;
+}
+
+TOML11_INLINE arena_scope::arena_scope(value_arena& arena) noexcept
+    : previous_(detail::current_arena())
+{
+    detail::current_arena() = std::addressof(arena);
+}
+TOML11_INLINE arena_scope::~arena_scope() noexcept
+{
+    detail::current_arena() = this->previous_;
+}
+
+namespace detail
+{
+TOML11_INLINE value_arena*& current_arena() noexcept
+{
+    static thread_local value_arena* arena = nullptr;
+    return arena;
+}
+} // detail
+} // toml
+#endif // TOML11_ARENA_IMPL_HPP
@@ -3,6 +3,8 @@
 
 #include "../fwd/comments_fwd.hpp" // IWYU pragma: keep
 
+#include <algorithm>
+
 namespace toml
 {
 
@@ -42,5 +44,202 @@ TOML11_INLINE std::ostream& operator<<(std::ostream& os, const preserve_comments
     return os;
 }
 
+TOML11_INLINE preserve_comments::preserve_comments(const pooled_comments& c)
+    : comments(c.begin(), c.end())
+{}
+
+namespace detail
+{
+TOML11_INLINE void comment_pool::append(const std::string& line)
+{
+    if(0xFFFFFFFFu - this->text_.size() < line.size())
+    {
+        throw std::length_error("toml::detail::comment_pool: "
+                                "comments exceed 4 GiB");
+    }
+    this->text_.append(line);
+    this->ends_.push_back(static_cast<std::uint32_t>(this->text_.size()));
+    return;
+}
+
+TOML11_INLINE comment_pool_ptr make_comment_pool()
+{
+    return comment_pool_ptr(new comment_pool());
+}
+
+TOML11_INLINE int pooled_comment_line::compare(char const* p, const std::size_t n) const noexcept
+{
+    const auto cmp = std::string::traits_type::compare(
+        this->data_, p, (std::min)(this->size_, n));
+    if(cmp != 0) {return cmp;}
+    return this->size_ < n ? -1 : (n < this->size_ ? 1 : 0);
+}
+
+TOML11_INLINE bool operator==(const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept
+{
+    return lhs.compare(rhs.data(), rhs.size()) == 0;
+}
+TOML11_INLINE bool operator==(const pooled_comment_line& lhs, const std::string& rhs) noexcept
+{
+    return lhs.compare(rhs.data(), rhs.size()) == 0;
+}
+TOML11_INLINE bool operator==(const std::string& lhs, const pooled_comment_line& rhs) noexcept
+{
+    return rhs == lhs;
+}
+TOML11_INLINE bool operator==(const pooled_comment_line& lhs, char const* rhs) noexcept
+{
+    return lhs.compare(rhs, std::string::traits_type::length(rhs)) == 0;
+}
+TOML11_INLINE bool operator==(char const* lhs, const pooled_comment_line& rhs) noexcept
+{
+    return rhs == lhs;
+}
+TOML11_INLINE bool operator!=(const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator!=(const pooled_comment_line& lhs, const std::string& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator!=(const std::string& lhs, const pooled_comment_line& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator!=(const pooled_comment_line& lhs, char const* rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator!=(char const* lhs, const pooled_comment_line& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator< (const pooled_comment_line& lhs, const pooled_comment_line& rhs) noexcept
+{
+    return lhs.compare(rhs.data(), rhs.size()) < 0;
+}
+
+TOML11_INLINE std::ostream& operator<<(std::ostream& os, const pooled_comment_line& line)
+{
+    os.write(line.data(), static_cast<std::streamsize>(line.size()));
+    return os;
+}
+} // detail
+
+TOML11_INLINE pooled_comments::pooled_comments(const std::vector<std::string>& c)
+    : pooled_comments(c.begin(), c.end())
+{}
+TOML11_INLINE pooled_comments& pooled_comments::operator=(const std::vector<std::string>& c)
+{
+    this->assign(c.begin(), c.end());
+    return *this;
+}
+TOML11_INLINE pooled_comments::pooled_comments(const preserve_comments& c)
+    : pooled_comments(c.begin(), c.end())
+{}
+TOML11_INLINE pooled_comments::pooled_comments(std::initializer_list<std::string> x)
+    : pooled_comments(x.begin(), x.end())
+{}
+
+TOML11_INLINE void pooled_comments::push_back(const std::string& c)
+{
+    // do not touch the pool shared with the other values
+    if( ! this->pool_.unique() || ! this->at_end())
+    {
+        this->move_to(detail::make_comment_pool());
+    }
+    this->pool_->append(c);
+    this->size_ += 1;
+    return;
+}
+
+TOML11_INLINE void pooled_comments::append(const detail::comment_pool_ptr& pool, const std::string& c)
+{
+    if(this->pool_.get() != pool.get() || ! this->at_end())
+    {
+        this->move_to(pool);
+    }
+    this->pool_->append(c);
+    this->size_ += 1;
+    return;
+}
+
+TOML11_INLINE void pooled_comments::move_to(const detail::comment_pool_ptr& pool)
+{
+    const auto first = static_cast<std::uint32_t>(pool->size());
+    for(std::size_t i=0; i<this->size_; ++i)
+    {
+        // `line` copies it first, `pool` may be the same as `pool_`
+        pool->append(this->pool_->line(this->first_ + i));
+    }
+    this->pool_  = pool;
+    this->first_ = first;
+    return;
+}
+
+TOML11_INLINE int pooled_comments::compare_line(
+    const pooled_comments& lhs, const pooled_comments& rhs, const std::size_t i) noexcept
+{
+    const auto r = rhs[i];
+    return lhs[i].compare(r.data(), r.size());
+}
+
+TOML11_INLINE bool operator==(const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    if(lhs.size() != rhs.size()) {return false;}
+    if(lhs.pool() == rhs.pool() && lhs.first_ == rhs.first_) {return true;}
+    for(std::size_t i=0; i<lhs.size(); ++i)
+    {
+        if(pooled_comments::compare_line(lhs, rhs, i) != 0) {return false;}
+    }
+    return true;
+}
+TOML11_INLINE bool operator!=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator< (const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    const auto n = (std::min)(lhs.size(), rhs.size());
+    for(std::size_t i=0; i<n; ++i)
+    {
+        const auto cmp = pooled_comments::compare_line(lhs, rhs, i);
+        if(cmp != 0) {return cmp < 0;}
+    }
+    return lhs.size() < rhs.size();
+}
+TOML11_INLINE bool operator<=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    return !(rhs < lhs);
+}
+TOML11_INLINE bool operator> (const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    return rhs < lhs;
+}
+TOML11_INLINE bool operator>=(const pooled_comments& lhs, const pooled_comments& rhs) noexcept
+{
+    return !(lhs < rhs);
+}
+
+TOML11_INLINE void swap(pooled_comments& lhs, pooled_comments& rhs) noexcept
+{
+    lhs.swap(rhs);
+    return;
+}
+
+TOML11_INLINE std::ostream& operator<<(std::ostream& os, const pooled_comments& com)
+{
+    for(const auto& c : com)
+    {
+        if(c.empty() || c.front() != '#')
+        {
+            os << '#';
+        }
+        os << c << '\n';
+    }
+    return os;
+}
+
 } // toml11
 #endif // TOML11_COMMENTS_IMPL_HPP
@@ -0,0 +1,85 @@
+#ifndef TOML11_FAIL_FAST_IMPL_HPP
+#define TOML11_FAIL_FAST_IMPL_HPP
+
+#include "../fwd/fail_fast_fwd.hpp"
+#include "../source_buffer.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace toml
+{
+
+TOML11_INLINE std::ostream& operator<<(std::ostream& os, parse_error_code c)
+{
+    switch(c)
+    {
+        case parse_error_code::file_io      : os << "file_io";      return os;
+        case parse_error_code::syntax       : os << "syntax";       return os;
+        case parse_error_code::table_header : os << "table_header"; return os;
+        case parse_error_code::redefinition : os << "redefinition"; return os;
+        default                             : os << "unknown";      return os;
+    }
+}
+
+TOML11_INLINE std::string to_string(parse_error_code c)
+{
+    std::ostringstream oss;
+    oss << c;
+    return oss.str();
+}
+
+TOML11_INLINE std::vector<error_info> parse_failure::errors() const
+{
+    std::vector<error_info> errs;
+    if(this->code_ == parse_error_code::file_io || this->reparse_ == nullptr)
+    {
+        errs.push_back(error_info("toml::parse: " + this->io_error_, {}));
+        return errs;
+    }
+    return this->reparse_(this->source_, this->file_name_, this->spec_);
+}
+
+TOML11_INLINE std::string parse_failure::message() const
+{
+    std::string msg;
+    for(const auto& e : this->errors())
+    {
+        msg += format_error(e);
+    }
+    return msg;
+}
+
+namespace detail
+{
+
+TOML11_INLINE std::size_t error_offset(const source_buffer& src,
+        const source_ptr& sec, const std::size_t offset) noexcept
+{
+    if( ! sec)
+    {
+        return 0;
+    }
+    std::size_t base = 0;
+    if(sec.get() != &src)
+    {
+        // a section refers to a part of the bytes of `src`
+        const std::less<const source_buffer::char_type*> less{};
+        const auto first = src.data();
+        const auto last  = src.data() + src.size();
+        if(less(sec->data(), first) || less(last, sec->data()))
+        {
+            return 0;
+        }
+        base = static_cast<std::size_t>(sec->data() - first);
+    }
+    return (std::min)(base + offset, src.size());
+}
+
+} // detail
+} // toml
+#endif // TOML11_FAIL_FAST_IMPL_HPP
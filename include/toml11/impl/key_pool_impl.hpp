@@ -0,0 +1,136 @@
+#ifndef TOML11_KEY_POOL_IMPL_HPP
+#define TOML11_KEY_POOL_IMPL_HPP
+
+#include "../fwd/key_pool_fwd.hpp"
+#include "../version.hpp"
+
+namespace toml
+{
+namespace detail
+{
+TOML11_INLINE std::shared_ptr<const interned_string> make_interned_string(std::string s)
+{
+    const auto h = std::hash<std::string>{}(s);
+    return std::make_shared<const interned_string>(interned_string{std::move(s), h});
+}
+} // detail
+
+TOML11_INLINE interned_key::interned_key(std::string s)
+    : node_(detail::make_interned_string(std::move(s)))
+{}
+TOML11_INLINE interned_key::interned_key(const char* s)
+    : node_(detail::make_interned_string(std::string(s)))
+{}
+
+TOML11_INLINE std::string const& interned_key::str() const noexcept
+{
+    static const std::string empty;
+    return this->node_ ? this->node_->str : empty;
+}
+TOML11_INLINE std::size_t interned_key::hash() const noexcept
+{
+    static const std::size_t empty = std::hash<std::string>{}(std::string{});
+    return this->node_ ? this->node_->hash : empty;
+}
+
+TOML11_INLINE bool operator==(const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return lhs.same_bytes(rhs) ||
+        (lhs.hash() == rhs.hash() && lhs.str() == rhs.str());
+}
+TOML11_INLINE bool operator!=(const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+TOML11_INLINE bool operator< (const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return lhs.str() < rhs.str();
+}
+TOML11_INLINE bool operator<=(const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return lhs.str() <= rhs.str();
+}
+TOML11_INLINE bool operator> (const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return lhs.str() > rhs.str();
+}
+TOML11_INLINE bool operator>=(const interned_key& lhs, const interned_key& rhs) noexcept
+{
+    return lhs.str() >= rhs.str();
+}
+
+TOML11_INLINE bool operator==(const interned_key& lhs, const std::string& rhs) noexcept
+{
+    return lhs.str() == rhs;
+}
+TOML11_INLINE bool operator==(const std::string& lhs, const interned_key& rhs) noexcept
+{
+    return lhs == rhs.str();
+}
+TOML11_INLINE bool operator!=(const interned_key& lhs, const std::string& rhs) noexcept
+{
+    return lhs.str() != rhs;
+}
+TOML11_INLINE bool operator!=(const std::string& lhs, const interned_key& rhs) noexcept
+{
+    return lhs != rhs.str();
+}
+TOML11_INLINE bool operator==(const interned_key& lhs, const char* rhs) noexcept
+{
+    return lhs.str() == rhs;
+}
+TOML11_INLINE bool operator==(const char* lhs, const interned_key& rhs) noexcept
+{
+    return lhs == rhs.str();
+}
+TOML11_INLINE bool operator!=(const interned_key& lhs, const char* rhs) noexcept
+{
+    return lhs.str() != rhs;
+}
+TOML11_INLINE bool operator!=(const char* lhs, const interned_key& rhs) noexcept
+{
+    return lhs != rhs.str();
+}
+
+TOML11_INLINE std::string operator+(const std::string& lhs, const interned_key& rhs)
+{
+    return lhs + rhs.str();
+}
+TOML11_INLINE std::string operator+(const interned_key& lhs, const std::string& rhs)
+{
+    return lhs.str() + rhs;
+}
+TOML11_INLINE std::string operator+(const char* lhs, const interned_key& rhs)
+{
+    return lhs + rhs.str();
+}
+TOML11_INLINE std::string operator+(const interned_key& lhs, const char* rhs)
+{
+    return lhs.str() + rhs;
+}
+
+TOML11_INLINE std::ostream& operator<<(std::ostream& os, const interned_key& k)
+{
+    os << k.str();
+    return os;
+}
+
+TOML11_INLINE interned_key key_pool::intern(const std::string& s)
+{
+    const auto h = std::hash<std::string>{}(s);
+    const auto range = this->keys_.equal_range(h);
+    for(auto iter = range.first; iter != range.second; ++iter)
+    {
+        if(iter->second->str == s)
+        {
+            return interned_key(iter->second);
+        }
+    }
+    auto node = std::make_shared<const detail::interned_string>(
+            detail::interned_string{s, h});
+    this->keys_.emplace(h, node);
+    return interned_key(std::move(node));
+}
+
+} // toml
+#endif // TOML11_KEY_POOL_IMPL_HPP
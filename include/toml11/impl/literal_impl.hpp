@@ -132,7 +132,7 @@ operator"" _toml(const char* str, std::size_t len)
     }
 
     return literal_internal_impl(::toml::detail::location(
-        std::make_shared<const toml::detail::location::container_type>(std::move(c)),
+        ::toml::detail::make_source(std::move(c)),
         "TOML literal encoded in a C++ code"));
 }
 
@@ -163,7 +163,7 @@ operator"" _toml(const char8_t* str, std::size_t len)
     }
 
     return literal_internal_impl(::toml::detail::location(
-        std::make_shared<const toml::detail::location::container_type>(std::move(c)),
+        ::toml::detail::make_source(std::move(c)),
         "TOML literal encoded in a C++ code"));
 }
 #endif
@@ -2,26 +2,78 @@
 #define TOML11_LOCATION_IMPL_HPP
 
 #include "../fwd/location_fwd.hpp"
+#include "../source_buffer.hpp"
+#include "../simd.hpp"
 #include "../utility.hpp"
 #include "../version.hpp"
 
+#include <algorithm>
+
 namespace toml
 {
 namespace detail
 {
 
+TOML11_INLINE std::size_t
+newline_index::line_number(const source_buffer& src, const std::size_t offset)
+{
+    return src.line_offset() + this->count_newlines(src, offset) + 1;
+}
+TOML11_INLINE std::size_t
+newline_index::column_number(const source_buffer& src, const std::size_t offset)
+{
+    const auto n = this->count_newlines(src, offset);
+    const auto line_begin = (n == 0) ? 0 : this->newlines_[n-1] + 1;
+    return offset - line_begin + 1;
+}
+
+TOML11_INLINE std::size_t
+newline_index::count_newlines(const source_buffer& src, const std::size_t offset)
+{
+    if( ! this->built_.load(std::memory_order_acquire))
+    {
+        this->build(src);
+    }
+    return static_cast<std::size_t>(std::distance(this->newlines_.begin(),
+        std::lower_bound(this->newlines_.begin(), this->newlines_.end(), offset)));
+}
+
+TOML11_INLINE void newline_index::build(const source_buffer& src)
+{
+    std::lock_guard<std::mutex> lock(this->mtx_);
+    if(this->built_.load(std::memory_order_relaxed))
+    {
+        return; // another thread has built it
+    }
+
+    // the logical newline at the end is in the last segment
+    std::size_t offset = 0;
+    while(offset < src.size())
+    {
+        const auto first = src.pointer_to(offset);
+        const auto last  = src.end_from(offset);
+        auto iter = simd::find_newline(first, last);
+        while(iter != last)
+        {
+            this->newlines_.push_back(offset + static_cast<std::size_t>(iter - first));
+            iter = simd::find_newline(iter + 1, last);
+        }
+        offset += static_cast<std::size_t>(last - first);
+    }
+    this->built_.store(true, std::memory_order_release);
+    return;
+}
+
 TOML11_INLINE void location::advance(std::size_t n) noexcept
 {
     assert(this->is_ok());
-    if(this->location_ + n < this->source_->size())
+    if(this->location_ + n < this->source()->size())
     {
-        this->advance_line_number(n);
         this->location_ += n;
     }
     else
     {
-        this->advance_line_number(this->source_->size() - this->location_);
-        this->location_ = this->source_->size();
+        this->location_ = this->source()->size();
     }
 }
 TOML11_INLINE void location::retrace(std::size_t n) noexcept
@@ -30,11 +82,9 @@ TOML11_INLINE void location::retrace(std::size_t n) noexcept
     if(this->location_ < n)
     {
         this->location_ = 0;
-        this->line_number_ = 1;
     }
     else
     {
-        this->retrace_line_number(n);
         this->location_ -= n;
     }
 }
@@ -42,110 +92,51 @@ TOML11_INLINE void location::retrace(std::size_t n) noexcept
 TOML11_INLINE bool location::eof() const noexcept
 {
     assert(this->is_ok());
-    return this->location_ >= this->source_->size();
+    return this->location_ >= this->source()->size();
 }
 TOML11_INLINE location::char_type location::current() const
 {
     assert(this->is_ok());
     if(this->eof()) {return '\0';}
 
-    assert(this->location_ < this->source_->size());
-    return this->source_->at(this->location_);
+    assert(this->location_ < this->source()->size());
+    return (*this->source())[this->location_];
 }
 
 TOML11_INLINE location::char_type location::peek()
 {
     assert(this->is_ok());
-    if(this->location_ >= this->source_->size())
+    if(this->location_ >= this->source()->size())
     {
         return '\0';
     }
     else
     {
-        return this->source_->at(this->location_ + 1);
+        return this->source()->at(this->location_ + 1);
     }
 }
 
 TOML11_INLINE void location::set_location(const std::size_t loc) noexcept
 {
-    if(this->location_ == loc)
-    {
-        return ;
-    }
-
-    if(loc == 0)
-    {
-        this->line_number_ = 1;
-    }
-    else if(this->location_ < loc)
-    {
-        const auto d = loc - this->location_;
-        this->advance_line_number(d);
-    }
-    else
-    {
-        const auto d = this->location_ - loc;
-        this->retrace_line_number(d);
-    }
     this->location_ = loc;
 }
 
-TOML11_INLINE std::string location::get_line() const
+TOML11_INLINE std::size_t location::line_number() const
 {
     assert(this->is_ok());
-    const auto iter = std::next(this->source_->cbegin(), static_cast<difference_type>(this->location_));
-    const auto riter = cxx::make_reverse_iterator(iter);
-
-    const auto prev = std::find(riter, this->source_->crend(), char_type('\n'));
-    const auto next = std::find(iter,  this->source_->cend(),  char_type('\n'));
-
-    return make_string(std::next(prev.base()), next);
-}
-TOML11_INLINE std::size_t location::column_number() const noexcept
-{
-    assert(this->is_ok());
-    const auto iter  = std::next(this->source_->cbegin(), static_cast<difference_type>(this->location_));
-    const auto riter = cxx::make_reverse_iterator(iter);
-    const auto prev  = std::find(riter, this->source_->crend(), char_type('\n'));
-
-    assert(prev.base() <= iter);
-    return static_cast<std::size_t>(std::distance(prev.base(), iter) + 1); // 1-origin
+    return this->record_->lines.line_number(*this->source(), this->location_);
 }
 
-
-TOML11_INLINE void location::advance_line_number(const std::size_t n)
+TOML11_INLINE std::string location::get_line() const
 {
     assert(this->is_ok());
-    assert(this->location_ + n <= this->source_->size());
-
-    const auto iter = this->source_->cbegin();
-    this->line_number_ += static_cast<std::size_t>(std::count(
-        std::next(iter, static_cast<difference_type>(this->location_)),
-        std::next(iter, static_cast<difference_type>(this->location_ + n)),
-        char_type('\n')));
-
-    return;
+    const auto& src = *this->source();
+    return src.substr(src.line_first(this->location_), src.line_last(this->location_));
 }
-TOML11_INLINE void location::retrace_line_number(const std::size_t n)
+TOML11_INLINE std::size_t location::column_number() const
 {
     assert(this->is_ok());
-    assert(n <= this->location_); // loc - n >= 0
-
-    const auto iter = this->source_->cbegin();
-    const auto dline_num = static_cast<std::size_t>(std::count(
-        std::next(iter, static_cast<difference_type>(this->location_ - n)),
-        std::next(iter, static_cast<difference_type>(this->location_)),
-        char_type('\n')));
-
-    if(this->line_number_ <= dline_num)
-    {
-        this->line_number_ = 1;
-    }
-    else
-    {
-        this->line_number_ -= dline_num;
-    }
-    return;
+    return this->record_->lines.column_number(*this->source(), this->location_);
 }
 
 TOML11_INLINE bool operator==(const location& lhs, const location& rhs) noexcept
@@ -154,8 +145,9 @@ TOML11_INLINE bool operator==(const location& lhs, const location& rhs) noexcept
     {
         return (!lhs.is_ok()) && (!rhs.is_ok());
     }
-    return lhs.source()       == rhs.source()      &&
-           lhs.source_name()  == rhs.source_name() &&
+    return (lhs.record() == rhs.record() ||
+            (lhs.source()      == rhs.source() &&
+             lhs.source_name() == rhs.source_name())) &&
            lhs.get_location() == rhs.get_location();
 }
 TOML11_INLINE bool operator!=(const location& lhs, const location& rhs)
@@ -183,8 +175,7 @@ TOML11_INLINE location make_temporary_location(const std::string& str) noexcept
         [](const std::string::value_type& c) {
             return cxx::bit_cast<location::char_type>(c);
         });
-    return location(std::make_shared<const location::container_type>(
-            std::move(cont)), "internal temporary");
+    return location(make_source(std::move(cont)), "internal temporary");
 }
 
 TOML11_INLINE result<location, none_t>
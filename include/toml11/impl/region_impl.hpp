@@ -10,110 +10,148 @@
 #include <sstream>
 #include <vector>
 #include <cassert>
+#include <cstdint>
 
 namespace toml
 {
 namespace detail
 {
 
+// the offsets are checked by the parse functions. See max_source_size().
+TOML11_INLINE std::uint32_t region_offset(const std::size_t n) noexcept
+{
+    assert(n <= region::max_source_size());
+    return static_cast<std::uint32_t>(n);
+}
+
 // a value defined in [first, last).
 // Those source must be the same. Instread, `region` does not make sense.
 TOML11_INLINE region::region(const location& first, const location& last)
-    : source_(first.source()), source_name_(first.source_name()),
-      length_(last.get_location() - first.get_location()),
-      first_(first.get_location()),
-      first_line_(first.line_number()),
-      first_column_(first.column_number()),
-      last_(last.get_location()),
-      last_line_(last.line_number()),
-      last_column_(last.column_number())
+    : record_(first.record()),
+      first_ (region_offset(first.get_location())),
+      length_(region_offset(last.get_location() - first.get_location()) & 0x7FFFFFFFu),
+      is_char_(0)
 {
     assert(first.source()      == last.source());
     assert(first.source_name() == last.source_name());
 }
 
-    // shorthand of [loc, loc+1)
+// shorthand of [loc, loc+1)
+//
+// Unlike region(first, last), the last line and column are those of `loc`
+// with column + 1 even if it points a newline. If the source is empty, both
+// line and column become 0.
 TOML11_INLINE region::region(const location& loc)
-    : source_(loc.source()), source_name_(loc.source_name()), length_(0),
-      first_line_(0), first_column_(0), last_line_(0), last_column_(0)
+    : record_(loc.record()), first_(0), length_(0), is_char_(1)
 {
     // if the file ends with LF, the resulting region points no char.
     if(loc.eof())
     {
-        if(loc.get_location() == 0)
-        {
-            this->length_       = 0;
-            this->first_        = 0;
-            this->first_line_   = 0;
-            this->first_column_ = 0;
-            this->last_         = 0;
-            this->last_line_    = 0;
-            this->last_column_  = 0;
-        }
-        else
+        if(loc.get_location() != 0)
         {
-            const auto first = prev(loc);
-            this->first_        = first.get_location();
-            this->first_line_   = first.line_number();
-            this->first_column_ = first.column_number();
-            this->last_         = loc.get_location();
-            this->last_line_    = loc.line_number();
-            this->last_column_  = loc.column_number();
-            this->length_       = 1;
+            // the same as region(prev(loc), loc)
+            this->first_   = region_offset(loc.get_location() - 1);
+            this->length_  = 1;
+            this->is_char_ = 0;
         }
     }
     else
     {
-        this->first_        = loc.get_location();
-        this->first_line_   = loc.line_number();
-        this->first_column_ = loc.column_number();
-        this->last_         = loc.get_location() + 1;
-        this->last_line_    = loc.line_number();
-        this->last_column_  = loc.column_number() + 1;
-        this->length_       = 1;
+        this->first_  = region_offset(loc.get_location());
+        this->length_ = 1;
+    }
+}
+
+TOML11_INLINE region::source_ptr const& region::source() const noexcept
+{
+    static const source_ptr none;
+    return this->record_ ? this->record_->source : none;
+}
+TOML11_INLINE std::string const& region::source_name() const noexcept
+{
+    static const std::string none;
+    return this->record_ ? this->record_->name : none;
+}
+
+TOML11_INLINE std::size_t region::first_line_number() const
+{
+    if( ! this->is_ok() || (this->is_char_ && this->length_ == 0))
+    {
+        return 0;
+    }
+    return this->record_->lines.line_number(*this->source(), this->first());
+}
+TOML11_INLINE std::size_t region::first_column_number() const
+{
+    if( ! this->is_ok() || (this->is_char_ && this->length_ == 0))
+    {
+        return 0;
     }
+    return this->record_->lines.column_number(*this->source(), this->first());
+}
+TOML11_INLINE std::size_t region::last_line_number() const
+{
+    if( ! this->is_ok() || (this->is_char_ && this->length_ == 0))
+    {
+        return 0;
+    }
+    if(this->is_char_)
+    {
+        return this->first_line_number();
+    }
+    return this->record_->lines.line_number(*this->source(), this->last());
+}
+TOML11_INLINE std::size_t region::last_column_number() const
+{
+    if( ! this->is_ok() || (this->is_char_ && this->length_ == 0))
+    {
+        return 0;
+    }
+    if(this->is_char_)
+    {
+        return this->first_column_number() + 1;
+    }
+    return this->record_->lines.column_number(*this->source(), this->last());
 }
 
 TOML11_INLINE region::char_type region::at(std::size_t i) const
 {
-    if(this->last_ <= this->first_ + i)
+    if(this->last() <= this->first() + i)
     {
         throw std::out_of_range("range::at: index " + std::to_string(i) +
                 " exceeds length " + std::to_string(this->length_));
     }
-    const auto iter = std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_ + i));
-    return *iter;
+    return (*this->source())[this->first() + i];
 }
 
+// A region that starts before the last line and contains the newline that is
+// appended logically cannot be a contiguous range. It ends at the end of the
+// bytes. Use as_string() to get the whole region.
 TOML11_INLINE region::const_iterator region::begin() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_));
+    return this->source()->pointer_to(this->first());
 }
 TOML11_INLINE region::const_iterator region::end() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->last_));
+    const auto first = this->source()->pointer_to(this->first());
+    const auto last  = this->source()->end_from(this->first());
+    const auto len   = static_cast<std::size_t>(last - first);
+    return first + (std::min)(len, this->length());
 }
 TOML11_INLINE region::const_iterator region::cbegin() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->first_));
+    return this->begin();
 }
 TOML11_INLINE region::const_iterator region::cend() const noexcept
 {
-    return std::next(this->source_->cbegin(),
-            static_cast<difference_type>(this->last_));
+    return this->end();
 }
 
 TOML11_INLINE std::string region::as_string() const
 {
     if(this->is_ok())
     {
-        const auto begin = std::next(this->source_->cbegin(), static_cast<difference_type>(this->first_));
-        const auto end   = std::next(this->source_->cbegin(), static_cast<difference_type>(this->last_ ));
-        return ::toml::detail::make_string(begin, end);
+        return this->source()->substr(this->first(), this->last());
     }
     else
     {
@@ -153,19 +191,11 @@ TOML11_INLINE std::vector<std::string> region::as_lines() const
     // ```
     // So we start from `end-1` when looking for LF.
 
-    const auto begin_idx = static_cast<difference_type>(this->first_);
-    const auto end_idx   = static_cast<difference_type>(this->last_) - 1;
-
-    // length_ != 0, so begin < end. then begin <= end-1
-    assert(begin_idx <= end_idx);
-
-    const auto begin = std::next(this->source_->cbegin(), begin_idx);
-    const auto end   = std::next(this->source_->cbegin(), end_idx);
-
-    const auto line_begin = std::find(cxx::make_reverse_iterator(begin), this->source_->crend(), char_type('\n')).base();
-    const auto line_end   = std::find(end, this->source_->cend(), char_type('\n'));
+    // length_ != 0, so first < last. then first <= last-1
+    const auto line_begin = this->source()->line_first(this->first());
+    const auto line_end   = this->source()->line_last(this->last() - 1);
 
-    const auto reg_lines = make_string(line_begin, line_end);
+    const auto reg_lines = this->source()->substr(line_begin, line_end);
 
     if(reg_lines == "") // the region is an empty line that only contains LF
     {
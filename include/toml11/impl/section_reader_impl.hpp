@@ -0,0 +1,415 @@
+#ifndef TOML11_SECTION_READER_IMPL_HPP
+#define TOML11_SECTION_READER_IMPL_HPP
+
+#include "../fwd/section_reader_fwd.hpp"
+#include "../static_scanner.hpp"
+#include "../version.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cerrno>
+
+#if defined(TOML11_HAS_POSIX_FD)
+#  include <unistd.h>
+#endif
+
+namespace toml
+{
+namespace detail
+{
+
+TOML11_INLINE section_reader::section_reader(read_function read, spec s,
+        const std::size_t section_size, const std::size_t chunk_size)
+    : read_(std::move(read)), scanner_(std::move(s)),
+      section_size_(section_size), chunk_size_(chunk_size == 0 ? 1 : chunk_size),
+      buffer_(), scanned_(0), content_end_(0), line_offset_(0), eof_(false), done_(false)
+{}
+
+TOML11_INLINE result<source_ptr, std::string> section_reader::next()
+{
+    if(this->done_)
+    {
+        return ok(source_ptr(nullptr));
+    }
+
+    while(true)
+    {
+        const auto boundary = this->scan_lines(this->section_size_);
+        if(boundary != 0)
+        {
+            const auto bound = std::next(this->buffer_.begin(),
+                    static_cast<std::ptrdiff_t>(boundary));
+
+            container_type section(this->buffer_.begin(), bound);
+            this->buffer_.erase(this->buffer_.begin(), bound);
+            this->scanned_     -= boundary;
+            this->content_end_ -= boundary;
+
+            return ok(this->make_section(std::move(section), false));
+        }
+        if(this->eof_)
+        {
+            this->done_ = true;
+            this->buffer_.shrink_to_fit();
+            return ok(this->make_section(std::move(this->buffer_), true));
+        }
+
+        const auto size = this->buffer_.size();
+        this->buffer_.resize(size + this->chunk_size_);
+        const auto res = this->read_(this->buffer_.data() + size, this->chunk_size_);
+        if(res.is_err())
+        {
+            this->buffer_.resize(size);
+            this->done_ = true;
+            return err(res.unwrap_err());
+        }
+        const auto len = (std::min)(res.unwrap(), this->chunk_size_);
+        this->buffer_.resize(size + len);
+        if(len == 0)
+        {
+            this->eof_ = true;
+        }
+    }
+}
+
+TOML11_INLINE std::size_t section_reader::scan_lines(const std::size_t min_size)
+{
+    while(true)
+    {
+        const auto first = std::next(this->buffer_.cbegin(),
+                static_cast<std::ptrdiff_t>(this->scanned_));
+        const auto nl = std::find(first, this->buffer_.cend(), char_type('\n'));
+
+        // the last line may not have a newline
+        if(nl == this->buffer_.cend() && ( ! this->eof_ || first == nl))
+        {
+            return 0;
+        }
+        const auto line_first = this->scanned_;
+        const auto line_last  = (nl == this->buffer_.cend()) ? this->buffer_.size() :
+            static_cast<std::size_t>(std::distance(this->buffer_.cbegin(), nl)) + 1;
+
+        // the comments and empty lines before the header belong to the next
+        const auto boundary  = this->content_end_;
+        const auto is_header = this->scan_line(line_first, line_last);
+        this->scanned_ = line_last;
+
+        if(is_header && boundary != 0 && min_size <= boundary)
+        {
+            return boundary;
+        }
+    }
+}
+
+TOML11_INLINE bool header_scanner::scan_line(const char_type* first, const char_type* last)
+{
+    // a line in a multiline string or an array always has a content
+    bool has_content = this->state_ != state::normal || this->depth_ != 0;
+
+    bool is_header = false;
+    if( ! has_content)
+    {
+        const char_type* i = first;
+        while(i < last && (*i == ' ' || *i == '\t'))
+        {
+            ++i;
+        }
+        if(i < last && *i == '[')
+        {
+            // skip_until_next_table only stops at a valid header. Split the
+            // file at the same position so that the error recovery does not
+            // change.
+            namespace ss = static_scanner;
+            is_header = ss::either<ss::std_table, ss::array_table>::match(i, last, this->spec_);
+        }
+    }
+
+    const auto len = static_cast<std::size_t>(last - first);
+    const auto buf = first;
+    for(std::size_t i = 0; i < len; ++i)
+    {
+        const auto c = buf[i];
+        switch(this->state_)
+        {
+            case state::normal:
+            {
+                if(c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                {
+                    break;
+                }
+                if(c == '#') // skip the rest of the line
+                {
+                    i = len;
+                    break;
+                }
+                has_content = true;
+                if(c == '"' || c == '\'')
+                {
+                    const bool ml = i + 2 < len && buf[i+1] == c && buf[i+2] == c;
+                    if(ml)
+                    {
+                        i += 2;
+                    }
+                    if(c == '"')
+                    {
+                        this->state_ = ml ? state::ml_basic_string : state::basic_string;
+                    }
+                    else
+                    {
+                        this->state_ = ml ? state::ml_literal_string : state::literal_string;
+                    }
+                }
+                else if(c == '[' || c == '{')
+                {
+                    this->depth_ += 1;
+                }
+                else if(c == ']' || c == '}')
+                {
+                    this->depth_ -= (this->depth_ == 0) ? 0 : 1;
+                }
+                break;
+            }
+            case state::basic_string:
+            case state::ml_basic_string:
+            {
+                if(c == '\\')
+                {
+                    ++i; // skip the escaped character
+                }
+                else if(c == '"')
+                {
+                    if(this->state_ == state::basic_string)
+                    {
+                        this->state_ = state::normal;
+                    }
+                    else
+                    {
+                        std::size_t n = 1;
+                        while(i + n < len && buf[i + n] == '"') {++n;}
+                        if(3 <= n)
+                        {
+                            this->state_ = state::normal;
+                        }
+                        i += n - 1;
+                    }
+                }
+                break;
+            }
+            case state::literal_string:
+            case state::ml_literal_string:
+            {
+                if(c == '\'')
+                {
+                    if(this->state_ == state::literal_string)
+                    {
+                        this->state_ = state::normal;
+                    }
+                    else
+                    {
+                        std::size_t n = 1;
+                        while(i + n < len && buf[i + n] == '\'') {++n;}
+                        if(3 <= n)
+                        {
+                            this->state_ = state::normal;
+                        }
+                        i += n - 1;
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    // a one-line string ends at the newline (or the string is invalid)
+    if(this->state_ == state::basic_string || this->state_ == state::literal_string)
+    {
+        this->state_ = state::normal;
+    }
+    this->has_content_ = has_content;
+    return is_header;
+}
+
+TOML11_INLINE std::vector<table_header_position>
+find_table_headers(const source_buffer& src, const spec& s)
+{
+    const auto data = src.data();
+    const auto size = src.size() - (src.appends_newline() ? 1 : 0);
+
+    std::vector<table_header_position> headers;
+    header_scanner scanner(s);
+
+    // skip BOM at the beginning of the file
+    std::size_t first = 0;
+    if(3 <= size && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+    {
+        first = 3;
+    }
+
+    std::size_t content_end = 0; // the end of the last non-empty line
+    while(first < size)
+    {
+        const auto nl = std::find(data + first, data + size, source_buffer::char_type('\n'));
+        const auto last = (nl == data + size) ? size :
+            static_cast<std::size_t>(nl - data) + 1;
+
+        // the comments and empty lines before the header belong to it
+        if(scanner.scan_line(data + first, data + last))
+        {
+            table_header_position pos;
+            pos.section_first = content_end;
+            pos.header_first  = first;
+            headers.push_back(pos);
+        }
+        if(scanner.has_content())
+        {
+            content_end = last;
+        }
+        first = last;
+    }
+    return headers;
+}
+
+TOML11_INLINE std::vector<std::size_t> find_section_boundaries(
+        const source_buffer& src, const spec& s, const std::size_t min_size)
+{
+    std::vector<std::size_t> boundaries;
+    std::size_t section_first = 0;
+    for(const auto& header : find_table_headers(src, s))
+    {
+        const auto boundary = header.section_first;
+        if(section_first != boundary && section_first + min_size <= boundary)
+        {
+            boundaries.push_back(boundary);
+            section_first = boundary;
+        }
+    }
+    return boundaries;
+}
+
+TOML11_INLINE std::vector<source_ptr> split_source(const source_ptr& src,
+        const std::vector<std::size_t>& boundaries)
+{
+    const auto size = src->size() - (src->appends_newline() ? 1 : 0);
+
+    std::vector<source_ptr> sections;
+    sections.reserve(boundaries.size() + 1);
+
+    std::size_t first = 0;
+    std::size_t lines = 0;
+    for(std::size_t i=0; i<=boundaries.size(); ++i)
+    {
+        const bool is_last = (i == boundaries.size());
+        const auto last = is_last ? size : boundaries.at(i);
+
+        auto sec = std::make_shared<source_buffer>(src->data() + first,
+            last - first, is_last && src->appends_newline(), src);
+        sec->set_line_offset(src->line_offset() + lines);
+        sections.push_back(std::move(sec));
+
+        lines += static_cast<std::size_t>(std::count(src->data() + first,
+                    src->data() + last, source_buffer::char_type('\n')));
+        first = last;
+    }
+    return sections;
+}
+
+TOML11_INLINE bool section_reader::scan_line(const std::size_t first, const std::size_t last)
+{
+    // skip BOM at the beginning of the file
+    std::size_t line_first = first;
+    if(first == 0 && this->line_offset_ == 0 && 3 <= last &&
+       this->buffer_[0] == 0xEF && this->buffer_[1] == 0xBB && this->buffer_[2] == 0xBF)
+    {
+        line_first = 3;
+    }
+
+    const auto is_header = this->scanner_.scan_line(
+            this->buffer_.data() + line_first, this->buffer_.data() + last);
+    if(this->scanner_.has_content())
+    {
+        this->content_end_ = last;
+    }
+    return is_header;
+}
+
+TOML11_INLINE source_ptr
+section_reader::make_section(container_type bytes, const bool is_last)
+{
+    const auto lines = static_cast<std::size_t>(
+            std::count(bytes.begin(), bytes.end(), char_type('\n')));
+
+    auto src = std::make_shared<source_buffer>(std::move(bytes), is_last);
+    src->set_line_offset(this->line_offset_);
+
+    this->line_offset_ += lines;
+    return src;
+}
+
+TOML11_INLINE section_reader::read_function make_read_function(std::istream& is)
+{
+    // read through the streambuf so that the exception mask of the stream
+    // does not matter
+    return [&is](section_reader::char_type* buf, const std::size_t len)
+        -> result<std::size_t, std::string>
+    {
+        auto sb = is.rdbuf();
+        if(sb == nullptr)
+        {
+            return err(std::string("no stream buffer"));
+        }
+        const auto n = sb->sgetn(reinterpret_cast<char*>(buf),
+                                 static_cast<std::streamsize>(len));
+        if(n <= 0)
+        {
+            is.setstate(std::ios_base::eofbit);
+            return ok(std::size_t(0));
+        }
+        return ok(static_cast<std::size_t>(n));
+    };
+}
+
+TOML11_INLINE section_reader::read_function make_read_function(FILE* fp)
+{
+    return [fp](section_reader::char_type* buf, const std::size_t len)
+        -> result<std::size_t, std::string>
+    {
+        const auto n = std::fread(buf, sizeof(char), len, fp);
+        if(n < len && std::ferror(fp))
+        {
+            return err("errno = " + std::to_string(errno));
+        }
+        return ok(n);
+    };
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+TOML11_INLINE section_reader::read_function make_read_function(const int fd)
+{
+    return [fd](section_reader::char_type* buf, const std::size_t len)
+        -> result<std::size_t, std::string>
+    {
+        while(true)
+        {
+            const auto n = ::read(fd, buf, len);
+            if(0 <= n)
+            {
+                return ok(static_cast<std::size_t>(n));
+            }
+            if(errno != EINTR)
+            {
+                return err("errno = " + std::to_string(errno));
+            }
+        }
+    };
+}
+#endif
+
+} // detail
+} // toml
+#endif // TOML11_SECTION_READER_IMPL_HPP
@@ -0,0 +1,338 @@
+#ifndef TOML11_SOURCE_BUFFER_IMPL_HPP
+#define TOML11_SOURCE_BUFFER_IMPL_HPP
+
+#include "../fwd/source_buffer_fwd.hpp"
+#include "../utility.hpp"
+#include "../version.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <cassert>
+#include <cerrno>
+
+#if defined(TOML11_HAS_POSIX_FD)
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+#if defined(TOML11_HAS_POSIX_MMAP)
+#  include <sys/mman.h>
+#elif defined(TOML11_HAS_WIN32_MMAP)
+   // do not leak min/max and the rarely used APIs to the includers
+#  if ! defined(WIN32_LEAN_AND_MEAN)
+#    define WIN32_LEAN_AND_MEAN
+#    define TOML11_DEFINED_WIN32_LEAN_AND_MEAN
+#  endif
+#  if ! defined(NOMINMAX)
+#    define NOMINMAX
+#    define TOML11_DEFINED_NOMINMAX
+#  endif
+#  include <windows.h>
+#  if defined(TOML11_DEFINED_WIN32_LEAN_AND_MEAN)
+#    undef WIN32_LEAN_AND_MEAN
+#    undef TOML11_DEFINED_WIN32_LEAN_AND_MEAN
+#  endif
+#  if defined(TOML11_DEFINED_NOMINMAX)
+#    undef NOMINMAX
+#    undef TOML11_DEFINED_NOMINMAX
+#  endif
+#endif
+
+namespace toml
+{
+namespace detail
+{
+
+TOML11_INLINE source_buffer::source_buffer(container_type cont, const bool append_newline)
+    : storage_(std::move(cont)), keep_(nullptr), data_(nullptr), size_(0),
+      tail_first_(0), line_offset_(0)
+{
+    this->data_ = this->storage_.data();
+    this->size_ = this->storage_.size();
+    this->append_newline_if_needed(append_newline);
+}
+
+TOML11_INLINE source_buffer::source_buffer(const char_type* first,
+        const std::size_t len, const bool append_newline, std::shared_ptr<const void> keep)
+    : storage_(), keep_(std::move(keep)), data_(first), size_(len),
+      tail_first_(0), line_offset_(0)
+{
+    this->append_newline_if_needed(append_newline);
+}
+
+TOML11_INLINE void source_buffer::append_newline_if_needed(const bool append_newline)
+{
+    // if it ends with CR, the file is invalid (in TOML, CR is not a valid
+    // newline char). do not add LF so that the parser reports it.
+    if( ! append_newline || this->size_ == 0 || this->data_[this->size_ - 1] == '\n' ||
+                           this->data_[this->size_ - 1] == '\r')
+    {
+        this->tail_first_ = this->size_ + 1; // always points the bytes
+        return;
+    }
+
+    const auto rfirst = cxx::make_reverse_iterator(this->data_ + this->size_);
+    const auto rlast  = cxx::make_reverse_iterator(this->data_);
+    const auto line_first = std::find(rfirst, rlast, char_type('\n')).base();
+
+    this->tail_first_ = static_cast<std::size_t>(line_first - this->data_);
+    this->tail_.reserve(this->size_ - this->tail_first_ + 1);
+    this->tail_.assign(line_first, this->data_ + this->size_);
+    this->tail_.push_back(char_type('\n'));
+    return;
+}
+
+TOML11_INLINE source_buffer::char_type source_buffer::at(const std::size_t i) const
+{
+    if(this->size() <= i)
+    {
+        throw std::out_of_range("toml::detail::source_buffer::at: index " +
+            std::to_string(i) + " exceeds size " + std::to_string(this->size()));
+    }
+    return *this->pointer_to(i);
+}
+
+TOML11_INLINE std::string
+source_buffer::substr(const std::size_t first, const std::size_t last) const
+{
+    assert(first <= last && last <= this->size());
+
+    std::string retval;
+    retval.reserve(last - first);
+    if(this->size_ < last) // contains the logical newline
+    {
+        retval.append(this->data_ + first, this->data_ + this->size_);
+        retval += '\n';
+    }
+    else
+    {
+        retval.append(this->data_ + first, this->data_ + last);
+    }
+    return retval;
+}
+
+TOML11_INLINE std::size_t source_buffer::line_first(const std::size_t i) const noexcept
+{
+    std::size_t pos = (std::min)(i, this->size());
+    while(pos != 0 && (*this)[pos - 1] != '\n')
+    {
+        --pos;
+    }
+    return pos;
+}
+TOML11_INLINE std::size_t source_buffer::line_last(const std::size_t i) const noexcept
+{
+    std::size_t pos = i;
+    while(pos < this->size() && (*this)[pos] != '\n')
+    {
+        ++pos;
+    }
+    return (std::min)(pos, this->size());
+}
+
+TOML11_INLINE source_ptr
+make_source(source_buffer::container_type cont, const bool append_newline)
+{
+    return std::make_shared<const source_buffer>(std::move(cont), append_newline);
+}
+TOML11_INLINE source_ptr make_source(const source_buffer::char_type* first,
+        const std::size_t len, const bool append_newline)
+{
+    return std::make_shared<const source_buffer>(first, len, append_newline);
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+// reads `fd` until EOF and closes it. `size_hint` is the size reported by
+// fstat. A pipe or a file in /proc reports no size (or a wrong one), and a
+// regular file may grow after fstat, so the size is not trusted.
+TOML11_INLINE result<source_ptr, std::string>
+read_source_fd(const int fd, const std::size_t size_hint,
+               const std::string& fname, const bool append_newline)
+{
+    // +1 to find EOF without reallocation if the size is correct
+    source_buffer::container_type cont((std::max)(size_hint + 1, std::size_t(4096)));
+    std::size_t len = 0;
+    while(true)
+    {
+        if(len == cont.size())
+        {
+            cont.resize(cont.size() * 2);
+        }
+        const auto n = ::read(fd, cont.data() + len, cont.size() - len);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            const auto e = errno;
+            ::close(fd);
+            return err("Failed to read: \"" + fname + "\", errno = " + std::to_string(e));
+        }
+        if(n == 0) // EOF
+        {
+            break;
+        }
+        len += static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+    cont.resize(len);
+    return ok(make_source(std::move(cont), append_newline));
+}
+#endif
+
+TOML11_INLINE result<source_ptr, std::string>
+map_source_file(const std::string& fname, const bool append_newline)
+{
+#if defined(TOML11_HAS_POSIX_MMAP)
+
+    const int fd = ::open(fname.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        return err("Error opening file \"" + fname + "\", errno = " + std::to_string(errno));
+    }
+    struct stat st;
+    if(::fstat(fd, &st) != 0)
+    {
+        const auto e = errno;
+        ::close(fd);
+        return err("Failed to access: \"" + fname + "\", errno = " + std::to_string(e));
+    }
+    // only a non-empty regular file can be mapped. a pipe or a file in /proc
+    // reports no size, so it is read until EOF.
+    const auto len = static_cast<std::size_t>(st.st_size);
+    if( ! S_ISREG(st.st_mode) || len == 0)
+    {
+        return read_source_fd(fd, 0, fname, append_newline);
+    }
+
+    void* addr = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto e = errno;
+    ::close(fd); // the mapping is still valid after closing the file
+    if(addr == MAP_FAILED)
+    {
+        return err("Failed to map: \"" + fname + "\", errno = " + std::to_string(e));
+    }
+#  if defined(POSIX_MADV_SEQUENTIAL)
+    ::posix_madvise(addr, len, POSIX_MADV_SEQUENTIAL);
+#  endif
+
+    std::shared_ptr<const void> keep(addr, [len](const void* p) {
+            ::munmap(const_cast<void*>(p), len);
+        });
+    return ok(source_ptr(std::make_shared<const source_buffer>(
+            static_cast<const source_buffer::char_type*>(addr), len, append_newline, std::move(keep))));
+
+#elif defined(TOML11_HAS_WIN32_MMAP)
+
+    const HANDLE file = ::CreateFileA(fname.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return err("Error opening file \"" + fname + "\", error = " +
+                   std::to_string(::GetLastError()));
+    }
+    // only a non-empty file on a disk can be mapped. read the others until EOF.
+    if(::GetFileType(file) != FILE_TYPE_DISK)
+    {
+        ::CloseHandle(file);
+        return read_source_file(fname, append_newline);
+    }
+    LARGE_INTEGER size;
+    if( ! ::GetFileSizeEx(file, &size))
+    {
+        const auto e = ::GetLastError();
+        ::CloseHandle(file);
+        return err("Failed to access: \"" + fname + "\", error = " + std::to_string(e));
+    }
+    const auto len = static_cast<std::size_t>(size.QuadPart);
+    if(len == 0)
+    {
+        ::CloseHandle(file);
+        return read_source_file(fname, append_newline);
+    }
+
+    const HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const auto e1 = ::GetLastError();
+    ::CloseHandle(file);
+    if(mapping == nullptr)
+    {
+        return err("Failed to map: \"" + fname + "\", error = " + std::to_string(e1));
+    }
+    const void* addr = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    const auto e2 = ::GetLastError();
+    ::CloseHandle(mapping); // the view is still valid after closing the mapping
+    if(addr == nullptr)
+    {
+        return err("Failed to map: \"" + fname + "\", error = " + std::to_string(e2));
+    }
+
+    std::shared_ptr<const void> keep(addr, [](const void* p) {
+            ::UnmapViewOfFile(p);
+        });
+    return ok(source_ptr(std::make_shared<const source_buffer>(
+            static_cast<const source_buffer::char_type*>(addr), len, append_newline, std::move(keep))));
+
+#else
+
+    return read_source_file(fname, append_newline);
+
+#endif
+}
+
+TOML11_INLINE result<source_ptr, std::string>
+read_source_file(const std::string& fname, const bool append_newline)
+{
+#if defined(TOML11_HAS_POSIX_FD)
+
+    const int fd = ::open(fname.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        return err("Error opening file \"" + fname + "\", errno = " + std::to_string(errno));
+    }
+    struct stat st;
+    if(::fstat(fd, &st) != 0)
+    {
+        const auto e = errno;
+        ::close(fd);
+        return err("Failed to access: \"" + fname + "\", errno = " + std::to_string(e));
+    }
+    const auto size_hint = S_ISREG(st.st_mode) ? static_cast<std::size_t>(st.st_size) : 0;
+    return read_source_fd(fd, size_hint, fname, append_newline);
+
+#else
+
+    std::ifstream ifs(fname, std::ios_base::binary);
+    if( ! ifs.good())
+    {
+        return err("Error opening file \"" + fname + "\"");
+    }
+    ifs.seekg(0, std::ios::end);
+    const auto fsize = ifs.tellg();
+    ifs.clear();
+    ifs.seekg(0, std::ios::beg);
+    ifs.clear();
+
+    // a pipe or a device may not report its size. read until EOF.
+    source_buffer::container_type cont;
+    if(0 < fsize)
+    {
+        cont.reserve(static_cast<std::size_t>(fsize));
+    }
+    cont.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    if(ifs.bad())
+    {
+        return err("Failed to read: \"" + fname + "\"");
+    }
+    return ok(make_source(std::move(cont), append_newline));
+
+#endif
+}
+
+} // detail
+} // toml
+#endif // TOML11_SOURCE_BUFFER_IMPL_HPP
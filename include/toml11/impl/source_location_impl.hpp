@@ -23,36 +23,52 @@ TOML11_INLINE source_location::source_location(const detail::region& r)
       last_line_(1),
       last_column_(1),
       length_(0),
-      file_name_("unknown file")
+      region_{}
 {
     if(r.is_ok())
     {
         this->is_ok_        = true;
-        this->file_name_    = r.source_name();
         this->first_line_   = r.first_line_number();
         this->first_column_ = r.first_column_number();
         this->last_line_    = r.last_line_number();
         this->last_column_  = r.last_column_number();
         this->length_       = r.length();
-        this->line_str_     = r.as_lines();
+        this->region_       = r;
     }
 }
 
-TOML11_INLINE std::string const& source_location::first_line() const
+TOML11_INLINE std::string const& source_location::file_name() const noexcept
 {
-    if(this->line_str_.size() == 0)
+    static const std::string unknown("unknown file");
+    return this->is_ok_ ? this->region_.source_name() : unknown;
+}
+
+TOML11_INLINE std::vector<std::string> source_location::lines() const
+{
+    if( ! this->is_ok_)
+    {
+        return std::vector<std::string>{};
+    }
+    return this->region_.as_lines();
+}
+
+TOML11_INLINE std::string source_location::first_line() const
+{
+    auto ls = this->lines();
+    if(ls.size() == 0)
     {
         throw std::out_of_range("toml::source_location::first_line: `lines` is empty");
     }
-    return this->line_str_.front();
+    return std::move(ls.front());
 }
-TOML11_INLINE std::string const& source_location::last_line() const
+TOML11_INLINE std::string source_location::last_line() const
 {
-    if(this->line_str_.size() == 0)
+    auto ls = this->lines();
+    if(ls.size() == 0)
     {
         throw std::out_of_range("toml::source_location::first_line: `lines` is empty");
     }
-    return this->line_str_.back();
+    return std::move(ls.back());
 }
 
 namespace detail
@@ -132,62 +148,65 @@ TOML11_INLINE std::string format_location_impl(const std::size_t lnw,
 {
     std::ostringstream oss;
 
+    // the lines are copied from the source here, only once.
+    const auto lines = loc.lines();
+
     if(loc.file_name() != prev_fname)
     {
         format_filename(oss, loc);
-        if( ! loc.lines().empty())
+        if( ! lines.empty())
         {
             format_empty_line(oss, lnw);
         }
     }
 
-    if(loc.lines().size() == 1)
+    if(lines.size() == 1)
     {
         // when column points LF, it exceeds the size of the first line.
         std::size_t underline_limit = 1;
-        if(loc.first_line().size() < loc.first_column_number())
+        if(lines.front().size() < loc.first_column_number())
         {
             underline_limit = 1;
         }
         else
         {
-            underline_limit = loc.first_line().size() - loc.first_column_number() + 1;
+            underline_limit = lines.front().size() - loc.first_column_number() + 1;
         }
         const auto underline_len = (std::min)(underline_limit, loc.length());
 
-        format_line(oss, lnw, loc.first_line_number(), loc.first_line());
+        format_line(oss, lnw, loc.first_line_number(), lines.front());
         format_underline(oss, lnw, loc.first_column_number(), underline_len, msg);
     }
-    else if(loc.lines().size() == 2)
+    else if(lines.size() == 2)
     {
         const auto first_underline_len =
-            loc.first_line().size() - loc.first_column_number() + 1;
-        format_line(oss, lnw, loc.first_line_number(), loc.first_line());
+            lines.front().size() - loc.first_column_number() + 1;
+        format_line(oss, lnw, loc.first_line_number(), lines.front());
         format_underline(oss, lnw, loc.first_column_number(),
                 first_underline_len, "");
 
-        format_line(oss, lnw, loc.last_line_number(), loc.last_line());
+        format_line(oss, lnw, loc.last_line_number(), lines.back());
         format_underline(oss, lnw, 1, loc.last_column_number(), msg);
     }
-    else if(loc.lines().size() > 2)
+    else if(lines.size() > 2)
     {
         const auto first_underline_len =
-            loc.first_line().size() - loc.first_column_number() + 1;
-        format_line(oss, lnw, loc.first_line_number(), loc.first_line());
+            lines.front().size() - loc.first_column_number() + 1;
+        format_line(oss, lnw, loc.first_line_number(), lines.front());
         format_underline(oss, lnw, loc.first_column_number(),
                 first_underline_len, "and");
 
-        if(loc.lines().size() == 3)
+        if(lines.size() == 3)
         {
-            format_line(oss, lnw, loc.first_line_number()+1, loc.lines().at(1));
-            format_underline(oss, lnw, 1, loc.lines().at(1).size(), "and");
+            format_line(oss, lnw, loc.first_line_number()+1, lines.at(1));
+            format_underline(oss, lnw, 1, lines.at(1).size(), "and");
         }
         else
         {
             format_line(oss, lnw, loc.first_line_number()+1, " ...");
             format_empty_line(oss, lnw);
         }
-        format_line(oss, lnw, loc.last_line_number(), loc.last_line());
+        format_line(oss, lnw, loc.last_line_number(), lines.back());
         format_underline(oss, lnw, 1, loc.last_column_number(), msg);
     }
     // if loc is empty, do nothing.
@@ -0,0 +1,10 @@
+#ifndef TOML11_KEY_POOL_HPP
+#define TOML11_KEY_POOL_HPP
+
+#include "fwd/key_pool_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/key_pool_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_KEY_POOL_HPP
@@ -0,0 +1,365 @@
+#ifndef TOML11_LAZY_DOCUMENT_HPP
+#define TOML11_LAZY_DOCUMENT_HPP
+
+#include "compat.hpp"
+#include "context.hpp"
+#include "error_info.hpp"
+#include "exception.hpp"
+#include "find.hpp"
+#include "parser.hpp"
+#include "result.hpp"
+#include "section_reader.hpp"
+#include "source_buffer.hpp"
+#include "spec.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace toml
+{
+
+// `toml::lazy_document<>(fname, toml::map_file)` maps the file instead of
+// reading it. See lazy_document.
+struct map_file_t {};
+constexpr map_file_t map_file{};
+
+//
+// A TOML file that is parsed on demand.
+//
+// On construction, it only finds the top-level table headers and groups the
+// sections by the first key of their headers. The root table is parsed when a
+// key is first accessed, and the sections of a top-level key are parsed when
+// the key is first accessed by `at()`. The parsed values are cached. It can be
+// accessed from multiple threads.
+//
+// Only the sections that are parsed are checked. To check the whole file, call
+// `validate()`.
+//
+// By default, the file is read into memory. With `toml::map_file`, it is mapped
+// and only the pages of the parsed sections are loaded. In that case, the file
+// must not be truncated while the document is alive; reading the lost pages
+// raises SIGBUS on POSIX.
+//
+template<typename TypeConfig = type_config>
+class lazy_document
+{
+  public:
+
+    using config_type = TypeConfig;
+    using value_type  = basic_value<config_type>;
+    using key_type    = typename value_type::key_type;
+    using table_type  = typename value_type::table_type;
+
+  public:
+
+    // reads the file. If it fails, throws file_io_error.
+    explicit lazy_document(std::string fname, spec s = spec::default_version())
+        : spec_(std::move(s)), fname_(std::move(fname)), root_(new group)
+    {
+        this->open(detail::read_source_file(this->fname_, /*append_newline = */true));
+    }
+
+    // maps the file. If it fails, throws file_io_error.
+    lazy_document(std::string fname, map_file_t, spec s = spec::default_version())
+        : spec_(std::move(s)), fname_(std::move(fname)), root_(new group)
+    {
+        this->open(detail::map_source_file(this->fname_, /*append_newline = */true));
+    }
+
+    // `src` should have a newline at the end. See detail::make_source.
+    lazy_document(detail::source_ptr src, std::string fname, spec s = spec::default_version())
+        : spec_(std::move(s)), fname_(std::move(fname)), src_(std::move(src)),
+          root_(new group)
+    {
+        this->index_sections();
+    }
+
+    lazy_document(const lazy_document&) = delete;
+    lazy_document(lazy_document&&)      = default;
+    lazy_document& operator=(const lazy_document&) = delete;
+    lazy_document& operator=(lazy_document&&)      = default;
+    ~lazy_document() = default;
+
+    // if the root table has an error, throws syntax_error.
+    bool contains(const key_type& k) const
+    {
+        return this->groups_.count(k) != 0 || this->root().contains(k);
+    }
+
+    // parses the sections of `k` if they are not parsed yet. If they have an
+    // error, throws syntax_error. If `k` is not found, throws std::out_of_range.
+    value_type const& at(const key_type& k) const
+    {
+        const auto& r = this->root();
+
+        const auto found = this->groups_.find(k);
+        if(found == this->groups_.end())
+        {
+            return r.at(k);
+        }
+
+        group& g = *found->second;
+        parse_once(g, [this, &k, &g]() {
+            this->parse_group(k, g);
+        });
+        if( ! g.errors.empty())
+        {
+            throw_syntax_error(g.errors);
+        }
+        assert(g.value.has_value());
+        return g.value.value();
+    }
+
+    // parses the whole file again and returns the errors, if any.
+    result<detail::none_t, std::vector<error_info>> validate() const
+    {
+        auto res = detail::parse_impl<config_type>(this->src_, this->fname_, this->spec_);
+        if(res.is_err())
+        {
+            return err(std::move(res.unwrap_err()));
+        }
+        return ok();
+    }
+
+    spec const& toml_spec() const noexcept {return this->spec_;}
+
+  private:
+
+    // the sections of a top-level key, or the root table
+    struct group
+    {
+        group(): parsed(false) {}
+
+        // std::call_once requires libpthread on some platforms.
+        std::atomic<bool>               parsed;
+        std::mutex                      mtx;
+        std::vector<detail::source_ptr> sections;
+        cxx::optional<value_type>       value;
+        std::vector<error_info>         errors;
+    };
+
+    // calls `f` if `g` is not parsed yet. If `f` throws, the next call tries
+    // again.
+    template<typename F>
+    static void parse_once(group& g, F&& f)
+    {
+        if(g.parsed.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(g.mtx);
+        if(g.parsed.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        f();
+        g.parsed.store(true, std::memory_order_release);
+        return;
+    }
+
+    void open(result<detail::source_ptr, std::string> src)
+    {
+        if(src.is_err())
+        {
+            throw file_io_error("toml::lazy_document: " + src.unwrap_err(), this->fname_);
+        }
+        this->src_ = std::move(src.unwrap());
+        this->index_sections();
+    }
+
+    // splits the file at the table headers, and groups the sections by the
+    // first key of the header.
+    void index_sections()
+    {
+        const auto headers = detail::find_table_headers(*this->src_, this->spec_);
+
+        std::vector<std::size_t> boundaries;
+        boundaries.reserve(headers.size());
+        for(const auto& h : headers)
+        {
+            boundaries.push_back(h.section_first);
+        }
+        auto sections = detail::split_source(this->src_, boundaries);
+        assert(sections.size() == headers.size() + 1);
+
+        // a region stores the offsets in 31 bits. See region::max_source_size().
+        for(const auto& sec : sections)
+        {
+            if(sec->size() > detail::region::max_source_size())
+            {
+                throw_syntax_error(std::vector<error_info>{
+                    detail::make_section_size_error(this->fname_, sec->size())});
+            }
+        }
+
+        this->root_->sections.push_back(std::move(sections.front()));
+
+        detail::context<config_type> ctx(this->spec_);
+        for(std::size_t i=0; i<headers.size(); ++i)
+        {
+            // the header is in the section that starts with its comments
+            const auto header_first = headers.at(i).header_first - headers.at(i).section_first;
+
+            detail::location loc(sections.at(i+1), this->fname_);
+            loc.set_location(header_first);
+            detail::skip_whitespace(loc, ctx);
+
+            auto keys = detail::parse_array_table_key(loc, ctx);
+            if(keys.is_err())
+            {
+                loc.set_location(header_first);
+                detail::skip_whitespace(loc, ctx);
+                keys = detail::parse_table_key(loc, ctx);
+            }
+            if(keys.is_err())
+            {
+                continue; // checked only by validate()
+            }
+
+            auto& g = this->groups_[std::get<0>(keys.unwrap()).front()];
+            if( ! g)
+            {
+                g.reset(new group);
+            }
+            g->sections.push_back(std::move(sections.at(i+1)));
+        }
+        return;
+    }
+
+    value_type const& root() const
+    {
+        group& g = *this->root_;
+        parse_once(g, [this, &g]() {
+            detail::context<config_type> ctx(this->spec_);
+
+            detail::location loc(g.sections.front(), this->fname_);
+            detail::skip_bom(loc);
+            if(loc.eof())
+            {
+                g.value = value_type(table_type(), table_format_info{},
+                        std::vector<std::string>{}, detail::region(loc));
+                return;
+            }
+            auto r = detail::parse_root_table(loc, ctx);
+            detail::parse_tables(loc, ctx, r);
+
+            if(ctx.has_error())
+            {
+                g.errors = ctx.errors();
+            }
+            else
+            {
+                g.value = std::move(r);
+            }
+        });
+        if( ! g.errors.empty())
+        {
+            throw_syntax_error(g.errors);
+        }
+        assert(g.value.has_value());
+        return g.value.value();
+    }
+
+    // parses the sections into a table that only has `k` of the root, as
+    // parse_tables does for the whole file.
+    void parse_group(const key_type& k, group& g) const
+    {
+        detail::context<config_type> ctx(this->spec_);
+
+        const auto& r = this->root();
+        value_type tab(table_type{});
+        if(r.contains(k))
+        {
+            tab.as_table().emplace(k, r.at(k));
+        }
+
+        for(const auto& sec : g.sections)
+        {
+            detail::location loc(sec, this->fname_);
+            detail::parse_tables(loc, ctx, tab);
+        }
+
+        if(ctx.has_error())
+        {
+            g.errors = ctx.errors();
+        }
+        else
+        {
+            g.value = std::move(tab.as_table().at(k));
+        }
+        g.sections.clear(); // the values keep the bytes alive
+        return;
+    }
+
+    [[noreturn]]
+    static void throw_syntax_error(const std::vector<error_info>& errs)
+    {
+        std::string msg;
+        for(const auto& e : errs)
+        {
+            msg += format_error(e);
+        }
+        throw syntax_error(std::move(msg), errs);
+    }
+
+  private:
+
+    spec                 spec_;
+    std::string          fname_;
+    detail::source_ptr   src_;
+    std::unique_ptr<group> root_;
+    std::map<key_type, std::unique_ptr<group>> groups_;
+};
+
+// ----------------------------------------------------------------------------
+// find(lazy_document, keys...)
+
+template<typename TC>
+cxx::enable_if_t<detail::is_type_config<TC>::value, basic_value<TC>> const&
+find(const lazy_document<TC>& doc, const typename basic_value<TC>::key_type& k)
+{
+    return doc.at(k);
+}
+
+template<typename TC, typename K1, typename ... Ks>
+cxx::enable_if_t<detail::is_type_config<TC>::value, basic_value<TC>> const&
+find(const lazy_document<TC>& doc, const typename basic_value<TC>::key_type& k,
+     const K1& k1, const Ks& ... ks)
+{
+    return ::toml::find(doc.at(k), k1, ks...);
+}
+
+template<typename T, typename TC>
+decltype(::toml::get<T>(std::declval<basic_value<TC> const&>()))
+find(const lazy_document<TC>& doc, const typename basic_value<TC>::key_type& k)
+{
+    return ::toml::get<T>(doc.at(k));
+}
+
+template<typename T, typename TC, typename K1, typename ... Ks>
+decltype(::toml::get<T>(std::declval<basic_value<TC> const&>()))
+find(const lazy_document<TC>& doc, const typename basic_value<TC>::key_type& k,
+     const K1& k1, const Ks& ... ks)
+{
+    return ::toml::find<T>(doc.at(k), k1, ks...);
+}
+
+} // toml
+
+#if defined(TOML11_COMPILE_SOURCES)
+namespace toml
+{
+struct type_config;
+struct ordered_type_config;
+extern template class lazy_document<::toml::type_config>;
+extern template class lazy_document<::toml::ordered_type_config>;
+} // toml
+#endif // TOML11_COMPILE_SOURCES
+
+#endif // TOML11_LAZY_DOCUMENT_HPP
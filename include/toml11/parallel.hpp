@@ -0,0 +1,115 @@
+#ifndef TOML11_PARALLEL_HPP
+#define TOML11_PARALLEL_HPP
+
+#include "version.hpp"
+
+#include <exception>
+#include <system_error>
+#include <vector>
+
+#include <cstddef>
+
+#if defined(TOML11_HAS_THREADS)
+#  include <atomic>
+#  include <mutex>
+#  include <thread>
+#endif
+
+namespace toml
+{
+namespace detail
+{
+
+// the number of threads to use if a user passes 0
+inline std::size_t default_num_threads() noexcept
+{
+#if defined(TOML11_HAS_THREADS)
+    const auto n = std::thread::hardware_concurrency();
+    return (n == 0) ? 1 : static_cast<std::size_t>(n);
+#else
+    return 1;
+#endif
+}
+
+// calls `f(i)` for each i in [0, n) on at most `num_threads` threads including
+// the current one. The order of calls is not specified. If `f` throws, the
+// rest of the calls are skipped and the first exception is rethrown after all
+// the threads finish.
+//
+// If TOML11_DISABLE_THREADS is defined, it calls `f` in the current thread.
+template<typename F>
+void parallel_for(const std::size_t n, std::size_t num_threads, F&& f)
+{
+    if(num_threads == 0)
+    {
+        num_threads = default_num_threads();
+    }
+
+#if defined(TOML11_HAS_THREADS)
+    if(1 < num_threads && 1 < n)
+    {
+        std::atomic<std::size_t> next(0);
+        std::exception_ptr       error(nullptr);
+        std::mutex               mtx;
+
+        const auto work = [&]() {
+            while(true)
+            {
+                const auto i = next.fetch_add(1);
+                if(n <= i)
+                {
+                    return;
+                }
+                try
+                {
+                    f(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if( ! error)
+                    {
+                        error = std::current_exception();
+                    }
+                    next.store(n);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        const auto num_workers = ((num_threads < n) ? num_threads : n) - 1;
+        workers.reserve(num_workers);
+        for(std::size_t i=0; i<num_workers; ++i)
+        {
+            try
+            {
+                workers.emplace_back(work);
+            }
+            catch(const std::system_error&)
+            {
+                break; // failed to create a thread. work with the current ones.
+            }
+        }
+        work();
+        for(auto& w : workers)
+        {
+            w.join();
+        }
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+        return;
+    }
+#endif
+
+    for(std::size_t i=0; i<n; ++i)
+    {
+        f(i);
+    }
+    return;
+}
+
+} // detail
+} // toml
+#endif // TOML11_PARALLEL_HPP
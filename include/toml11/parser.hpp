@@ -4,14 +4,22 @@
 #include "context.hpp"
 #include "datetime.hpp"
 #include "error_info.hpp"
+#include "event_handler.hpp"
+#include "fail_fast.hpp"
+#include "parallel.hpp"
 #include "region.hpp"
 #include "result.hpp"
 #include "scanner.hpp"
+#include "section_reader.hpp"
+#include "select.hpp"
 #include "skip.hpp"
+#include "static_scanner.hpp"
 #include "syntax.hpp"
 #include "value.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #include <cassert>
@@ -105,11 +113,11 @@ parse_comment_line(location& loc, context<TC>& ctx)
 
     skip_whitespace(loc, ctx);
 
-    const auto com_reg = syntax::comment(spec).scan(loc);
+    const auto com_reg = static_scanner::scan<static_scanner::comment>(loc, spec);
     if(com_reg.is_ok())
     {
         // once comment started, newline must follow (or reach EOF).
-        if( ! loc.eof() && ! syntax::newline(spec).scan(loc).is_ok())
+        if( ! loc.eof() && ! static_scanner::scan<static_scanner::newline>(loc, spec).is_ok())
         {
             while( ! loc.eof()) // skip until newline to continue parsing
             {
@@ -183,13 +191,81 @@ parse_boolean(location& loc, const context<TC>& ctx)
  *                 |___/
  */
 
+// read the value of an integer token, skipping its prefix (e.g. `0x`).
+// `loc` points to the end of the token and is used in the error message.
+template<typename TC>
+result<typename basic_value<TC>::integer_type, error_info>
+read_integer(const region& reg, const std::size_t prefix, const std::uint8_t base,
+             const location& loc, std::true_type /*default readers*/)
+{
+    using integer_type = typename basic_value<TC>::integer_type;
+
+    // read the source directly. it skips `_` inline and checks overflow.
+    integer_type val{0};
+    if( ! read_int_digits(std::next(reg.cbegin(), static_cast<region::difference_type>(prefix)),
+                          reg.cend(), base, val))
+    {
+        return err(make_int_overflow_error<integer_type>(base, source_location(region(loc))));
+    }
+    return ok(val);
+}
+template<typename TC>
+result<typename basic_value<TC>::integer_type, error_info>
+read_integer(const region& reg, const std::size_t prefix, const std::uint8_t base,
+             const location& loc, std::false_type /*default readers*/)
+{
+    auto str = reg.as_string();
+
+    // skip prefix (`0x` etc) and zeros and underscores at the MSB
+    if(prefix != 0)
+    {
+        str.erase(str.begin(), std::find_if(
+                    std::next(str.begin(), static_cast<std::ptrdiff_t>(prefix)), str.end(),
+                    [](const char c) { return c != '0' && c != '_'; }));
+    }
+
+    // remove all `_` before calling TC::parse_int
+    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
+
+    // 0x0000_0000 becomes empty.
+    if(str.empty()) { str = "0"; }
+
+    return TC::parse_int(str, source_location(region(loc)), base);
+}
+template<typename TC>
+result<typename basic_value<TC>::integer_type, error_info>
+read_integer(const region& reg, const std::size_t prefix, const std::uint8_t base,
+             const location& loc)
+{
+    return read_integer<TC>(reg, prefix, base, loc, uses_default_number_readers<TC>{});
+}
+
+// set width and spacer of integer_format_info from the token.
+inline void set_integer_width(integer_format_info& fmt, const region& reg,
+                              const std::size_t prefix)
+{
+    const auto num_underscores = static_cast<std::size_t>(
+            std::count(reg.cbegin(), reg.cend(), '_'));
+    fmt.width = reg.length() - prefix - num_underscores;
+
+    if(num_underscores != 0)
+    {
+        using reverse_iterator = std::reverse_iterator<region::const_iterator>;
+        const auto rfirst = reverse_iterator(reg.cend());
+        const auto rlast  = reverse_iterator(reg.cbegin());
+        fmt.spacer = static_cast<std::size_t>(std::distance(
+                    rfirst, std::find(rfirst, rlast, '_')));
+    }
+    return;
+}
+
 template<typename TC>
 result<basic_value<TC>, error_info>
 parse_bin_integer(location& loc, const context<TC>& ctx)
 {
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::bin_int(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::bin_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_bin_integer: "
@@ -197,28 +273,11 @@ parse_bin_integer(location& loc, const context<TC>& ctx)
             syntax::bin_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::bin;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
+    fmt.fmt = integer_format::bin;
+    set_integer_width(fmt, reg, 2);
 
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0b` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find(std::next(str.begin(), 2), str.end(), '1'));
-
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    // 0b0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
-
-    const auto val = TC::parse_int(str, source_location(region(loc)), 2);
+    const auto val = read_integer<TC>(reg, 2, 2, loc);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
@@ -238,7 +297,7 @@ parse_oct_integer(location& loc, const context<TC>& ctx)
 {
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::oct_int(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::oct_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_oct_integer: "
@@ -246,31 +305,11 @@ parse_oct_integer(location& loc, const context<TC>& ctx)
             syntax::oct_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::oct;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0o` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find_if(
-                std::next(str.begin(), 2), str.end(), [](const char c) {
-                    return c != '0' && c != '_';
-                }));
-
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    // 0o0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
+    fmt.fmt = integer_format::oct;
+    set_integer_width(fmt, reg, 2);
 
-    const auto val = TC::parse_int(str, source_location(region(loc)), 8);
+    const auto val = read_integer<TC>(reg, 2, 8, loc);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
@@ -288,7 +327,7 @@ parse_hex_integer(location& loc, const context<TC>& ctx)
 {
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
-    auto reg = syntax::hex_int(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::hex_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_hex_integer: "
@@ -296,39 +335,20 @@ parse_hex_integer(location& loc, const context<TC>& ctx)
             syntax::hex_int(spec), loc));
     }
 
-    auto str = reg.as_string();
-
     integer_format_info fmt;
-    fmt.fmt   = integer_format::hex;
-    fmt.width = str.size() - 2 - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
-
-    // skip prefix `0x` and zeros and underscores at the MSB
-    str.erase(str.begin(), std::find_if(
-                std::next(str.begin(), 2), str.end(), [](const char c) {
-                    return c != '0' && c != '_';
-                }));
-
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    // 0x0000_0000 becomes empty.
-    if(str.empty()) { str = "0"; }
+    fmt.fmt = integer_format::hex;
+    set_integer_width(fmt, reg, 2);
 
-    // prefix zero and _ is removed. check if it uses upper/lower case.
+    // check if it uses upper/lower case.
     // if both upper and lower case letters are found, set upper=true.
-    const auto lower_not_found = std::find_if(str.begin(), str.end(),
-        [](const char c) { return std::islower(static_cast<int>(c)) != 0; }) == str.end();
-    const auto upper_found = std::find_if(str.begin(), str.end(),
-        [](const char c) { return std::isupper(static_cast<int>(c)) != 0; }) != str.end();
+    const auto digits = std::next(reg.cbegin(), 2); // skip `0x`
+    const auto lower_not_found = std::find_if(digits, reg.cend(),
+        [](const region::char_type c) { return 'a' <= c && c <= 'f'; }) == reg.cend();
+    const auto upper_found = std::find_if(digits, reg.cend(),
+        [](const region::char_type c) { return 'A' <= c && c <= 'F'; }) != reg.cend();
     fmt.uppercase = lower_not_found || upper_found;
 
-    const auto val = TC::parse_int(str, source_location(region(loc)), 16);
+    const auto val = read_integer<TC>(reg, 2, 16, loc);
     if(val.is_ok())
     {
         return ok(basic_value<TC>(val.as_ok(), std::move(fmt), {}, std::move(reg)));
@@ -349,7 +369,7 @@ parse_dec_integer(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::dec_int(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::dec_int>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_dec_integer: "
@@ -359,23 +379,12 @@ parse_dec_integer(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // it matches. gen value
-    auto str = reg.as_string();
 
     integer_format_info fmt;
     fmt.fmt = integer_format::dec;
-    fmt.width = str.size() - static_cast<std::size_t>(std::count(str.begin(), str.end(), '_'));
-
-    const auto first_underscore = std::find(str.rbegin(), str.rend(), '_');
-    if(first_underscore != str.rend())
-    {
-        fmt.spacer = static_cast<std::size_t>(std::distance(str.rbegin(), first_underscore));
-    }
+    set_integer_width(fmt, reg, 0);
 
-    // remove all `_` before calling TC::parse_int
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
-    auto src = source_location(region(loc));
-    const auto val = TC::parse_int(str, src, 10);
+    const auto val = read_integer<TC>(reg, 0, 10, loc);
     if(val.is_err())
     {
         loc = first;
@@ -459,9 +468,51 @@ parse_integer(location& loc, const context<TC>& ctx)
  *                            |___/
  */
 
+// read the value of a floating token. `loc` points to the end of the token and
+// is used in the error message.
+template<typename TC>
+result<typename basic_value<TC>::floating_type, error_info>
+read_floating(const region& reg, const bool is_hex, const location& loc,
+              std::true_type /*default readers*/)
+{
+    using floating_type = typename basic_value<TC>::floating_type;
+
+    // read the source directly. it skips `_` inline.
+    floating_type val{0};
+    if(is_hex)
+    {
+        float_parser::read_hexadecimal(reg.cbegin(), reg.cend(), val);
+    }
+    else if( ! float_parser::read_decimal(reg.cbegin(), reg.cend(), val))
+    {
+        return err(make_float_read_error(source_location(region(loc))));
+    }
+    return ok(val);
+}
+template<typename TC>
+result<typename basic_value<TC>::floating_type, error_info>
+read_floating(const region& reg, const bool is_hex, const location& loc,
+              std::false_type /*default readers*/)
+{
+    // remove all `_` before calling TC::parse_float
+    auto str = reg.as_string();
+    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
+
+    return TC::parse_float(str, source_location(region(loc)), is_hex);
+}
+template<typename TC>
+result<typename basic_value<TC>::floating_type, error_info>
+read_floating(const region& reg, const bool is_hex, const location& loc)
+{
+    return read_floating<TC>(reg, is_hex, loc, uses_default_number_readers<TC>{});
+}
+
+// If `token` is found by static_scanner::lex_number, it is already checked and
+// is not scanned again. Otherwise, its type is value_t::empty.
 template<typename TC>
 result<basic_value<TC>, error_info>
-parse_floating(location& loc, const context<TC>& ctx)
+parse_floating_impl(location& loc, const context<TC>& ctx,
+                    const static_scanner::number_token& token)
 {
     using floating_type = typename basic_value<TC>::floating_type;
 
@@ -471,9 +522,14 @@ parse_floating(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // check syntax
     bool is_hex = false;
-    std::string str;
     region reg;
-    if(spec.ext_hex_float && sequence(character('0'), character('x')).scan(loc).is_ok())
+    if(token.type == value_t::floating)
+    {
+        // lex_number does not accept hex floats
+        loc.advance(token.length);
+        reg = region(first, loc);
+    }
+    else if(spec.ext_hex_float && sequence(character('0'), character('x')).scan(loc).is_ok())
     {
         loc = first;
         is_hex = true;
@@ -485,52 +541,71 @@ parse_floating(location& loc, const context<TC>& ctx)
                 "invalid hex floating: float must be like: 0xABCp-3f",
                 syntax::floating(spec), loc));
         }
-        str = reg.as_string();
     }
     else
     {
-        reg = syntax::floating(spec).scan(loc);
+        reg = static_scanner::scan<static_scanner::floating>(loc, spec);
         if( ! reg.is_ok())
         {
             return err(make_syntax_error("toml::parse_floating: "
                 "invalid floating: float must be like: -3.14159_26535, 6.022e+23, "
                 "inf, or nan (lowercase).", syntax::floating(spec), loc));
         }
-        str = reg.as_string();
     }
 
     // ----------------------------------------------------------------------
     // it matches. gen value
 
+    // since we already checked that the token conforms the TOML standard,
+    // we can find each part by looking at the characters.
+    const auto has_sign = *reg.cbegin() == '+' || *reg.cbegin() == '-';
+    const auto negative = *reg.cbegin() == '-';
+    const auto head     = has_sign ? std::next(reg.cbegin()) : reg.cbegin();
+
     floating_format_info fmt;
 
+    const auto decpoint = std::find(reg.cbegin(), reg.cend(), '.');
+    const auto exponent = is_hex ? reg.cend() : std::find_if(reg.cbegin(), reg.cend(),
+        [](const location::char_type c) { return c == 'e' || c == 'E'; });
+    const auto not_underscore = [](const location::char_type c) { return c != '_'; };
+
     if(is_hex)
     {
-        fmt.fmt = floating_format::hex;
+        fmt.fmt  = floating_format::hex;
+        fmt.prec = std::numeric_limits<floating_type>::max_digits10;
     }
-    else
+    else if(exponent != reg.cend())
     {
-        // since we already checked that the string conforms the TOML standard.
-        if(std::find(str.begin(), str.end(), 'e') != str.end() ||
-           std::find(str.begin(), str.end(), 'E') != str.end())
+        // use exponent part. total width without sign, `.` and `_`
+        fmt.fmt  = floating_format::scientific;
+        fmt.prec = static_cast<std::size_t>(std::count_if(head, exponent, not_underscore));
+        if(decpoint != reg.cend())
         {
-            fmt.fmt = floating_format::scientific; // use exponent part
+            fmt.prec -= 1;
         }
-        else
+    }
+    else
+    {
+        // do not use exponent part. width after decimal point
+        fmt.fmt = floating_format::fixed;
+        if(decpoint != reg.cend())
         {
-            fmt.fmt = floating_format::fixed; // do not use exponent part
+            fmt.prec = static_cast<std::size_t>(
+                std::count_if(std::next(decpoint), exponent, not_underscore));
         }
     }
 
-    str.erase(std::remove(str.begin(), str.end(), '_'), str.end());
-
     floating_type val{0};
 
-    if(str == "inf" || str == "+inf")
+    if(*head == 'i')
     {
         TOML11_CONSTEXPR_IF(std::numeric_limits<floating_type>::has_infinity)
         {
             val = std::numeric_limits<floating_type>::infinity();
+            if(negative)
+            {
+                val = -val;
+            }
         }
         else
         {
@@ -542,24 +617,9 @@ parse_floating(location& loc, const context<TC>& ctx)
                 "floating_type: inf is not supported"));
         }
     }
-    else if(str == "-inf")
-    {
-        TOML11_CONSTEXPR_IF(std::numeric_limits<floating_type>::has_infinity)
-        {
-            val = -std::numeric_limits<floating_type>::infinity();
-        }
-        else
-        {
-            return err(make_error_info("toml::parse_floating: inf value found"
-                " but the current environment does not support inf. Please"
-                " make sure that the floating-point implementation conforms"
-                " IEEE 754/ISO 60559 international standard.",
-                source_location(region(loc)),
-                "floating_type: inf is not supported"));
-        }
-    }
-    else if(str == "nan" || str == "+nan")
+    else if(*head == 'n')
     {
+        using std::copysign;
         TOML11_CONSTEXPR_IF(std::numeric_limits<floating_type>::has_quiet_NaN)
         {
             val = std::numeric_limits<floating_type>::quiet_NaN();
@@ -577,73 +637,19 @@ parse_floating(location& loc, const context<TC>& ctx)
                 source_location(region(loc)),
                 "floating_type: NaN is not supported"));
         }
-    }
-    else if(str == "-nan")
-    {
-        using std::copysign;
-        TOML11_CONSTEXPR_IF(std::numeric_limits<floating_type>::has_quiet_NaN)
-        {
-            val = copysign(std::numeric_limits<floating_type>::quiet_NaN(), floating_type(-1));
-        }
-        else TOML11_CONSTEXPR_IF(std::numeric_limits<floating_type>::has_signaling_NaN)
-        {
-            val = copysign(std::numeric_limits<floating_type>::signaling_NaN(), floating_type(-1));
-        }
-        else
+        if(negative)
         {
-            return err(make_error_info("toml::parse_floating: NaN value found"
-                " but the current environment does not support NaN. Please"
-                " make sure that the floating-point implementation conforms"
-                " IEEE 754/ISO 60559 international standard.",
-                source_location(region(loc)),
-                "floating_type: NaN is not supported"));
+            val = copysign(val, floating_type(-1));
         }
     }
     else
     {
-        // set precision
-        const auto has_sign = ! str.empty() && (str.front() == '+' || str.front() == '-');
-        const auto decpoint = std::find(str.begin(), str.end(), '.');
-        const auto exponent = std::find_if(str.begin(), str.end(),
-            [](const char c) { return c == 'e' || c == 'E'; });
-        if(decpoint != str.end() && exponent != str.end())
-        {
-            assert(decpoint < exponent);
-        }
-
-        if(fmt.fmt == floating_format::scientific)
-        {
-            // total width
-            fmt.prec = static_cast<std::size_t>(std::distance(str.begin(), exponent));
-            if(has_sign)
-            {
-                fmt.prec -= 1;
-            }
-            if(decpoint != str.end())
-            {
-                fmt.prec -= 1;
-            }
-        }
-        else if(fmt.fmt == floating_format::hex)
-        {
-            fmt.prec = std::numeric_limits<floating_type>::max_digits10;
-        }
-        else
-        {
-            // width after decimal point
-            fmt.prec = static_cast<std::size_t>(std::distance(std::next(decpoint), exponent));
-        }
-
-        auto src = source_location(region(loc));
-        const auto res = TC::parse_float(str, src, is_hex);
-        if(res.is_ok())
-        {
-            val = res.as_ok();
-        }
-        else
+        const auto res = read_floating<TC>(reg, is_hex, loc);
+        if(res.is_err())
         {
             return err(res.as_err());
         }
+        val = res.as_ok();
     }
 
     // ----------------------------------------------------------------------
@@ -670,6 +676,14 @@ parse_floating(location& loc, const context<TC>& ctx)
     return ok(basic_value<TC>(val, std::move(fmt), {}, std::move(reg)));
 }
 
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_floating(location& loc, const context<TC>& ctx)
+{
+    const static_scanner::number_token unchecked{value_t::empty, 0, 0, 0};
+    return parse_floating_impl(loc, ctx, unchecked);
+}
+
 /* ============================================================================
  *  ___       _       _   _
  * |   \ __ _| |_ ___| |_(_)_ __  ___
@@ -678,9 +692,12 @@ parse_floating(location& loc, const context<TC>& ctx)
  */
 
 // all the offset_datetime, local_datetime, local_date parses date part.
+// If `length` is not 0, the date is already checked by
+// static_scanner::lex_number and is not scanned again.
 template<typename TC>
 result<std::tuple<local_date, local_date_format_info, region>, error_info>
-parse_local_date_only(location& loc, const context<TC>& ctx)
+parse_local_date_only(location& loc, const context<TC>& ctx,
+                      const std::size_t length = 0)
 {
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
@@ -689,12 +706,21 @@ parse_local_date_only(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::local_date(spec).scan(loc);
-    if( ! reg.is_ok())
+    region reg;
+    if(length != 0)
+    {
+        loc.advance(length);
+        reg = region(first, loc);
+    }
+    else
     {
-        return err(make_syntax_error("toml::parse_local_date: "
-            "invalid date: date must be like: 1234-05-06, yyyy-mm-dd.",
-            syntax::local_date(spec), loc));
+        reg = syntax::local_date(spec).scan(loc);
+        if( ! reg.is_ok())
+        {
+            return err(make_syntax_error("toml::parse_local_date: "
+                "invalid date: date must be like: 1234-05-06, yyyy-mm-dd.",
+                syntax::local_date(spec), loc));
+        }
     }
 
     // ----------------------------------------------------------------------
@@ -773,9 +799,10 @@ parse_local_date_only(location& loc, const context<TC>& ctx)
 
 template<typename TC>
 result<basic_value<TC>, error_info>
-parse_local_date(location& loc, const context<TC>& ctx)
+parse_local_date_impl(location& loc, const context<TC>& ctx,
+                      const static_scanner::number_token& token)
 {
-    auto val_fmt_reg = parse_local_date_only(loc, ctx);
+    auto val_fmt_reg = parse_local_date_only(loc, ctx, token.date_length);
     if(val_fmt_reg.is_err())
     {
         return err(val_fmt_reg.unwrap_err());
@@ -788,10 +815,21 @@ parse_local_date(location& loc, const context<TC>& ctx)
     return ok(basic_value<TC>(std::move(val), std::move(fmt), {}, std::move(reg)));
 }
 
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_local_date(location& loc, const context<TC>& ctx)
+{
+    const static_scanner::number_token unchecked{value_t::empty, 0, 0, 0};
+    return parse_local_date_impl(loc, ctx, unchecked);
+}
+
 // all the offset_datetime, local_datetime, local_time parses date part.
+// If `length` is not 0, the time is already checked by
+// static_scanner::lex_number and is not scanned again.
 template<typename TC>
 result<std::tuple<local_time, local_time_format_info, region>, error_info>
-parse_local_time_only(location& loc, const context<TC>& ctx)
+parse_local_time_only(location& loc, const context<TC>& ctx,
+                      const std::size_t length = 0)
 {
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
@@ -800,20 +838,29 @@ parse_local_time_only(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
     // check syntax
-    auto reg = syntax::local_time(spec).scan(loc);
-    if( ! reg.is_ok())
+    region reg;
+    if(length != 0)
     {
-        if(spec.v1_1_0_make_seconds_optional)
-        {
-            return err(make_syntax_error("toml::parse_local_time: "
-                "invalid time: time must be HH:MM(:SS.sss) (seconds are optional)",
-                syntax::local_time(spec), loc));
-        }
-        else
+        loc.advance(length);
+        reg = region(first, loc);
+    }
+    else
+    {
+        reg = syntax::local_time(spec).scan(loc);
+        if( ! reg.is_ok())
         {
-            return err(make_syntax_error("toml::parse_local_time: "
-                "invalid time: time must be HH:MM:SS(.sss) (subseconds are optional)",
-                syntax::local_time(spec), loc));
+            if(spec.v1_1_0_make_seconds_optional)
+            {
+                return err(make_syntax_error("toml::parse_local_time: "
+                    "invalid time: time must be HH:MM(:SS.sss) (seconds are optional)",
+                    syntax::local_time(spec), loc));
+            }
+            else
+            {
+                return err(make_syntax_error("toml::parse_local_time: "
+                    "invalid time: time must be HH:MM:SS(.sss) (subseconds are optional)",
+                    syntax::local_time(spec), loc));
+            }
         }
     }
 
@@ -940,11 +987,12 @@ parse_local_time_only(location& loc, const context<TC>& ctx)
 
 template<typename TC>
 result<basic_value<TC>, error_info>
-parse_local_time(location& loc, const context<TC>& ctx)
+parse_local_time_impl(location& loc, const context<TC>& ctx,
+                      const static_scanner::number_token& token)
 {
     const auto first = loc;
 
-    auto val_fmt_reg = parse_local_time_only(loc, ctx);
+    auto val_fmt_reg = parse_local_time_only(loc, ctx, token.time_length);
     if(val_fmt_reg.is_err())
     {
         return err(val_fmt_reg.unwrap_err());
@@ -959,7 +1007,16 @@ parse_local_time(location& loc, const context<TC>& ctx)
 
 template<typename TC>
 result<basic_value<TC>, error_info>
-parse_local_datetime(location& loc, const context<TC>& ctx)
+parse_local_time(location& loc, const context<TC>& ctx)
+{
+    const static_scanner::number_token unchecked{value_t::empty, 0, 0, 0};
+    return parse_local_time_impl(loc, ctx, unchecked);
+}
+
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_local_datetime_impl(location& loc, const context<TC>& ctx,
+                          const static_scanner::number_token& token)
 {
     using char_type = location::char_type;
 
@@ -969,7 +1026,7 @@ parse_local_datetime(location& loc, const context<TC>& ctx)
 
     // ----------------------------------------------------------------------
 
-    auto date_fmt_reg = parse_local_date_only(loc, ctx);
+    auto date_fmt_reg = parse_local_date_only(loc, ctx, token.date_length);
     if(date_fmt_reg.is_err())
     {
         return err(date_fmt_reg.unwrap_err());
@@ -998,7 +1055,7 @@ parse_local_datetime(location& loc, const context<TC>& ctx)
             std::move(src), "here"));
     }
 
-    auto time_fmt_reg = parse_local_time_only(loc, ctx);
+    auto time_fmt_reg = parse_local_time_only(loc, ctx, token.time_length);
     if(time_fmt_reg.is_err())
     {
         return err(time_fmt_reg.unwrap_err());
@@ -1018,7 +1075,16 @@ parse_local_datetime(location& loc, const context<TC>& ctx)
 
 template<typename TC>
 result<basic_value<TC>, error_info>
-parse_offset_datetime(location& loc, const context<TC>& ctx)
+parse_local_datetime(location& loc, const context<TC>& ctx)
+{
+    const static_scanner::number_token unchecked{value_t::empty, 0, 0, 0};
+    return parse_local_datetime_impl(loc, ctx, unchecked);
+}
+
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_offset_datetime_impl(location& loc, const context<TC>& ctx,
+                           const static_scanner::number_token& token)
 {
     using char_type = location::char_type;
 
@@ -1027,10 +1093,14 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
 
     offset_datetime_format_info fmt;
 
+    // date + delimiter + time + offset
+    const std::size_t offset_length = (token.type != value_t::offset_datetime) ? 0 :
+        token.length - token.date_length - 1 - token.time_length;
+
     // ----------------------------------------------------------------------
     // date part
 
-    auto date_fmt_reg = parse_local_date_only(loc, ctx);
+    auto date_fmt_reg = parse_local_date_only(loc, ctx, token.date_length);
     if(date_fmt_reg.is_err())
     {
         return err(date_fmt_reg.unwrap_err());
@@ -1065,7 +1135,7 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // time part
 
-    auto time_fmt_reg = parse_local_time_only(loc, ctx);
+    auto time_fmt_reg = parse_local_time_only(loc, ctx, token.time_length);
     if(time_fmt_reg.is_err())
     {
         return err(time_fmt_reg.unwrap_err());
@@ -1077,7 +1147,17 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // offset part
 
-    const auto ofs_reg = syntax::time_offset(spec).scan(loc);
+    region ofs_reg;
+    if(offset_length != 0)
+    {
+        const auto ofs_first = loc;
+        loc.advance(offset_length);
+        ofs_reg = region(ofs_first, loc);
+    }
+    else
+    {
+        ofs_reg = syntax::time_offset(spec).scan(loc);
+    }
     if( ! ofs_reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_offset_datetime: "
@@ -1143,6 +1223,14 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
     return ok(basic_value<TC>(val, std::move(fmt), {}, std::move(reg)));
 }
 
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_offset_datetime(location& loc, const context<TC>& ctx)
+{
+    const static_scanner::number_token unchecked{value_t::empty, 0, 0, 0};
+    return parse_offset_datetime_impl(loc, ctx, unchecked);
+}
+
 /* ============================================================================
  *   ___ _       _
  *  / __| |_ _ _(_)_ _  __ _
@@ -1151,22 +1239,29 @@ parse_offset_datetime(location& loc, const context<TC>& ctx)
  *                     |___/
  */
 
+// [first, last) is `xhh`, `uhhhh`, or `Uhhhhhhhh`. Since a region computes
+// its column number, it constructs a region only when it reports an error.
 template<typename TC>
 result<typename basic_value<TC>::string_type, error_info>
-parse_utf8_codepoint(const region& reg)
+parse_utf8_codepoint(const location& first, const location& last)
 {
     using string_type = typename basic_value<TC>::string_type;
     using char_type = typename string_type::value_type;
 
-    // assert(reg.as_lines().size() == 1); // XXX heavy check
+    const auto str = static_scanner::current_of(first);
+    const auto len = last.get_location() - first.get_location();
+    assert(len >= 1);
+    assert(str[0] == 'u' || str[0] == 'U' || str[0] == 'x');
 
-    const auto str = reg.as_string();
-    assert( ! str.empty());
-    assert(str.front() == 'u' || str.front() == 'U' || str.front() == 'x');
-
-    std::uint_least32_t codepoint;
-    std::istringstream iss(str.substr(1));
-    iss >> std::hex >> codepoint;
+    // the syntax is already checked. it consists of 2, 4, or 8 hex digits.
+    std::uint_least32_t codepoint = 0;
+    for(std::size_t i=1; i<len; ++i)
+    {
+        const auto c = str[i];
+        const auto d = ('0' <= c && c <= '9') ? (c - '0') :
+                       ('a' <= c && c <= 'f') ? (c - 'a' + 10) : (c - 'A' + 10);
+        codepoint = (codepoint << 4) | static_cast<std::uint_least32_t>(d);
+    }
 
     const auto to_char = [](const std::uint_least32_t i) noexcept -> char_type {
         const auto uc = static_cast<unsigned char>(i & 0xFF);
@@ -1188,7 +1283,7 @@ parse_utf8_codepoint(const region& reg)
     {
         if(0xD800 <= codepoint && codepoint <= 0xDFFF)
         {
-            auto src = source_location(reg);
+            auto src = source_location(region(first, last));
             return err(make_error_info("toml::parse_utf8_codepoint: "
                 "[0xD800, 0xDFFF] is not a valid UTF-8",
                 std::move(src), "here"));
@@ -1209,7 +1304,7 @@ parse_utf8_codepoint(const region& reg)
     }
     else // out of UTF-8 region
     {
-        auto src = source_location(reg);
+        auto src = source_location(region(first, last));
         return err(make_error_info("toml::parse_utf8_codepoint: "
             "input codepoint is too large.",
             std::move(src), "must be in range [0x00, 0x10FFFF]"));
@@ -1246,16 +1341,21 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(spec.v1_1_0_add_escape_sequence_x && loc.current() == 'x')
     {
-        auto scanner = sequence(character('x'), repeat_exact(2, syntax::hexdig(spec)));
-        const auto reg = scanner.scan(loc);
-        if( ! reg.is_ok())
+        namespace ss = static_scanner;
+        using scanner = ss::sequence<ss::character<'x'>, ss::repeat_exact<2, ss::hexdig>>;
+
+        const auto first = loc;
+        auto iter = ss::current_of(loc);
+        if( ! scanner::match(iter, ss::end_of(loc), spec))
         {
             auto src = source_location(region(loc));
             return err(make_error_info("toml::parse_escape_sequence: "
                    "invalid token found in UTF-8 codepoint \\xhh",
                    std::move(src), "here"));
         }
-        const auto utf8 = parse_utf8_codepoint<TC>(reg);
+        loc.advance(static_cast<std::size_t>(iter - ss::current_of(loc)));
+
+        const auto utf8 = parse_utf8_codepoint<TC>(first, loc);
         if(utf8.is_err())
         {
             return err(utf8.as_err());
@@ -1264,16 +1364,21 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(loc.current() == 'u')
     {
-        auto scanner = sequence(character('u'), repeat_exact(4, syntax::hexdig(spec)));
-        const auto reg = scanner.scan(loc);
-        if( ! reg.is_ok())
+        namespace ss = static_scanner;
+        using scanner = ss::sequence<ss::character<'u'>, ss::repeat_exact<4, ss::hexdig>>;
+
+        const auto first = loc;
+        auto iter = ss::current_of(loc);
+        if( ! scanner::match(iter, ss::end_of(loc), spec))
         {
             auto src = source_location(region(loc));
             return err(make_error_info("toml::parse_escape_sequence: "
                    "invalid token found in UTF-8 codepoint \\uhhhh",
                    std::move(src), "here"));
         }
-        const auto utf8 = parse_utf8_codepoint<TC>(reg);
+        loc.advance(static_cast<std::size_t>(iter - ss::current_of(loc)));
+
+        const auto utf8 = parse_utf8_codepoint<TC>(first, loc);
         if(utf8.is_err())
         {
             return err(utf8.as_err());
@@ -1282,16 +1387,21 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     }
     else if(loc.current() == 'U')
     {
-        auto scanner = sequence(character('U'), repeat_exact(8, syntax::hexdig(spec)));
-        const auto reg = scanner.scan(loc);
-        if( ! reg.is_ok())
+        namespace ss = static_scanner;
+        using scanner = ss::sequence<ss::character<'U'>, ss::repeat_exact<8, ss::hexdig>>;
+
+        const auto first = loc;
+        auto iter = ss::current_of(loc);
+        if( ! scanner::match(iter, ss::end_of(loc), spec))
         {
             auto src = source_location(region(loc));
             return err(make_error_info("toml::parse_escape_sequence: "
                    "invalid token found in UTF-8 codepoint \\Uhhhhhhhh",
                    std::move(src), "here"));
         }
-        const auto utf8 = parse_utf8_codepoint<TC>(reg);
+        loc.advance(static_cast<std::size_t>(iter - ss::current_of(loc)));
+
+        const auto utf8 = parse_utf8_codepoint<TC>(first, loc);
         if(utf8.is_err())
         {
             return err(utf8.as_err());
@@ -1318,90 +1428,107 @@ parse_escape_sequence(location& loc, const context<TC>& ctx)
     return ok(retval);
 }
 
+// decode the body of a (multiline) basic string, [loc, last).
+// The syntax is already checked, so it only looks for backslashes. It appends
+// unescaped runs at once and decodes escape sequences in place.
 template<typename TC>
-result<basic_value<TC>, error_info>
-parse_ml_basic_string(location& loc, const context<TC>& ctx)
+result<typename basic_value<TC>::string_type, error_info>
+parse_basic_string_body(location& loc, const std::size_t last,
+                        const bool multiline, const context<TC>& ctx)
 {
-    const auto first = loc;
+    using string_type = typename basic_value<TC>::string_type;
     const auto& spec = ctx.toml_spec();
 
-    string_format_info fmt;
-    fmt.fmt = string_format::multiline_basic;
-
-    auto reg = syntax::ml_basic_string(spec).scan(loc);
-    if( ! reg.is_ok())
-    {
-        return err(make_syntax_error("toml::parse_ml_basic_string: "
-            "invalid string format",
-            syntax::ml_basic_string(spec), loc));
-    }
+    assert(loc.get_location() <= last);
+    assert(last <= loc.source()->size());
 
-    // ----------------------------------------------------------------------
-    // it matches. gen value
+    string_type val;
+    val.reserve(last - loc.get_location());
 
-    auto str = reg.as_string();
+    while(loc.get_location() < last)
+    {
+        // the body never contains the logical newline, so it is contiguous
+        const auto first = static_scanner::current_of(loc);
+        const auto end   = first + (last - loc.get_location());
+        const auto bs    = std::find(first, end, '\\');
+        val.append(first, bs);
+        loc.advance(static_cast<std::size_t>(bs - first));
+        if(bs == end)
+        {
+            break;
+        }
 
-    // we already checked that it starts with """ and ends with """.
-    assert(str.substr(0, 3) == "\"\"\"");
-    str.erase(0, 3);
+        if(multiline) // remove whitespaces around escaped-newline
+        {
+            auto iter = bs;
+            if(static_scanner::escaped_newline::match(iter, end, spec))
+            {
+                loc.advance(static_cast<std::size_t>(iter - bs));
+                continue;
+            }
+        }
 
-    assert(str.size() >= 3);
-    assert(str.substr(str.size()-3, 3) == "\"\"\"");
-    str.erase(str.size()-3, 3);
+        auto esc = parse_escape_sequence(loc, ctx);
+
+        // syntax does not check its value. the unicode codepoint may be
+        // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
+        if(esc.is_err())
+        {
+            return err(esc.unwrap_err());
+        }
+        val += esc.unwrap();
+    }
+    return ok(std::move(val));
+}
+
+template<typename TC>
+result<basic_value<TC>, error_info>
+parse_ml_basic_string(location& loc, const context<TC>& ctx)
+{
+    const auto first = loc;
+    const auto& spec = ctx.toml_spec();
+
+    string_format_info fmt;
+    fmt.fmt = string_format::multiline_basic;
+
+    auto reg = static_scanner::scan<static_scanner::ml_basic_string>(loc, spec);
+    if( ! reg.is_ok())
+    {
+        return err(make_syntax_error("toml::parse_ml_basic_string: "
+            "invalid string format",
+            syntax::ml_basic_string(spec), loc));
+    }
+
+    // ----------------------------------------------------------------------
+    // it matches. gen value
+
+    // we already checked that it starts with """ and ends with """.
+    assert(reg.length() >= 6);
+    auto body = first;
+    body.advance(3);
 
     // the first newline just after """ is trimmed
-    if(str.size() >= 1 && str.at(0) == '\n')
+    const auto& src = *body.source();
+    const auto last = loc.get_location() - 3;
+    if(body.get_location() < last && src[body.get_location()] == '\n')
     {
-        str.erase(0, 1);
+        body.advance(1);
         fmt.start_with_newline = true;
     }
-    else if(str.size() >= 2 && str.at(0) == '\r' && str.at(1) == '\n')
+    else if(body.get_location() + 1 < last && src[body.get_location()] == '\r' &&
+            src[body.get_location() + 1] == '\n')
     {
-        str.erase(0, 2);
+        body.advance(2);
         fmt.start_with_newline = true;
     }
 
-    using string_type = typename basic_value<TC>::string_type;
-    string_type val;
+    auto val = parse_basic_string_body(body, last, /*multiline = */true, ctx);
+    if(val.is_err())
     {
-        auto iter = str.cbegin();
-        while(iter != str.cend())
-        {
-            if(*iter == '\\') // remove whitespaces around escaped-newline
-            {
-                // we assume that the string is not too long to copy
-                auto loc2 = make_temporary_location(make_string(iter, str.cend()));
-                if(syntax::escaped_newline(spec).scan(loc2).is_ok())
-                {
-                    std::advance(iter, loc2.get_location()); // skip escaped newline and indent
-                    // now iter points non-WS char
-                    assert(iter == str.end() || (*iter != ' ' && *iter != '\t'));
-                }
-                else // normal escape seq.
-                {
-                    auto esc = parse_escape_sequence(loc2, ctx);
-
-                    // syntax does not check its value. the unicode codepoint may be
-                    // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
-                    if(esc.is_err())
-                    {
-                        return err(esc.unwrap_err());
-                    }
-
-                    val += esc.unwrap();
-                    std::advance(iter, loc2.get_location());
-                }
-            }
-            else // we already checked the syntax. we don't need to check it again.
-            {
-                val += static_cast<typename string_type::value_type>(*iter);
-                ++iter;
-            }
-        }
+        return err(std::move(val.unwrap_err()));
     }
-
     return ok(basic_value<TC>(
-            std::move(val), std::move(fmt), {}, std::move(reg)
+            std::move(val.unwrap()), std::move(fmt), {}, std::move(reg)
         ));
 }
 
@@ -1412,7 +1539,7 @@ parse_basic_string_only(location& loc, const context<TC>& ctx)
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
 
-    auto reg = syntax::basic_string(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::basic_string>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_basic_string: "
@@ -1423,45 +1550,17 @@ parse_basic_string_only(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // it matches. gen value
 
-    auto str = reg.as_string();
-
-    assert(str.back() == '\"');
-    str.pop_back();
-    assert(str.at(0) == '\"');
-    str.erase(0, 1);
-
-    using string_type = typename basic_value<TC>::string_type;
-    using char_type   = typename string_type::value_type;
-    string_type val;
+    assert(reg.length() >= 2);
+    auto body = first;
+    body.advance(1); // skip "
 
+    auto val = parse_basic_string_body(body, loc.get_location() - 1,
+                                       /*multiline = */false, ctx);
+    if(val.is_err())
     {
-        auto iter = str.begin();
-        while(iter != str.end())
-        {
-            if(*iter == '\\')
-            {
-                auto loc2 = make_temporary_location(make_string(iter, str.end()));
-
-                auto esc = parse_escape_sequence(loc2, ctx);
-
-                // syntax does not check its value. the unicode codepoint may be
-                // invalid, e.g. out-of-bound, [0xD800, 0xDFFF]
-                if(esc.is_err())
-                {
-                    return err(esc.unwrap_err());
-                }
-
-                val += esc.unwrap();
-                std::advance(iter, loc2.get_location());
-            }
-            else
-            {
-                val += char_type(*iter); // we already checked the syntax.
-                ++iter;
-            }
-        }
+        return err(std::move(val.unwrap_err()));
     }
-    return ok(std::make_pair(val, reg));
+    return ok(std::make_pair(std::move(val.unwrap()), std::move(reg)));
 }
 
 template<typename TC>
@@ -1539,7 +1638,7 @@ parse_literal_string_only(location& loc, const context<TC>& ctx)
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
 
-    auto reg = syntax::literal_string(spec).scan(loc);
+    auto reg = static_scanner::scan<static_scanner::literal_string>(loc, spec);
     if( ! reg.is_ok())
     {
         return err(make_syntax_error("toml::parse_literal_string: "
@@ -1550,15 +1649,13 @@ parse_literal_string_only(location& loc, const context<TC>& ctx)
     // ----------------------------------------------------------------------
     // it matches. gen value
 
-    auto str = reg.as_string();
-
-    assert(str.back() == '\'');
-    str.pop_back();
-    assert(str.at(0) == '\'');
-    str.erase(0, 1);
+    assert(reg.length() >= 2);
+    assert(*reg.cbegin() == '\'');
+    assert(*std::prev(reg.cend()) == '\'');
 
+    // a literal string has no escape sequence. copy the body at once.
     using string_type = typename basic_value<TC>::string_type;
-    string_type val(str.begin(), str.end());
+    string_type val(std::next(reg.cbegin()), std::prev(reg.cend()));
 
     return ok(std::make_pair(std::move(val), std::move(reg)));
 }
@@ -1669,7 +1766,6 @@ template<typename TC>
 result<typename basic_value<TC>::key_type, error_info>
 parse_simple_key(location& loc, const context<TC>& ctx)
 {
-    using key_type = typename basic_value<TC>::key_type;
     const auto& spec = ctx.toml_spec();
 
     if(loc.current() == '\"')
@@ -1677,7 +1773,7 @@ parse_simple_key(location& loc, const context<TC>& ctx)
         auto str_res = parse_basic_string_only(loc, ctx);
         if(str_res.is_ok())
         {
-            return ok(std::move(str_res.unwrap().first));
+            return ok(ctx.make_key(std::move(str_res.unwrap().first)));
         }
         else
         {
@@ -1689,7 +1785,7 @@ parse_simple_key(location& loc, const context<TC>& ctx)
         auto str_res = parse_literal_string_only(loc, ctx);
         if(str_res.is_ok())
         {
-            return ok(std::move(str_res.unwrap().first));
+            return ok(ctx.make_key(std::move(str_res.unwrap().first)));
         }
         else
         {
@@ -1699,9 +1795,9 @@ parse_simple_key(location& loc, const context<TC>& ctx)
 
     // bare key.
 
-    if(const auto bare = syntax::unquoted_key(spec).scan(loc))
+    if(const auto bare = static_scanner::scan<static_scanner::unquoted_key>(loc, spec))
     {
-        return ok(string_conv<key_type>(bare.as_string()));
+        return ok(ctx.make_key(bare.as_string()));
     }
     else
     {
@@ -1796,6 +1892,102 @@ parse_key_value_pair(location& loc, context<TC>& ctx)
     return ok(std::make_pair(std::move(key_res.unwrap()), std::move(v_res.unwrap())));
 }
 
+/* ============================================================================
+ *  ___             _
+ * | __|_ _____ _ _| |_ ___
+ * | _|\ V / -_) ' \  _(_-<
+ * |___|\_/\___|_||_\__/__/
+ */
+
+// If an event_handler is set to the context, the values are reported to it
+// while they are parsed instead of being kept in the tree. Still, the tree
+// holds placeholders so that insert_value can check the definitions that
+// follow. Arrays and inline tables report their elements by themselves.
+
+// after an error, the events would not make sense
+template<typename TC>
+event_handler<TC>* reporting_handler(const context<TC>& ctx)
+{
+    return ctx.has_error() ? nullptr : ctx.handler();
+}
+
+template<typename TC>
+void report_comments(event_handler<TC>& handler, const typename basic_value<TC>::comment_type& com)
+{
+    for(const auto& c : com)
+    {
+        handler.on_comment(c);
+    }
+    return;
+}
+
+// reports a value other than an array and an inline table
+template<typename TC>
+void report_value(event_handler<TC>& handler, const basic_value<TC>& v)
+{
+    switch(v.type())
+    {
+        case value_t::empty          : {handler.on_null();                                 break;}
+        case value_t::boolean        : {handler.on_boolean        (v.as_boolean        ()); break;}
+        case value_t::integer        : {handler.on_integer        (v.as_integer        ()); break;}
+        case value_t::floating       : {handler.on_floating       (v.as_floating       ()); break;}
+        case value_t::string         : {handler.on_string         (v.as_string         ()); break;}
+        case value_t::offset_datetime: {handler.on_offset_datetime(v.as_offset_datetime()); break;}
+        case value_t::local_datetime : {handler.on_local_datetime (v.as_local_datetime ()); break;}
+        case value_t::local_date     : {handler.on_local_date     (v.as_local_date     ()); break;}
+        case value_t::local_time     : {handler.on_local_time     (v.as_local_time     ()); break;}
+        default: {break;}
+    }
+    return;
+}
+
+// insert_value needs the type of the value, whether it is an inline table (or
+// an inline array of tables), and its region to report errors. The contents
+// are not needed.
+template<typename TC>
+basic_value<TC> make_placeholder(const basic_value<TC>& v)
+{
+    using value_type = basic_value<TC>;
+    using array_type = typename value_type::array_type;
+    using table_type = typename value_type::table_type;
+
+    value_type p;
+    if(v.is_table())
+    {
+        p = value_type(table_type{}, v.as_table_fmt(), std::vector<std::string>{}, region{});
+    }
+    else if(v.is_array_of_tables())
+    {
+        p = value_type(array_type{value_type(table_type{})}, v.as_array_fmt(),
+                       std::vector<std::string>{}, region{});
+    }
+    else
+    {
+        p = value_type(none_t{}, region{});
+    }
+    change_region_of_value(p, v);
+    return p;
+}
+
+// reports a table header after it is inserted to the tree
+template<typename TC>
+void report_table_header(context<TC>& ctx, basic_value<TC>& table,
+        const std::vector<typename basic_value<TC>::key_type>& keys,
+        const bool is_array_of_tables)
+{
+    if( ! ctx.handler())
+    {
+        return;
+    }
+    if(auto handler = reporting_handler(ctx))
+    {
+        report_comments(*handler, table.comments());
+        handler->on_table_header(keys, is_array_of_tables);
+    }
+    table.comments().clear();
+    return;
+}
+
 /* ============================================================================
  *    __ _ _ _ _ _ __ _ _  _
  *   / _` | '_| '_/ _` | || |
@@ -1842,10 +2034,13 @@ skip_multiline_spacer(location& loc, context<TC>& ctx, const bool newline_found
     spacer.indent        = 0;
     spacer.comments.clear();
 
+    using comment_line = static_scanner::sequence<
+        static_scanner::comment, static_scanner::newline>;
+
     bool spacer_found = false;
     while( ! loc.eof())
     {
-        if(auto comm = sequence(syntax::comment(spec), syntax::newline(spec)).scan(loc))
+        if(auto comm = static_scanner::scan<comment_line>(loc, spec))
         {
             spacer.newline_found = true;
             auto comment = comm.as_string();
@@ -1858,12 +2053,12 @@ skip_multiline_spacer(location& loc, context<TC>& ctx, const bool newline_found
                 }
             }
 
-            spacer.comments.push_back(std::move(comment));
+            ctx.push_comment(spacer.comments, std::move(comment));
             spacer.indent_type = indent_char::none;
             spacer.indent = 0;
             spacer_found = true;
         }
-        else if(auto nl = syntax::newline(spec).scan(loc))
+        else if(auto nl = static_scanner::scan<static_scanner::newline>(loc, spec))
         {
             spacer.newline_found = true;
             spacer.comments.clear();
@@ -1871,13 +2066,13 @@ skip_multiline_spacer(location& loc, context<TC>& ctx, const bool newline_found
             spacer.indent = 0;
             spacer_found = true;
         }
-        else if(auto sp = repeat_at_least(1, character(cxx::bit_cast<location::char_type>(' '))).scan(loc))
+        else if(auto sp = static_scanner::scan<static_scanner::repeat_at_least<1, static_scanner::character<' '>>>(loc, spec))
         {
             spacer.indent_type = indent_char::space;
             spacer.indent      = static_cast<std::int32_t>(sp.length());
             spacer_found = true;
         }
-        else if(auto tabs = repeat_at_least(1, character(cxx::bit_cast<location::char_type>('\t'))).scan(loc))
+        else if(auto tabs = static_scanner::scan<static_scanner::repeat_at_least<1, static_scanner::character<'\t'>>>(loc, spec))
         {
             spacer.indent_type = indent_char::tab;
             spacer.indent      = static_cast<std::int32_t>(tabs.length());
@@ -1912,6 +2107,14 @@ parse_array(location& loc, context<TC>& ctx)
     }
     loc.advance();
 
+    // with an event_handler, the elements are reported while they are parsed
+    const bool reports_events = ctx.handler() != nullptr;
+    if(auto handler = reporting_handler(ctx))
+    {
+        handler->on_array_begin();
+    }
+    bool tables_only = true;
+
     typename basic_value<TC>::array_type val;
 
     array_format_info fmt;
@@ -1953,10 +2156,27 @@ parse_array(location& loc, context<TC>& ctx)
             fmt.body_indent = spacer.value().indent;
         }
 
+        if(reports_events && spacer.has_value())
+        {
+            if(auto handler = reporting_handler(ctx))
+            {
+                report_comments(*handler, spacer.value().comments);
+            }
+            spacer.value().comments.clear();
+        }
+
         if(auto elem_res = parse_value(loc, ctx))
         {
             auto elem = std::move(elem_res.unwrap());
 
+            if(reports_events && ! elem.is_array() && ! elem.is_table())
+            {
+                if(auto handler = reporting_handler(ctx))
+                {
+                    report_value(*handler, elem);
+                }
+            }
+
             if(spacer.has_value()) // copy previous comments to value
             {
                 elem.comments() = std::move(spacer.value().comments);
@@ -1972,10 +2192,7 @@ parse_array(location& loc, context<TC>& ctx)
             spacer = skip_multiline_spacer(loc, ctx);
             if(spacer.has_value())
             {
-                for(std::size_t i=0; i<spacer.value().comments.size(); ++i)
-                {
-                    elem.comments().push_back(std::move(spacer.value().comments.at(i)));
-                }
+                ctx.move_comments(elem.comments(), spacer.value().comments);
                 if(spacer.value().newline_found)
                 {
                     fmt.fmt = array_format::multiline;
@@ -1995,13 +2212,17 @@ parse_array(location& loc, context<TC>& ctx)
             if(com_res.is_err())
             {
                 ctx.report_error(com_res.unwrap_err());
+                if(ctx.should_stop())
+                {
+                    return err(ctx.pop_last_error());
+                }
             }
 
             const bool comment_found = com_res.is_ok() && com_res.unwrap().has_value();
             if(comment_found)
             {
                 fmt.fmt = array_format::multiline;
-                elem.comments().push_back(com_res.unwrap().value());
+                ctx.push_comment(elem.comments(), com_res.unwrap().value());
             }
             if(comma_found)
             {
@@ -2011,12 +2232,33 @@ parse_array(location& loc, context<TC>& ctx)
                     fmt.fmt = array_format::multiline;
                 }
             }
-            val.push_back(std::move(elem));
+
+            if(reports_events)
+            {
+                if(auto handler = reporting_handler(ctx))
+                {
+                    report_comments(*handler, elem.comments());
+                }
+                // an inline array of tables needs only one table as a placeholder
+                tables_only = tables_only && elem.is_table();
+                if(tables_only && val.empty())
+                {
+                    val.push_back(make_placeholder(elem));
+                }
+            }
+            else
+            {
+                val.push_back(std::move(elem));
+            }
         }
         else
         {
             // if err, push error to ctx and try recovery.
             ctx.report_error(std::move(elem_res.unwrap_err()));
+            if(ctx.should_stop())
+            {
+                return err(ctx.pop_last_error());
+            }
 
             // if it looks like some value, then skip the value.
             // otherwise, it may be a new key-value pair or a new table and
@@ -2048,6 +2290,18 @@ parse_array(location& loc, context<TC>& ctx)
         return err(ctx.errors().back());
     }
 
+    if(reports_events)
+    {
+        if(auto handler = reporting_handler(ctx))
+        {
+            handler->on_array_end();
+        }
+        if( ! tables_only)
+        {
+            val.clear();
+        }
+    }
+
     return ok(basic_value<TC>(
             std::move(val), std::move(fmt), {}, region(first, loc)
         ));
@@ -2151,6 +2405,15 @@ enum class inserting_value_kind : std::uint8_t
     dotted_keys  // insert a.b.c = "this"
 };
 
+// an array defined by [[array.of.tables]] has only tables. Checking its format
+// takes O(1) while is_array_of_tables() checks all the elements, that makes a
+// file with many [[array.of.tables]] take O(N^2).
+template<typename TC>
+bool is_defined_array_of_tables(const basic_value<TC>& v)
+{
+    return v.is_array() && v.as_array_fmt().fmt == array_format::array_of_tables;
+}
+
 template<typename TC>
 result<basic_value<TC>*, error_info>
 insert_value(const inserting_value_kind kind,
@@ -2233,7 +2496,8 @@ insert_value(const inserting_value_kind kind,
                 assert(found->second.is_table());
                 current_table_ptr = std::addressof(found->second.as_table());
             }
-            else if(found->second.is_array_of_tables())
+            else if(is_defined_array_of_tables(found->second) ||
+                    found->second.is_array_of_tables())
             {
                 // aot = [{this = "type", of = "aot"}] # cannot be reopened
                 if(found->second.as_array_fmt().fmt != array_format::array_of_tables)
@@ -2361,7 +2625,8 @@ insert_value(const inserting_value_kind kind,
                     }
                     else // the array is already defined, append to it
                     {
-                        if( ! found->second.is_array_of_tables())
+                        if( ! is_defined_array_of_tables(found->second) &&
+                            ! found->second.is_array_of_tables())
                         {
                             return err(make_error_info("toml::insert_value: "
                                 "failed to insert an array of tables, value already exists",
@@ -2390,11 +2655,123 @@ insert_value(const inserting_value_kind kind,
 
 // ----------------------------------------------------------------------------
 
+// tells if insert_value(dotted_keys, ...) succeeds without inserting the value
+template<typename TC>
+bool is_insertable_by_dotted_keys(const typename basic_value<TC>::table_type& table,
+        const std::vector<typename basic_value<TC>::key_type>& keys)
+{
+    const auto* current_table_ptr = std::addressof(table);
+    for(std::size_t i=0; i<keys.size(); ++i)
+    {
+        const auto found = current_table_ptr->find(keys.at(i));
+        if(found == current_table_ptr->end())
+        {
+            return true; // the rest of the keys will be defined
+        }
+        if(i+1 == keys.size())
+        {
+            return false; // value already exists
+        }
+        // only a dotted-key table can be extended by dotted keys
+        if( ! found->second.is_table() ||
+            found->second.as_table_fmt().fmt != table_format::dotted)
+        {
+            return false;
+        }
+        current_table_ptr = std::addressof(found->second.as_table());
+    }
+    return true;
+}
+
+// parses a key-value pair and inserts it to the table. `comments` are added to
+// the value. If the key is already defined, it reports the error to the
+// context and returns nullptr.
+//
+// With an event_handler, the key is checked before the value is parsed so that
+// an array or an inline table can report its elements while it is parsed.
+// Then `comments` are reported before the key and the tree has a placeholder.
+template<typename TC>
+result<basic_value<TC>*, error_info>
+parse_and_insert_key_value_pair(location& loc, context<TC>& ctx,
+        typename basic_value<TC>::table_type& table,
+        typename basic_value<TC>::comment_type& comments)
+{
+    const auto first = loc;
+    const auto& spec = ctx.toml_spec();
+
+    auto key_res = parse_key(loc, ctx);
+    if(key_res.is_err())
+    {
+        loc = first;
+        return err(key_res.unwrap_err());
+    }
+    const auto& keys    = key_res.unwrap().first;
+    const auto& key_reg = key_res.unwrap().second;
+
+    if( ! syntax::keyval_sep(spec).scan(loc).is_ok())
+    {
+        auto e = make_syntax_error("toml::parse_key_value_pair: "
+            "invalid key value separator `=`", syntax::keyval_sep(spec), loc);
+        loc = first;
+        return err(std::move(e));
+    }
+
+    const auto handler = ctx.handler();
+    const bool insertable = handler == nullptr ||
+                            is_insertable_by_dotted_keys<TC>(table, keys);
+    if(handler != nullptr)
+    {
+        if(insertable && ! ctx.has_error())
+        {
+            report_comments(*handler, comments);
+            handler->on_key(keys);
+        }
+        comments.clear();
+    }
+
+    // if the key is already defined, parse the value without events.
+    // insert_value reports the error after that, as parse does.
+    ctx.set_handler(insertable ? handler : nullptr);
+    auto v_res = parse_value(loc, ctx);
+    ctx.set_handler(handler);
+    if(v_res.is_err())
+    {
+        return err(v_res.unwrap_err());
+    }
+    auto& val = v_res.unwrap();
+
+    if(handler != nullptr)
+    {
+        if(insertable && ! val.is_array() && ! val.is_table() && ! ctx.has_error())
+        {
+            report_value(*handler, val);
+        }
+        val = make_placeholder(val);
+    }
+    else
+    {
+        ctx.move_comments(val.comments(), comments);
+    }
+
+    auto ins_res = insert_value(inserting_value_kind::dotted_keys,
+            std::addressof(table), keys, key_reg, std::move(val));
+    if(ins_res.is_err())
+    {
+        ctx.report_error(std::move(ins_res.unwrap_err()),
+                         parse_error_code::redefinition);
+        return ok(static_cast<basic_value<TC>*>(nullptr));
+    }
+    return ok(ins_res.unwrap());
+}
+
+// ----------------------------------------------------------------------------
+
 template<typename TC>
 result<basic_value<TC>, error_info>
 parse_inline_table(location& loc, context<TC>& ctx)
 {
-    using table_type = typename basic_value<TC>::table_type;
+    using table_type   = typename basic_value<TC>::table_type;
+    using comment_type = typename basic_value<TC>::comment_type;
 
     const auto num_errors = ctx.errors().size();
 
@@ -2409,6 +2786,14 @@ parse_inline_table(location& loc, context<TC>& ctx)
     }
     loc.advance();
 
+    // with an event_handler, the key-value pairs are reported while they are
+    // parsed. `table` only has placeholders to check the keys.
+    const bool reports_events = ctx.handler() != nullptr;
+    if(auto handler = reporting_handler(ctx))
+    {
+        handler->on_inline_table_begin();
+    }
+
     table_type table;
     table_format_info fmt;
     fmt.fmt = table_format::oneline;
@@ -2473,114 +2858,125 @@ parse_inline_table(location& loc, context<TC>& ctx)
         }
 
         still_empty = false; // parsing a value...
-        if(auto kv_res = parse_key_value_pair<TC>(loc, ctx))
-        {
-            auto keys    = std::move(kv_res.unwrap().first.first);
-            auto key_reg = std::move(kv_res.unwrap().first.second);
-            auto val     = std::move(kv_res.unwrap().second);
 
-            auto ins_res = insert_value(inserting_value_kind::dotted_keys,
-                std::addressof(table), keys, std::move(key_reg), std::move(val));
-            if(ins_res.is_err())
+        comment_type comments;
+        if(spacer.has_value()) // copy previous comments to value
+        {
+            ctx.move_comments(comments, spacer.value().comments);
+        }
+        auto kv_res = parse_and_insert_key_value_pair<TC>(loc, ctx, table, comments);
+        if(kv_res.is_err())
+        {
+            ctx.report_error(std::move(kv_res.unwrap_err()));
+            if(ctx.should_stop())
             {
-                ctx.report_error(std::move(ins_res.unwrap_err()));
-                // we need to skip until the next value (or end of the table)
-                // because we don't have valid kv pair.
-                while( ! loc.eof())
-                {
-                    const auto c = loc.current();
-                    if(c == ',' || c == '\n' || c == '}')
-                    {
-                        comma_found = (c == ',');
-                        break;
-                    }
-                    loc.advance();
-                }
-                continue;
+                return err(ctx.pop_last_error());
             }
-
-            // if comment line follows immediately(without newline) after `,`, then
-            // the comment is for the elem. we need to check if comment follows `,`.
-            //
-            // (key) = (val) (ws|newline|comment-line)? `,` (ws)? (comment)?
-
-            if(spec.v1_1_0_allow_newlines_in_inline_tables)
+            while( ! loc.eof())
             {
-                if(spacer.has_value()) // copy previous comments to value
+                if(loc.current() == '}')
                 {
-                    for(std::size_t i=0; i<spacer.value().comments.size(); ++i)
-                    {
-                        ins_res.unwrap()->comments().push_back(spacer.value().comments.at(i));
-                    }
+                    break;
                 }
-                spacer = skip_multiline_spacer(loc, ctx);
-                if(spacer.has_value())
+                if( ! spec.v1_1_0_allow_newlines_in_inline_tables && loc.current() == '\n')
                 {
-                    for(std::size_t i=0; i<spacer.value().comments.size(); ++i)
-                    {
-                        ins_res.unwrap()->comments().push_back(spacer.value().comments.at(i));
-                    }
-                    if(spacer.value().newline_found)
-                    {
-                        fmt.fmt = table_format::multiline_oneline;
-                        if(spacer.value().indent_type != indent_char::none)
-                        {
-                            fmt.indent_type = spacer.value().indent_type;
-                            fmt.body_indent = spacer.value().indent;
-                        }
-                    }
+                    break;
                 }
+                loc.advance();
             }
-            else
+            break;
+        }
+
+        const auto inserted = kv_res.unwrap();
+        if(inserted == nullptr) // the key is already defined
+        {
+            if(ctx.should_stop())
             {
-                skip_whitespace(loc, ctx);
+                return err(ctx.pop_last_error());
             }
-
-            comma_found = character(',').scan(loc).is_ok();
-
-            if(spec.v1_1_0_allow_newlines_in_inline_tables)
+            // we need to skip until the next value (or end of the table)
+            // because we don't have valid kv pair.
+            while( ! loc.eof())
             {
-                auto com_res = parse_comment_line(loc, ctx);
-                if(com_res.is_err())
+                const auto c = loc.current();
+                if(c == ',' || c == '\n' || c == '}')
                 {
-                    ctx.report_error(com_res.unwrap_err());
+                    comma_found = (c == ',');
+                    break;
                 }
-                const bool comment_found = com_res.is_ok() && com_res.unwrap().has_value();
-                if(comment_found)
+                loc.advance();
+            }
+            continue;
+        }
+
+        // if comment line follows immediately(without newline) after `,`, then
+        // the comment is for the elem. we need to check if comment follows `,`.
+        //
+        // (key) = (val) (ws|newline|comment-line)? `,` (ws)? (comment)?
+
+        if(spec.v1_1_0_allow_newlines_in_inline_tables)
+        {
+            spacer = skip_multiline_spacer(loc, ctx);
+            if(spacer.has_value())
+            {
+                ctx.move_comments(comments, spacer.value().comments);
+                if(spacer.value().newline_found)
                 {
                     fmt.fmt = table_format::multiline_oneline;
-                    ins_res.unwrap()->comments().push_back(com_res.unwrap().value());
-                }
-                if(comma_found)
-                {
-                    spacer = skip_multiline_spacer(loc, ctx, comment_found);
-                    if(spacer.has_value() && spacer.value().newline_found)
+                    if(spacer.value().indent_type != indent_char::none)
                     {
-                        fmt.fmt = table_format::multiline_oneline;
+                        fmt.indent_type = spacer.value().indent_type;
+                        fmt.body_indent = spacer.value().indent;
                     }
                 }
             }
-            else
-            {
-                skip_whitespace(loc, ctx);
-            }
         }
         else
         {
-            ctx.report_error(std::move(kv_res.unwrap_err()));
-            while( ! loc.eof())
+            skip_whitespace(loc, ctx);
+        }
+
+        comma_found = character(',').scan(loc).is_ok();
+
+        if(spec.v1_1_0_allow_newlines_in_inline_tables)
+        {
+            auto com_res = parse_comment_line(loc, ctx);
+            if(com_res.is_err())
             {
-                if(loc.current() == '}')
+                ctx.report_error(com_res.unwrap_err());
+                if(ctx.should_stop())
                 {
-                    break;
+                    return err(ctx.pop_last_error());
                 }
-                if( ! spec.v1_1_0_allow_newlines_in_inline_tables && loc.current() == '\n')
+            }
+            const bool comment_found = com_res.is_ok() && com_res.unwrap().has_value();
+            if(comment_found)
+            {
+                fmt.fmt = table_format::multiline_oneline;
+                ctx.push_comment(comments, com_res.unwrap().value());
+            }
+            if(comma_found)
+            {
+                spacer = skip_multiline_spacer(loc, ctx, comment_found);
+                if(spacer.has_value() && spacer.value().newline_found)
                 {
-                    break;
+                    fmt.fmt = table_format::multiline_oneline;
                 }
-                loc.advance();
             }
-            break;
+        }
+        else
+        {
+            skip_whitespace(loc, ctx);
+        }
+
+        // the comments after the value
+        if( ! reports_events)
+        {
+            ctx.move_comments(inserted->comments(), comments);
+        }
+        else if(auto handler = reporting_handler(ctx))
+        {
+            report_comments(*handler, comments);
         }
     }
 
@@ -2603,6 +2999,11 @@ parse_inline_table(location& loc, context<TC>& ctx)
         return err(ctx.pop_last_error());
     }
 
+    if(auto handler = reporting_handler(ctx))
+    {
+        handler->on_inline_table_end();
+    }
+
     basic_value<TC> retval(
         std::move(table), std::move(fmt), {}, region(first, loc));
 
@@ -2616,11 +3017,24 @@ parse_inline_table(location& loc, context<TC>& ctx)
  *   \_/\__,_|_|\_,_\___|
  */
 
+// `token` becomes the token found by the lexer, so that the parsers do not need
+// to scan it again. If the lexer does not accept it, its type is value_t::empty.
 template<typename TC>
 result<value_t, error_info>
-guess_number_type(const location& first, const context<TC>& ctx)
+guess_number_type(const location& first, const context<TC>& ctx,
+                  static_scanner::number_token& token)
 {
     const auto& spec = ctx.toml_spec();
+
+    // In most cases, the token is well-formed and the lexer can determine its
+    // type in one pass. If it fails, try the rules one by one to find out
+    // what is wrong.
+    token = static_scanner::lex_number(first, spec);
+    if(token.type != value_t::empty)
+    {
+        return ok(token.type);
+    }
+
     location loc = first;
 
     if(syntax::offset_datetime(spec).scan(loc).is_ok())
@@ -2694,7 +3108,7 @@ guess_number_type(const location& first, const context<TC>& ctx)
     }
     loc = first;
 
-    if(syntax::floating(spec).scan(loc).is_ok())
+    if(static_scanner::scan<static_scanner::floating>(loc, spec).is_ok())
     {
         if( ! loc.eof() && loc.current() == '_')
         {
@@ -2833,10 +3247,14 @@ guess_number_type(const location& first, const context<TC>& ctx)
                 std::move(src), "here"));
 }
 
+// `token` is a number or a datetime checked by the lexer. See guess_number_type.
 template<typename TC>
 result<value_t, error_info>
-guess_value_type(const location& loc, const context<TC>& ctx)
+guess_value_type(const location& loc, const context<TC>& ctx,
+                 static_scanner::number_token& token)
 {
+    token = static_scanner::number_token{value_t::empty, 0, 0, 0};
+
     const auto& sp = ctx.toml_spec();
     location inner(loc);
 
@@ -2943,16 +3361,25 @@ guess_value_type(const location& loc, const context<TC>& ctx)
         }
         default  :
         {
-            return guess_number_type(loc, ctx);
+            return guess_number_type(loc, ctx, token);
         }
     }
 }
 
+template<typename TC>
+result<value_t, error_info>
+guess_value_type(const location& loc, const context<TC>& ctx)
+{
+    static_scanner::number_token token;
+    return guess_value_type(loc, ctx, token);
+}
+
 template<typename TC>
 result<basic_value<TC>, error_info>
 parse_value(location& loc, context<TC>& ctx)
 {
-    const auto ty_res = guess_value_type(loc, ctx);
+    static_scanner::number_token token;
+    const auto ty_res = guess_value_type(loc, ctx, token);
     if(ty_res.is_err())
     {
         return err(ty_res.unwrap_err());
@@ -2973,16 +3400,16 @@ parse_value(location& loc, context<TC>& ctx)
                             std::move(src), "here"));
             }
         }
-        case value_t::boolean        : {return parse_boolean        (loc, ctx);}
-        case value_t::integer        : {return parse_integer        (loc, ctx);}
-        case value_t::floating       : {return parse_floating       (loc, ctx);}
-        case value_t::string         : {return parse_string         (loc, ctx);}
-        case value_t::offset_datetime: {return parse_offset_datetime(loc, ctx);}
-        case value_t::local_datetime : {return parse_local_datetime (loc, ctx);}
-        case value_t::local_date     : {return parse_local_date     (loc, ctx);}
-        case value_t::local_time     : {return parse_local_time     (loc, ctx);}
-        case value_t::array          : {return parse_array          (loc, ctx);}
-        case value_t::table          : {return parse_inline_table   (loc, ctx);}
+        case value_t::boolean        : {return parse_boolean             (loc, ctx);}
+        case value_t::integer        : {return parse_integer             (loc, ctx);}
+        case value_t::floating       : {return parse_floating_impl       (loc, ctx, token);}
+        case value_t::string         : {return parse_string              (loc, ctx);}
+        case value_t::offset_datetime: {return parse_offset_datetime_impl(loc, ctx, token);}
+        case value_t::local_datetime : {return parse_local_datetime_impl (loc, ctx, token);}
+        case value_t::local_date     : {return parse_local_date_impl     (loc, ctx, token);}
+        case value_t::local_time     : {return parse_local_time_impl     (loc, ctx, token);}
+        case value_t::array          : {return parse_array               (loc, ctx);}
+        case value_t::table          : {return parse_inline_table        (loc, ctx);}
         default:
         {
             auto src = source_location(region(loc));
@@ -2992,6 +3419,298 @@ parse_value(location& loc, context<TC>& ctx)
     }
 }
 
+/* ============================================================================
+ *  ___      _        _
+ * / __| ___| |___ __| |_
+ * \__ \/ -_) / -_) _|  _|
+ * |___/\___|_\___\__|\__|
+ */
+
+// If a key_filter is set to the context, the values that are not selected are
+// checked by the scanners and skipped without being converted. See
+// toml::select.
+
+template<typename TC>
+bool scan_value(location& loc, const context<TC>& ctx);
+
+// skips whitespace, newlines and comments in an array
+inline void scan_array_spacer(location& loc, const spec& s)
+{
+    namespace ss = static_scanner;
+    ss::match<ss::repeat_at_least<0, ss::either<ss::wschar, ss::newline, ss::comment>>>(loc, s);
+    return;
+}
+
+template<typename TC>
+bool scan_array(location& loc, const context<TC>& ctx)
+{
+    const auto& spec = ctx.toml_spec();
+
+    assert(loc.current() == '[');
+    loc.advance();
+
+    scan_array_spacer(loc, spec);
+    while( ! loc.eof())
+    {
+        if(loc.current() == ']')
+        {
+            loc.advance();
+            return true;
+        }
+        if( ! scan_value(loc, ctx))
+        {
+            return false;
+        }
+        scan_array_spacer(loc, spec);
+
+        if(loc.current() == ',')
+        {
+            loc.advance();
+            scan_array_spacer(loc, spec);
+        }
+        else if(loc.current() != ']')
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+template<typename TC>
+bool scan_inline_table(location& loc, const context<TC>& ctx)
+{
+    namespace ss = static_scanner;
+    const auto& spec = ctx.toml_spec();
+
+    const auto scan_spacer = [&spec](location& l) {
+        if(spec.v1_1_0_allow_newlines_in_inline_tables)
+        {
+            scan_array_spacer(l, spec);
+        }
+        else
+        {
+            ss::match<ss::ws>(l, spec);
+        }
+    };
+
+    assert(loc.current() == '{');
+    loc.advance();
+
+    scan_spacer(loc);
+    if(loc.current() == '}')
+    {
+        loc.advance();
+        return true;
+    }
+    while( ! loc.eof())
+    {
+        using keyval_sep = ss::sequence<ss::ws, ss::character<'='>, ss::ws>;
+        if( ! ss::match<ss::key>(loc, spec) || ! ss::match<keyval_sep>(loc, spec) ||
+            ! scan_value(loc, ctx))
+        {
+            return false;
+        }
+        scan_spacer(loc);
+
+        if(loc.current() == '}')
+        {
+            loc.advance();
+            return true;
+        }
+        if(loc.current() != ',')
+        {
+            return false;
+        }
+        loc.advance();
+        scan_spacer(loc);
+
+        if(loc.current() == '}')
+        {
+            if( ! spec.v1_1_0_allow_trailing_comma_in_inline_tables)
+            {
+                return false;
+            }
+            loc.advance();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Checks the syntax of a value and skips it. Integers and datetimes are not
+// range-checked because they are not converted. If it returns false, the
+// value should be parsed by parse_value to report the error.
+template<typename TC>
+bool scan_value(location& loc, const context<TC>& ctx)
+{
+    namespace ss = static_scanner;
+    const auto& spec = ctx.toml_spec();
+
+    const auto first = loc;
+    bool scanned = false;
+    switch(loc.current())
+    {
+        case '"':
+        {
+            scanned = ss::match<ss::either<ss::ml_basic_string, ss::basic_string>>(loc, spec);
+            break;
+        }
+        case '\'':
+        {
+            scanned = syntax::ml_literal_string(spec).scan(loc).is_ok() ||
+                      ss::match<ss::literal_string>(loc, spec);
+            break;
+        }
+        case '[': {return scan_array       (loc, ctx);}
+        case '{': {return scan_inline_table(loc, ctx);}
+        case 't': {scanned = ss::match<ss::literal<'t', 'r', 'u', 'e'>>     (loc, spec); break;}
+        case 'f': {scanned = ss::match<ss::literal<'f', 'a', 'l', 's', 'e'>>(loc, spec); break;}
+        default:
+        {
+            if(spec.ext_null_value && ss::match<ss::literal<'n', 'u', 'l', 'l'>>(loc, spec))
+            {
+                scanned = true;
+                break;
+            }
+            const auto token = ss::lex_number(loc, spec);
+            if(token.type == value_t::empty)
+            {
+                return false;
+            }
+            loc.advance(token.length);
+            return true;
+        }
+    }
+    if( ! scanned || ( ! loc.eof() && ! ss::lexer::is_delimiter(loc.current())))
+    {
+        loc = first;
+        return false;
+    }
+    return true;
+}
+
+// If the key-value pair is not selected, skips it after checking the syntax
+// and returns true. Otherwise, it does not move `loc`.
+template<typename TC>
+bool skip_unselected_key_value_pair(location& loc, context<TC>& ctx)
+{
+    namespace ss = static_scanner;
+    using keyval_sep = ss::sequence<ss::ws, ss::character<'='>, ss::ws>;
+
+    const auto filter = ctx.filter();
+    if(filter == nullptr || filter->is_selected(ctx.filter_node()))
+    {
+        return false;
+    }
+
+    const auto first = loc;
+    auto key_res = parse_key(loc, ctx);
+    if(key_res.is_ok() &&
+       filter->find(ctx.filter_node(), key_res.unwrap().first) == filter->npos() &&
+       ss::match<keyval_sep>(loc, ctx.toml_spec()) && scan_value(loc, ctx))
+    {
+        return true;
+    }
+    loc = first;
+    return false;
+}
+
+// Removes the keys that are not selected from a value at `node`. A table or
+// an array on the way to a selected key keeps only the selected keys in it.
+// An array drops the elements that cannot have the keys, like integers.
+// It returns false if nothing in the value can be selected.
+template<typename TC>
+bool keep_selected(basic_value<TC>& v, const key_filter<TC>& filter, const std::size_t node)
+{
+    if(node == filter.npos())
+    {
+        return false;
+    }
+    if(filter.is_selected(node))
+    {
+        return true;
+    }
+
+    if(v.is_table())
+    {
+        typename basic_value<TC>::table_type selected;
+        for(auto& kv : v.as_table())
+        {
+            if(keep_selected(kv.second, filter, filter.find(node, kv.first)))
+            {
+                selected.emplace(kv.first, std::move(kv.second));
+            }
+        }
+        v.as_table() = std::move(selected);
+        return true;
+    }
+    else if(v.is_array())
+    {
+        // `node` has children, so only tables and arrays can contain them.
+        // The tables are kept even if they become empty.
+        typename basic_value<TC>::array_type selected;
+        for(auto& elem : v.as_array())
+        {
+            if(keep_selected(elem, filter, node))
+            {
+                selected.push_back(std::move(elem));
+            }
+        }
+        v.as_array() = std::move(selected);
+        return ! v.as_array().empty();
+    }
+    return false;
+}
+
+// builds a key_filter from the paths, like `a.b`, `"a.b".c` or `a[*].b`.
+template<typename TC>
+result<key_filter<TC>, std::vector<error_info>>
+make_key_filter(const key_selection& sel, const spec& s)
+{
+    context<TC> ctx(s);
+    key_filter<TC> filter;
+    for(const auto& path : sel.paths())
+    {
+        location loc(make_source(std::vector<location::char_type>(path.begin(), path.end()),
+                     /*append_newline = */false), "toml::select");
+
+        std::vector<typename basic_value<TC>::key_type> keys;
+        while(true)
+        {
+            skip_whitespace(loc, ctx);
+            auto key = parse_simple_key(loc, ctx);
+            if(key.is_err())
+            {
+                ctx.report_error(std::move(key.unwrap_err()));
+                break;
+            }
+            keys.push_back(std::move(key.unwrap()));
+            skip_whitespace(loc, ctx);
+
+            literal("[*]").scan(loc); // a path goes through every element
+            skip_whitespace(loc, ctx);
+
+            if(loc.eof())
+            {
+                filter.add(keys);
+                break;
+            }
+            if(loc.current() != '.')
+            {
+                ctx.report_error(make_error_info("toml::select: invalid key path",
+                    source_location(region(loc)), "expected `.`, `[*]` or the end"));
+                break;
+            }
+            loc.advance();
+        }
+    }
+    if(ctx.has_error())
+    {
+        return err(ctx.errors());
+    }
+    return ok(std::move(filter));
+}
+
 /* ============================================================================
  *  _____     _    _
  * |_   _|_ _| |__| |___
@@ -3068,6 +3787,8 @@ template<typename TC>
 result<none_t, error_info>
 parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
 {
+    using comment_type = typename basic_value<TC>::comment_type;
+
     assert(table.is_table());
 
     const auto num_errors = ctx.errors().size();
@@ -3076,8 +3797,12 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
     // clear indent info
     table.as_table_fmt().indent_type = indent_char::none;
 
+    static thread_local auto next_table = syntax::make_cache([](const toml::spec& s) {
+        return sequence(syntax::ws(s), character('['));
+    });
+
     bool newline_found = true;
-    while( ! loc.eof())
+    while( ! loc.eof() && ! ctx.should_stop())
     {
         const auto start = loc;
 
@@ -3089,7 +3814,7 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
             break;
         }
         // if next table is comming, return.
-        if(sequence(syntax::ws(spec), character('[')).scan(loc).is_ok())
+        if(next_table.at(spec).scan(loc).is_ok())
         {
             loc = start;
             break;
@@ -3109,39 +3834,89 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
         }
 
         newline_found = false; // reset
-        if(auto kv_res = parse_key_value_pair(loc, ctx))
+        if(skip_unselected_key_value_pair(loc, ctx))
         {
-            auto keys    = std::move(kv_res.unwrap().first.first);
-            auto key_reg = std::move(kv_res.unwrap().first.second);
-            auto val     = std::move(kv_res.unwrap().second);
-
-            if(sp.has_value())
-            {
-                for(const auto& com : sp.value().comments)
-                {
-                    val.comments().push_back(com);
-                }
-            }
-
             if(auto com_res = parse_comment_line(loc, ctx))
             {
-                if(auto com_opt = com_res.unwrap())
-                {
-                    val.comments().push_back(com_opt.value());
-                    newline_found = true; // comment includes newline at the end
-                }
+                newline_found = com_res.unwrap().has_value();
             }
             else
             {
                 ctx.report_error(std::move(com_res.unwrap_err()));
             }
-
-            auto ins_res = insert_value(inserting_value_kind::dotted_keys,
-                    std::addressof(table.as_table()),
-                    keys, std::move(key_reg), std::move(val));
-            if(ins_res.is_err())
+            continue;
+        }
+        if(ctx.handler())
+        {
+            comment_type comments;
+            if(sp.has_value())
+            {
+                ctx.move_comments(comments, sp.value().comments);
+            }
+            auto kv_res = parse_and_insert_key_value_pair<TC>(
+                    loc, ctx, table.as_table(), comments);
+            if(kv_res.is_err())
+            {
+                ctx.report_error(std::move(kv_res.unwrap_err()));
+                skip_key_value_pair(loc, ctx);
+                continue;
+            }
+            if(auto com_res = parse_comment_line(loc, ctx))
             {
-                ctx.report_error(std::move(ins_res.unwrap_err()));
+                if(auto com_opt = com_res.unwrap())
+                {
+                    if(auto handler = reporting_handler(ctx))
+                    {
+                        handler->on_comment(com_opt.value());
+                    }
+                    newline_found = true; // comment includes newline at the end
+                }
+            }
+            else
+            {
+                ctx.report_error(std::move(com_res.unwrap_err()));
+            }
+            continue;
+        }
+        if(auto kv_res = parse_key_value_pair(loc, ctx))
+        {
+            auto keys    = std::move(kv_res.unwrap().first.first);
+            auto key_reg = std::move(kv_res.unwrap().first.second);
+            auto val     = std::move(kv_res.unwrap().second);
+
+            if(sp.has_value())
+            {
+                ctx.move_comments(val.comments(), sp.value().comments);
+            }
+
+            if(auto com_res = parse_comment_line(loc, ctx))
+            {
+                if(auto com_opt = com_res.unwrap())
+                {
+                    ctx.push_comment(val.comments(), com_opt.value());
+                    newline_found = true; // comment includes newline at the end
+                }
+            }
+            else
+            {
+                ctx.report_error(std::move(com_res.unwrap_err()));
+            }
+
+            if(const auto filter = ctx.filter())
+            {
+                if( ! keep_selected(val, *filter, filter->find(ctx.filter_node(), keys)))
+                {
+                    continue;
+                }
+            }
+
+            auto ins_res = insert_value(inserting_value_kind::dotted_keys,
+                    std::addressof(table.as_table()),
+                    keys, std::move(key_reg), std::move(val));
+            if(ins_res.is_err())
+            {
+                ctx.report_error(std::move(ins_res.unwrap_err()),
+                                 parse_error_code::redefinition);
             }
         }
         else
@@ -3159,9 +3934,9 @@ parse_table(location& loc, context<TC>& ctx, basic_value<TC>& table)
     return ok();
 }
 
+// parses the comments at the top of the file and the root table.
 template<typename TC>
-result<basic_value<TC>, std::vector<error_info>>
-parse_file(location& loc, context<TC>& ctx)
+basic_value<TC> parse_root_table(location& loc, context<TC>& ctx)
 {
     using value_type = basic_value<TC>;
     using table_type = typename value_type::table_type;
@@ -3169,15 +3944,14 @@ parse_file(location& loc, context<TC>& ctx)
     const auto first = loc;
     const auto& spec = ctx.toml_spec();
 
-    if(loc.eof())
-    {
-        return ok(value_type(table_type(), table_format_info{}, {}, region(loc)));
-    }
-
     value_type root(table_type(), table_format_info{}, {}, region(loc));
     root.as_table_fmt().fmt = table_format::multiline;
     root.as_table_fmt().indent_type = indent_char::none;
 
+    static thread_local auto empty_line = syntax::make_cache([](const toml::spec& s) {
+        return sequence(syntax::ws(s), syntax::newline(s));
+    });
+
     // parse top comment.
     //
     // ```toml
@@ -3196,12 +3970,12 @@ parse_file(location& loc, context<TC>& ctx)
         {
             if(auto com_opt = com_res.unwrap())
             {
-                root.comments().push_back(std::move(com_opt.value()));
+                ctx.push_comment(root.comments(), std::move(com_opt.value()));
             }
             else // no comment found.
             {
                 // if it is not an empty line, clear the root comment.
-                if( ! sequence(syntax::ws(spec), syntax::newline(spec)).scan(loc).is_ok())
+                if( ! empty_line.at(spec).scan(loc).is_ok())
                 {
                     loc = first;
                     root.comments().clear();
@@ -3212,10 +3986,23 @@ parse_file(location& loc, context<TC>& ctx)
         else
         {
             ctx.report_error(std::move(com_res.unwrap_err()));
+            if(ctx.should_stop())
+            {
+                return root;
+            }
             skip_comment_block(loc, ctx);
         }
     }
 
+    if(auto handler = ctx.handler())
+    {
+        if( ! ctx.has_error())
+        {
+            report_comments(*handler, root.comments());
+        }
+        root.comments().clear();
+    }
+
     // parse root table
     {
         const auto res = parse_table(loc, ctx, root);
@@ -3226,70 +4013,154 @@ parse_file(location& loc, context<TC>& ctx)
         }
     }
 
-    // parse tables
+    return root;
+}
 
-    while( ! loc.eof())
+// [table.keys] or [[array.of.tables]] with the comments and the indent
+template<typename TC>
+struct table_header
+{
+    inserting_value_kind kind;
+    std::vector<typename basic_value<TC>::key_type> keys;
+    region       reg;
+    typename basic_value<TC>::comment_type comments;
+    indent_char  indent_type;
+    std::int32_t indent;
+};
+
+// parses a table header and the comments around it. If it fails, it reports
+// the error, skips to the next table, and returns none.
+template<typename TC>
+cxx::optional<table_header<TC>> parse_table_header(location& loc, context<TC>& ctx)
+{
+    const auto& spec = ctx.toml_spec();
+
+    auto sp = skip_multiline_spacer(loc, ctx, /*newline_found=*/true);
+
+    table_header<TC> header;
+    if(auto key_res = parse_array_table_key(loc, ctx))
     {
-        auto sp = skip_multiline_spacer(loc, ctx, /*newline_found=*/true);
+        header.kind = inserting_value_kind::array_table;
+        header.keys = std::move(std::get<0>(key_res.unwrap()));
+        header.reg  = std::move(std::get<1>(key_res.unwrap()));
+    }
+    else if(auto key_res2 = parse_table_key(loc, ctx))
+    {
+        header.kind = inserting_value_kind::std_table;
+        header.keys = std::move(std::get<0>(key_res2.unwrap()));
+        header.reg  = std::move(std::get<1>(key_res2.unwrap()));
+    }
+    else
+    {
+        // does not match array_table nor std_table. report an error.
+        const auto keytop = loc;
+        const auto maybe_array_of_tables = literal("[[").scan(loc).is_ok();
+        loc = keytop;
 
-        if(auto key_res = parse_array_table_key(loc, ctx))
+        if(maybe_array_of_tables)
+        {
+            ctx.report_error(make_syntax_error("toml::parse_file: invalid array-table key",
+                syntax::array_table(spec), loc), parse_error_code::table_header);
+        }
+        else
         {
-            auto key = std::move(std::get<0>(key_res.unwrap()));
-            auto reg = std::move(std::get<1>(key_res.unwrap()));
+            ctx.report_error(make_syntax_error("toml::parse_file: invalid table key",
+                syntax::std_table(spec), loc), parse_error_code::table_header);
+        }
+        skip_until_next_table(loc, ctx);
+        return cxx::make_nullopt();
+    }
 
-            std::vector<std::string> com;
-            if(sp.has_value())
-            {
-                for(std::size_t i=0; i<sp.value().comments.size(); ++i)
-                {
-                    com.push_back(std::move(sp.value().comments.at(i)));
-                }
-            }
+    header.indent_type = indent_char::none;
+    header.indent      = 0;
+    if(sp.has_value())
+    {
+        ctx.move_comments(header.comments, sp.value().comments);
+        header.indent_type = sp.value().indent_type;
+        header.indent      = sp.value().indent;
+    }
 
-            // [table.def] must be followed by one of
-            // - a comment line
-            // - whitespace + newline
-            // - EOF
-            if(auto com_res = parse_comment_line(loc, ctx))
-            {
-                if(auto com_opt = com_res.unwrap())
-                {
-                    com.push_back(com_opt.value());
-                }
-                else // if there is no comment, ws+newline must exist (or EOF)
-                {
-                    skip_whitespace(loc, ctx);
-                    if( ! loc.eof() && ! syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
-                    {
-                        ctx.report_error(make_syntax_error("toml::parse_file: "
-                            "newline (or EOF) expected",
-                            syntax::newline(ctx.toml_spec()), loc));
-                        skip_until_next_table(loc, ctx);
-                        continue;
-                    }
-                }
-            }
-            else // comment syntax error (rare)
+    // [table.def] must be followed by one of
+    // - a comment line
+    // - whitespace + newline
+    // - EOF
+    if(auto com_res = parse_comment_line(loc, ctx))
+    {
+        if(auto com_opt = com_res.unwrap())
+        {
+            ctx.push_comment(header.comments, com_opt.value());
+        }
+        else // if there is no comment, ws+newline must exist (or EOF)
+        {
+            skip_whitespace(loc, ctx);
+            if( ! loc.eof() && ! syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
             {
-                ctx.report_error(com_res.unwrap_err());
+                ctx.report_error(make_syntax_error("toml::parse_file: "
+                    "newline (or EOF) expected",
+                    syntax::newline(ctx.toml_spec()), loc),
+                    parse_error_code::table_header);
                 skip_until_next_table(loc, ctx);
-                continue;
+                return cxx::make_nullopt();
             }
+        }
+    }
+    else // comment syntax error (rare)
+    {
+        ctx.report_error(com_res.unwrap_err());
+        skip_until_next_table(loc, ctx);
+        return cxx::make_nullopt();
+    }
+    return header;
+}
 
-            table_format_info fmt;
-            fmt.fmt = table_format::multiline;
-            fmt.indent_type = indent_char::none;
-            auto tab = value_type(table_type{}, std::move(fmt), std::move(com), reg);
+// an empty table that corresponds to the header
+template<typename TC>
+basic_value<TC> make_table_of_header(table_header<TC>& header)
+{
+    table_format_info fmt;
+    fmt.fmt = table_format::multiline;
+    fmt.indent_type = indent_char::none;
+    basic_value<TC> table(typename basic_value<TC>::table_type{}, std::move(fmt),
+                          std::vector<std::string>{}, header.reg);
+    table.comments() = std::move(header.comments);
+    return table;
+}
 
-            auto inserted = insert_value(inserting_value_kind::array_table,
-                std::addressof(root.as_table()),
-                key, std::move(reg), std::move(tab));
+// parse_table first clears `indent_type`. to keep header indent info, we
+// must store it later.
+template<typename TC>
+void set_header_indent(basic_value<TC>& table, const table_header<TC>& header)
+{
+    if(header.indent_type != indent_char::none)
+    {
+        table.as_table_fmt().indent_type = header.indent_type;
+        table.as_table_fmt().name_indent = header.indent;
+    }
+    return;
+}
 
-            if(inserted.is_err())
-            {
-                ctx.report_error(inserted.unwrap_err());
+// parses the tables that follow the root table and adds them to the root.
+template<typename TC>
+void parse_tables(location& loc, context<TC>& ctx, basic_value<TC>& root)
+{
+    using table_type = typename basic_value<TC>::table_type;
+
+    while( ! loc.eof() && ! ctx.should_stop())
+    {
+        auto header = parse_table_header(loc, ctx);
+        if( ! header.has_value())
+        {
+            continue;
+        }
+        auto& hdr = header.value();
 
-                // check errors in the table
+        if(const auto filter = ctx.filter())
+        {
+            const auto node = filter->find(filter->root(), hdr.keys);
+            ctx.set_filter_node(node);
+            if(node == filter->npos())
+            {
+                // check the syntax of the key-value pairs, but skip them
                 auto tmp = basic_value<TC>(table_type());
                 auto res = parse_table(loc, ctx, tmp);
                 if(res.is_err())
@@ -3299,127 +4170,145 @@ parse_file(location& loc, context<TC>& ctx)
                 }
                 continue;
             }
+        }
 
-            auto tab_ptr = inserted.unwrap();
-            assert(tab_ptr);
+        auto inserted = insert_value(hdr.kind, std::addressof(root.as_table()),
+                hdr.keys, hdr.reg, make_table_of_header(hdr));
 
-            const auto tab_res = parse_table(loc, ctx, *tab_ptr);
-            if(tab_res.is_err())
+        if(inserted.is_err())
+        {
+            ctx.report_error(inserted.unwrap_err(), parse_error_code::redefinition);
+            if(ctx.should_stop())
             {
-                ctx.report_error(tab_res.unwrap_err());
-                skip_until_next_table(loc, ctx);
+                break;
             }
 
-            // parse_table first clears `indent_type`.
-            // to keep header indent info, we must store it later.
-            if(sp.has_value() && sp.value().indent_type != indent_char::none)
+            // check errors in the table
+            auto tmp = basic_value<TC>(table_type());
+            auto res = parse_table(loc, ctx, tmp);
+            if(res.is_err())
             {
-                tab_ptr->as_table_fmt().indent_type = sp.value().indent_type;
-                tab_ptr->as_table_fmt().name_indent = sp.value().indent;
+                ctx.report_error(res.unwrap_err());
+                skip_until_next_table(loc, ctx);
             }
             continue;
         }
-        if(auto key_res = parse_table_key(loc, ctx))
-        {
-            auto key = std::move(std::get<0>(key_res.unwrap()));
-            auto reg = std::move(std::get<1>(key_res.unwrap()));
 
-            std::vector<std::string> com;
-            if(sp.has_value())
-            {
-                for(std::size_t i=0; i<sp.value().comments.size(); ++i)
-                {
-                    com.push_back(std::move(sp.value().comments.at(i)));
-                }
-            }
+        auto tab_ptr = inserted.unwrap();
+        assert(tab_ptr);
 
-            // [table.def] must be followed by one of
-            // - a comment line
-            // - whitespace + newline
-            // - EOF
-            if(auto com_res = parse_comment_line(loc, ctx))
-            {
-                if(auto com_opt = com_res.unwrap())
-                {
-                    com.push_back(com_opt.value());
-                }
-                else // if there is no comment, ws+newline must exist (or EOF)
-                {
-                    skip_whitespace(loc, ctx);
-                    if( ! loc.eof() && ! syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
-                    {
-                        ctx.report_error(make_syntax_error("toml::parse_file: "
-                            "newline (or EOF) expected",
-                            syntax::newline(ctx.toml_spec()), loc));
-                        skip_until_next_table(loc, ctx);
-                        continue;
-                    }
-                }
-            }
-            else // comment syntax error (rare)
-            {
-                ctx.report_error(com_res.unwrap_err());
-                skip_until_next_table(loc, ctx);
-                continue;
-            }
+        report_table_header(ctx, *tab_ptr, hdr.keys,
+                hdr.kind == inserting_value_kind::array_table);
 
-            table_format_info fmt;
-            fmt.fmt = table_format::multiline;
-            fmt.indent_type = indent_char::none;
-            auto tab = value_type(table_type{}, std::move(fmt), std::move(com), reg);
+        const auto tab_res = parse_table(loc, ctx, *tab_ptr);
+        if(tab_res.is_err())
+        {
+            ctx.report_error(tab_res.unwrap_err());
+            skip_until_next_table(loc, ctx);
+        }
+        set_header_indent(*tab_ptr, hdr);
+    }
+    return;
+}
 
-            auto inserted = insert_value(inserting_value_kind::std_table,
-                std::addressof(root.as_table()),
-                key, std::move(reg), std::move(tab));
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_file(location& loc, context<TC>& ctx)
+{
+    using value_type = basic_value<TC>;
+    using table_type = typename value_type::table_type;
 
-            if(inserted.is_err())
-            {
-                ctx.report_error(inserted.unwrap_err());
+    if(loc.eof())
+    {
+        return ok(value_type(table_type(), table_format_info{}, {}, region(loc)));
+    }
 
-                // check errors in the table
-                auto tmp = basic_value<TC>(table_type());
-                auto res = parse_table(loc, ctx, tmp);
-                if(res.is_err())
-                {
-                    ctx.report_error(res.unwrap_err());
-                    skip_until_next_table(loc, ctx);
-                }
-                continue;
-            }
+    auto root = parse_root_table(loc, ctx);
+    parse_tables(loc, ctx, root);
+
+    if( ! ctx.errors().empty())
+    {
+        return err(std::move(ctx.errors()));
+    }
+    return ok(std::move(root));
+}
 
-            auto tab_ptr = inserted.unwrap();
-            assert(tab_ptr);
+inline void skip_bom(location& loc)
+{
+    if(loc.source()->size() >= 3)
+    {
+        auto first = loc.get_location();
 
-            const auto tab_res = parse_table(loc, ctx, *tab_ptr);
-            if(tab_res.is_err())
-            {
-                ctx.report_error(tab_res.unwrap_err());
-                skip_until_next_table(loc, ctx);
-            }
-            if(sp.has_value() && sp.value().indent_type != indent_char::none)
-            {
-                tab_ptr->as_table_fmt().indent_type = sp.value().indent_type;
-                tab_ptr->as_table_fmt().name_indent = sp.value().indent;
-            }
-            continue;
+        const auto c0 = loc.current(); loc.advance();
+        const auto c1 = loc.current(); loc.advance();
+        const auto c2 = loc.current(); loc.advance();
+
+        const auto bom_found = (c0 == 0xEF) && (c1 == 0xBB) && (c2 == 0xBF);
+        if( ! bom_found)
+        {
+            loc.set_location(first);
         }
+    }
+    return;
+}
 
-        // does not match array_table nor std_table. report an error.
-        const auto keytop = loc;
-        const auto maybe_array_of_tables = literal("[[").scan(loc).is_ok();
-        loc = keytop;
+// a region stores the offsets in 31 bits. See region::max_source_size().
+// A larger file is split at top-level table headers, but a section can still
+// be too large.
+inline error_info make_section_size_error(const std::string& fname, const std::size_t size)
+{
+    return error_info("toml::parse: \"" + fname + "\" has too many bytes (" +
+        std::to_string(size) + " bytes) between top-level table headers. "
+        "The maximum size is " + std::to_string(region::max_source_size()) +
+        " bytes.", {});
+}
 
-        if(maybe_array_of_tables)
+// parses a file split into sections just before top-level table headers.
+// `next()` returns the next section, or nullptr at the end. The first section
+// is parsed as the top of the file, and the others are parsed as a sequence of
+// tables, so the result is the same as the one parsed at once.
+//
+// A section is released after it is parsed, unless the values refer to it
+// through their regions. The errors are reported section by section, and the
+// error recovery stops at the end of a section, just before a table header.
+template<typename TC, typename NextSection>
+result<basic_value<TC>, std::vector<error_info>>
+parse_sections_impl(NextSection next, const std::string& fname, context<TC>& ctx)
+{
+    using value_type = basic_value<TC>;
+    using table_type = typename value_type::table_type;
+
+    value_type root(table_type(), table_format_info{}, std::vector<std::string>{}, region{});
+    bool is_first = true;
+    while( ! ctx.should_stop())
+    {
+        auto sec = next();
+        if(sec.is_err())
         {
-            ctx.report_error(make_syntax_error("toml::parse_file: invalid array-table key",
-                syntax::array_table(spec), loc));
+            return err(std::vector<error_info>{std::move(sec.unwrap_err())});
         }
-        else
+        if( ! sec.unwrap())
         {
-            ctx.report_error(make_syntax_error("toml::parse_file: invalid table key",
-                syntax::std_table(spec), loc));
+            break;
         }
-        skip_until_next_table(loc, ctx);
+        if(sec.unwrap()->size() > region::max_source_size())
+        {
+            return err(std::vector<error_info>{
+                    make_section_size_error(fname, sec.unwrap()->size())});
+        }
+
+        location loc(std::move(sec.unwrap()), fname);
+        if(is_first)
+        {
+            is_first = false;
+            skip_bom(loc);
+            if(loc.eof())
+            {
+                return ok(value_type(table_type(), table_format_info{}, std::vector<std::string>{}, region(loc)));
+            }
+            root = parse_root_table(loc, ctx);
+        }
+        parse_tables(loc, ctx, root);
     }
 
     if( ! ctx.errors().empty())
@@ -3429,52 +4318,381 @@ parse_file(location& loc, context<TC>& ctx)
     return ok(std::move(root));
 }
 
+// a region stores the offsets in 31 bits, so a larger source is parsed in
+// sections. Each section refers to the bytes in the source.
 template<typename TC>
 result<basic_value<TC>, std::vector<error_info>>
-parse_impl(std::vector<location::char_type> cs, std::string fname, const spec& s)
+parse_large_impl(source_ptr src, std::string fname, context<TC>& ctx)
+{
+    auto sections = split_source(src, find_section_boundaries(*src,
+                ctx.toml_spec(), section_reader::default_section_size));
+    src.reset();
+
+    std::size_t i = 0;
+    return parse_sections_impl<TC>([&sections, &i]() -> result<source_ptr, error_info> {
+            if(i == sections.size())
+            {
+                return ok(source_ptr(nullptr));
+            }
+            return ok(std::move(sections.at(i++)));
+        }, fname, ctx);
+}
+
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_impl(source_ptr src, std::string fname, context<TC>& ctx)
 {
     using value_type = basic_value<TC>;
     using table_type = typename value_type::table_type;
 
+    if(src->size() > region::max_source_size())
+    {
+        return parse_large_impl<TC>(std::move(src), std::move(fname), ctx);
+    }
+
     // an empty file is a valid toml file.
-    if(cs.empty())
+    if(src->empty())
     {
-        auto src = std::make_shared<std::vector<location::char_type>>(std::move(cs));
         location loc(std::move(src), std::move(fname));
         return ok(value_type(table_type(), table_format_info{}, std::vector<std::string>{}, region(loc)));
     }
 
-    // to simplify parser, add newline at the end if there is no LF.
-    // But, if it has raw CR, the file is invalid (in TOML, CR is not a valid
-    // newline char). if it ends with CR, do not add LF and report it.
-    if(cs.back() != '\n' && cs.back() != '\r')
+    // to simplify parser, the source has a newline at the end even if the
+    // file does not. It is appended logically and the bytes are not modified.
+    // See source_buffer.
+    assert(src->appends_newline() || src->at(src->size() - 1) == '\n' ||
+                                     src->at(src->size() - 1) == '\r');
+
+    location loc(std::move(src), std::move(fname));
+
+    skip_bom(loc);
+
+    return parse_file(loc, ctx);
+}
+
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_impl(source_ptr src, std::string fname, const spec& s)
+{
+    context<TC> ctx(s);
+    return parse_impl<TC>(std::move(src), std::move(fname), ctx);
+}
+
+// builds only the selected keys. See toml::select.
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_impl(source_ptr src, std::string fname, const spec& s, const key_selection& sel)
+{
+    const auto filter = make_key_filter<TC>(sel, s);
+    if(filter.is_err())
     {
-        cs.push_back('\n');
+        return err(filter.unwrap_err());
     }
+    context<TC> ctx(s);
+    ctx.set_filter(std::addressof(filter.unwrap()));
+    return parse_impl<TC>(std::move(src), std::move(fname), ctx);
+}
 
-    auto src = std::make_shared<std::vector<location::char_type>>(std::move(cs));
+// builds the messages of a parse_failure
+template<typename TC>
+std::vector<error_info>
+reparse_errors(const source_ptr& src, const std::string& fname, const spec& s)
+{
+    auto res = parse_impl<TC>(src, fname, s);
+    if(res.is_ok())
+    {
+        return std::vector<error_info>{};
+    }
+    return std::move(res.unwrap_err());
+}
 
-    location loc(std::move(src), std::move(fname));
+// stops at the first error. See toml::fail_fast.
+template<typename TC>
+result<basic_value<TC>, parse_failure>
+parse_fail_fast_impl(source_ptr src, std::string fname, const spec& s)
+{
+    context<TC> ctx(s);
+    ctx.set_fail_fast(true);
+    auto res = parse_impl<TC>(src, fname, ctx);
+    if(res.is_ok())
+    {
+        return ok(std::move(res.unwrap()));
+    }
+    assert(ctx.should_stop());
+    const auto offset = error_offset(*src, ctx.failure_source(), ctx.failure_offset());
+    return err(parse_failure(ctx.failure_code(), offset, std::move(fname),
+                             std::move(src), s, &reparse_errors<TC>));
+}
 
-    // skip BOM if found
-    if(loc.source()->size() >= 3)
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_impl(std::vector<location::char_type> cs, std::string fname, const spec& s)
+{
+    return parse_impl<TC>(make_source(std::move(cs), /*append_newline = */true),
+                          std::move(fname), s);
+}
+
+// reports the values to the handler. The tree only has placeholders, so it is
+// discarded.
+template<typename TC>
+result<none_t, std::vector<error_info>>
+parse_events_impl(event_handler<TC>& handler, source_ptr src, std::string fname, const spec& s)
+{
+    context<TC> ctx(s);
+    ctx.set_handler(std::addressof(handler));
+
+    auto res = parse_impl<TC>(std::move(src), std::move(fname), ctx);
+    if(res.is_err())
     {
-        auto first = loc.get_location();
+        return err(std::move(res.unwrap_err()));
+    }
+    return ok();
+}
 
-        const auto c0 = loc.current(); loc.advance();
-        const auto c1 = loc.current(); loc.advance();
-        const auto c2 = loc.current(); loc.advance();
+// the source refers to the string without copying it
+inline source_ptr make_string_source(std::string content)
+{
+    const auto str = std::make_shared<const std::string>(std::move(content));
+    return std::make_shared<const source_buffer>(
+        reinterpret_cast<const unsigned char*>(str->data()), str->size(),
+        /*append_newline = */true, str);
+}
 
-        const auto bom_found = (c0 == 0xEF) && (c1 == 0xBB) && (c2 == 0xBF);
-        if( ! bom_found)
+// parses a file read by section_reader. See parse_sections_impl.
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_stream_impl(section_reader& reader, std::string fname, const spec& s)
+{
+    const auto read_error = [&fname](const std::string& msg) {
+        return error_info("toml::parse_stream: Failed to read: \"" + fname +
+                          "\", " + msg, {});
+    };
+
+    context<TC> ctx(s);
+    return parse_sections_impl<TC>([&reader, &read_error]() -> result<source_ptr, error_info> {
+            auto sec = reader.next();
+            if(sec.is_err())
+            {
+                return err(read_error(sec.unwrap_err()));
+            }
+            return ok(std::move(sec.unwrap()));
+        }, fname, ctx);
+}
+
+// a table parsed apart from the root, and its header to add it to the root
+template<typename TC>
+struct detached_table
+{
+    table_header<TC> header;
+    basic_value<TC>  table;
+};
+
+// parses the tables that follow the root table without adding them to the
+// root. Adding them later in the same order makes the same root as
+// parse_tables, unless it fails.
+template<typename TC>
+void parse_detached_tables(location& loc, context<TC>& ctx,
+                           std::vector<detached_table<TC>>& tables)
+{
+    while( ! loc.eof())
+    {
+        auto header = parse_table_header(loc, ctx);
+        if( ! header.has_value())
         {
-            loc.set_location(first);
+            continue;
+        }
+
+        detached_table<TC> t;
+        t.header = std::move(header.value());
+        t.table  = make_table_of_header(t.header);
+
+        const auto tab_res = parse_table(loc, ctx, t.table);
+        if(tab_res.is_err())
+        {
+            ctx.report_error(tab_res.unwrap_err());
+            skip_until_next_table(loc, ctx);
         }
+        set_header_indent(t.table, t.header);
+
+        tables.push_back(std::move(t));
     }
+    return;
+}
 
-    context<TC> ctx(s);
+// splits a file into sections at top-level table headers and parses them in
+// parallel. Then the tables are added to the root in the order of the file by
+// insert_value, as parse_tables does.
+//
+// A table is parsed before it is added to the root, not after. If the result
+// differs from parse_tables, insert_value fails; a key in a table body
+// conflicts with a table that is already defined. So, if anything fails, it
+// parses the whole file again by a single thread to report the same errors.
+template<typename TC>
+result<basic_value<TC>, std::vector<error_info>>
+parse_parallel_impl(source_ptr src, std::string fname, const spec& s,
+                    std::size_t num_threads, std::size_t min_section_size = 0)
+{
+    if(num_threads == 0)
+    {
+        num_threads = default_num_threads();
+    }
+    const auto size = src->size() - (src->appends_newline() ? 1 : 0);
+    if(min_section_size == 0)
+    {
+        // a few sections per thread to balance the load
+        min_section_size = (std::max)(std::size_t(64 * 1024), size / (num_threads * 4));
+    }
 
-    return parse_file(loc, ctx);
+    const auto boundaries = find_section_boundaries(*src, s, min_section_size);
+    if(num_threads == 1 || boundaries.empty())
+    {
+        return parse_impl<TC>(std::move(src), std::move(fname), s);
+    }
+
+    auto sections = split_source(src, boundaries);
+
+    // a region stores the offsets in 31 bits. parse_impl reports it.
+    if(std::any_of(sections.begin(), sections.end(), [](const source_ptr& sec) {
+            return sec->size() > region::max_source_size();
+        }))
+    {
+        sections.clear();
+        return parse_impl<TC>(std::move(src), std::move(fname), s);
+    }
+
+    basic_value<TC> root;
+    std::vector<std::vector<detached_table<TC>>> tables(sections.size());
+    std::vector<char> failed(sections.size(), 0);
+
+    parallel_for(sections.size(), num_threads, [&](const std::size_t i) {
+        location loc(sections.at(i), fname);
+        context<TC> ctx(s);
+        if(i == 0)
+        {
+            skip_bom(loc);
+            root = parse_root_table(loc, ctx);
+        }
+        parse_detached_tables(loc, ctx, tables.at(i));
+        failed.at(i) = ctx.has_error() ? 1 : 0;
+    });
+
+    bool has_error = std::find(failed.begin(), failed.end(), 1) != failed.end();
+    for(std::size_t i=0; i<tables.size() && ! has_error; ++i)
+    {
+        for(auto& t : tables.at(i))
+        {
+            const auto fmt = t.table.as_table_fmt();
+            auto inserted = insert_value(t.header.kind, std::addressof(root.as_table()),
+                    t.header.keys, t.header.reg, std::move(t.table));
+            if(inserted.is_err())
+            {
+                has_error = true;
+                break;
+            }
+            // if it reopens an implicitly defined table, the format is not
+            // copied by insert_value.
+            inserted.unwrap()->as_table_fmt() = fmt;
+        }
+        tables.at(i).clear();
+    }
+
+    if(has_error)
+    {
+        root = basic_value<TC>{};
+        tables.clear();
+        sections.clear();
+        return parse_impl<TC>(std::move(src), std::move(fname), s);
+    }
+    return ok(std::move(root));
+}
+
+// a file parsed by parse_many_impl. If it fails to read the file, `io_error`
+// has the message and `parsed` is empty.
+template<typename TC>
+struct parsed_file
+{
+    std::string io_error;
+    cxx::optional<result<basic_value<TC>, std::vector<error_info>>> parsed;
+};
+
+// parses the files on `num_threads` threads. It is a parallel_for over
+// parse_impl. A thread takes the next file when it finishes one, so the
+// grammar cached for the spec in the thread is built once per thread, not once
+// per file. Nothing else is shared. Each file is read into its own buffer
+// because the regions in the values keep the source alive.
+template<typename TC>
+std::vector<parsed_file<TC>>
+parse_many_impl(const std::vector<std::string>& fnames, const spec& s,
+                const std::size_t num_threads)
+{
+    using result_type = result<basic_value<TC>, std::vector<error_info>>;
+
+    std::vector<parsed_file<TC>> files(fnames.size());
+    parallel_for(fnames.size(), num_threads, [&](const std::size_t i) {
+        // small files are cheaper to read than to map, and reading does not
+        // keep a mapping for each file while the values are alive.
+        auto src = read_source_file(fnames.at(i), /*append_newline = */true);
+        if(src.is_err())
+        {
+            files.at(i).io_error = std::move(src.unwrap_err());
+            return;
+        }
+        files.at(i).parsed = cxx::optional<result_type>(
+                parse_impl<TC>(std::move(src.unwrap()), fnames.at(i), s));
+    });
+    return files;
+}
+
+inline std::string path_to_string(const std::string& fname) {return fname;}
+inline std::string path_to_string(const char* fname) {return std::string(fname);}
+#if defined(TOML11_HAS_FILESYSTEM)
+inline std::string path_to_string(const std::filesystem::path& fpath) {return fpath.string();}
+#endif
+
+template<typename Paths>
+std::vector<std::string> paths_to_strings(const Paths& fpaths)
+{
+    std::vector<std::string> fnames;
+    for(const auto& fpath : fpaths)
+    {
+        fnames.push_back(path_to_string(fpath));
+    }
+    return fnames;
+}
+
+// throws file_io_error if it fails to read, or syntax_error if it fails to parse
+template<typename TC>
+basic_value<TC> parse_stream_impl(section_reader::read_function read,
+                                  std::string fname, const spec& s)
+{
+    std::string read_error;
+    section_reader reader([&read_error, &read](section_reader::char_type* buf, const std::size_t len) {
+            auto res = read(buf, len);
+            if(res.is_err())
+            {
+                read_error = res.unwrap_err();
+            }
+            return res;
+        }, s);
+
+    auto res = parse_stream_impl<TC>(reader, fname, s);
+    if( ! read_error.empty())
+    {
+        throw file_io_error("toml::parse_stream: Failed to read; " + read_error, fname);
+    }
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
 }
 
 } // detail
@@ -3510,6 +4728,88 @@ parse(std::vector<unsigned char> content, std::string filename,
     }
 }
 
+// -----------------------------------------------------------------------------
+// parse(byte span)
+//
+// It does not copy the bytes. The caller must keep [first, first+len) alive
+// while the returned value (or its source_location) is used.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse(const unsigned char* first, const std::size_t len, std::string filename,
+          spec s = spec::default_version())
+{
+    return detail::parse_impl<TC>(detail::make_source(first, len, /*append_newline = */true),
+                                  std::move(filename), std::move(s));
+}
+template<typename TC = type_config>
+basic_value<TC>
+parse(const unsigned char* first, const std::size_t len, std::string filename,
+      spec s = spec::default_version())
+{
+    auto res = try_parse<TC>(first, len, std::move(filename), std::move(s));
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// parse_mmap(filename)
+//
+// It maps the file read-only and parses it without copying. The mapping is
+// kept while any value parsed from it is alive, and `location()` and error
+// messages read it. The file must not be modified or truncated during that
+// time; reading the lost pages raises SIGBUS on POSIX. If the platform does
+// not support memory mapped files, it reads the file.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_mmap(std::string fname, spec s = spec::default_version())
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        std::vector<error_info> e;
+        e.push_back(error_info("toml::parse_mmap: " + src.unwrap_err(), {}));
+        return err(std::move(e));
+    }
+    return detail::parse_impl<TC>(std::move(src.unwrap()), std::move(fname), std::move(s));
+}
+
+template<typename TC = type_config>
+basic_value<TC> parse_mmap(std::string fname, spec s = spec::default_version())
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        throw file_io_error("toml::parse_mmap: " + src.unwrap_err(), fname);
+    }
+    auto res = detail::parse_impl<TC>(std::move(src.unwrap()), std::move(fname), std::move(s));
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+}
+
 // -----------------------------------------------------------------------------
 // parse(istream)
 
@@ -3518,6 +4818,11 @@ result<basic_value<TC>, std::vector<error_info>>
 try_parse(std::istream& is, std::string fname = "unknown file", spec s = spec::default_version())
 {
     const auto beg = is.tellg();
+    if(beg == std::istream::pos_type(-1)) // not seekable, e.g. std::cin
+    {
+        detail::section_reader reader(detail::make_read_function(is), s);
+        return detail::parse_stream_impl<TC>(reader, std::move(fname), s);
+    }
     is.seekg(0, std::ios::end);
     const auto end = is.tellg();
     const auto fsize = end - beg;
@@ -3595,6 +4900,71 @@ basic_value<TC> parse(const char (&fname)[N], spec s = spec::default_version())
     return parse<TC>(std::string(fname), std::move(s));
 }
 
+// -----------------------------------------------------------------------------
+// parse(filename, spec, select(paths))
+//
+// It builds only the values at the selected key paths and the tables that
+// contain them. The other values are checked, but not converted. If a path is
+// invalid, it fails with the error in the path. See toml::select.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse(std::string fname, spec s, const key_selection& sel)
+{
+    auto src = detail::read_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        std::vector<error_info> e;
+        e.push_back(error_info("toml::parse: " + src.unwrap_err(), {}));
+        return err(std::move(e));
+    }
+    return detail::parse_impl<TC>(std::move(src.unwrap()), std::move(fname), s, sel);
+}
+
+template<typename TC = type_config>
+basic_value<TC> parse(std::string fname, spec s, const key_selection& sel)
+{
+    auto src = detail::read_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        throw file_io_error("toml::parse: " + src.unwrap_err(), fname);
+    }
+    auto res = detail::parse_impl<TC>(std::move(src.unwrap()), std::move(fname), s, sel);
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// try_parse(filename, spec, fail_fast)
+//
+// It stops at the first error without recovering from it, and returns only the
+// kind and the byte offset of the error. The error messages are built when
+// `parse_failure::errors()` is called. It is useful to reject many invalid
+// files quickly.
+
+template<typename TC = type_config>
+result<basic_value<TC>, parse_failure>
+try_parse(std::string fname, spec s, fail_fast_t)
+{
+    auto src = detail::read_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        return err(parse_failure(std::move(fname), std::move(src.unwrap_err())));
+    }
+    return detail::parse_fail_fast_impl<TC>(std::move(src.unwrap()), std::move(fname), s);
+}
+
 // ----------------------------------------------------------------------------
 // parse_str
 
@@ -3603,9 +4973,9 @@ result<basic_value<TC>, std::vector<error_info>>
 try_parse_str(std::string content, spec s = spec::default_version(),
               cxx::source_location loc = cxx::source_location::current())
 {
-    std::istringstream iss(std::move(content));
     std::string name("internal string" + cxx::to_string(loc));
-    return try_parse<TC>(iss, std::move(name), std::move(s));
+    return detail::parse_impl<TC>(detail::make_string_source(std::move(content)),
+                                  std::move(name), std::move(s));
 }
 
 template<typename TC = type_config>
@@ -3628,6 +4998,46 @@ basic_value<TC> parse_str(std::string content, spec s = spec::default_version(),
     }
 }
 
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_str(std::string content, spec s, const key_selection& sel,
+              cxx::source_location loc = cxx::source_location::current())
+{
+    std::string name("internal string" + cxx::to_string(loc));
+    return detail::parse_impl<TC>(detail::make_string_source(std::move(content)),
+                                  std::move(name), s, sel);
+}
+
+template<typename TC = type_config>
+basic_value<TC> parse_str(std::string content, spec s, const key_selection& sel,
+        cxx::source_location loc = cxx::source_location::current())
+{
+    auto res = try_parse_str<TC>(std::move(content), std::move(s), sel, std::move(loc));
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+}
+
+template<typename TC = type_config>
+result<basic_value<TC>, parse_failure>
+try_parse_str(std::string content, spec s, fail_fast_t,
+              cxx::source_location loc = cxx::source_location::current())
+{
+    std::string name("internal string" + cxx::to_string(loc));
+    return detail::parse_fail_fast_impl<TC>(detail::make_string_source(std::move(content)),
+                                            std::move(name), s);
+}
+
 // ----------------------------------------------------------------------------
 // filesystem
 
@@ -3664,6 +5074,30 @@ parse(const FSPATH& fpath, spec s = spec::default_version())
 
     return parse<TC>(ifs, fpath.string(), std::move(s));
 }
+
+template<typename TC = type_config, typename FSPATH>
+cxx::enable_if_t<std::is_same<FSPATH, std::filesystem::path>::value,
+    result<basic_value<TC>, std::vector<error_info>>>
+try_parse(const FSPATH& fpath, spec s, const key_selection& sel)
+{
+    return try_parse<TC>(fpath.string(), std::move(s), sel);
+}
+
+template<typename TC = type_config, typename FSPATH>
+cxx::enable_if_t<std::is_same<FSPATH, std::filesystem::path>::value,
+    basic_value<TC>>
+parse(const FSPATH& fpath, spec s, const key_selection& sel)
+{
+    return parse<TC>(fpath.string(), std::move(s), sel);
+}
+
+template<typename TC = type_config, typename FSPATH>
+cxx::enable_if_t<std::is_same<FSPATH, std::filesystem::path>::value,
+    result<basic_value<TC>, parse_failure>>
+try_parse(const FSPATH& fpath, spec s, fail_fast_t ff)
+{
+    return try_parse<TC>(fpath.string(), std::move(s), ff);
+}
 #endif
 
 // -----------------------------------------------------------------------------
@@ -3673,22 +5107,13 @@ template<typename TC = type_config>
 result<basic_value<TC>, std::vector<error_info>>
 try_parse(FILE* fp, std::string filename, spec s = spec::default_version())
 {
+    // if it is not seekable (e.g. a pipe), read it section by section
     const long beg = std::ftell(fp);
-    if (beg == -1L)
-    {
-        return err(std::vector<error_info>{error_info(
-            std::string("Failed to access: \"") + filename +
-            "\", errno = " + std::to_string(errno), {}
-        )});
-    }
-
-    const int res_seekend = std::fseek(fp, 0, SEEK_END);
+    const int res_seekend = (beg == -1L) ? -1 : std::fseek(fp, 0, SEEK_END);
     if (res_seekend != 0)
     {
-        return err(std::vector<error_info>{error_info(
-            std::string("Failed to seek: \"") + filename +
-            "\", errno = " + std::to_string(errno), {}
-        )});
+        detail::section_reader reader(detail::make_read_function(fp), s);
+        return detail::parse_stream_impl<TC>(reader, std::move(filename), s);
     }
 
     const long end = std::ftell(fp);
@@ -3732,16 +5157,13 @@ template<typename TC = type_config>
 basic_value<TC>
 parse(FILE* fp, std::string filename, spec s = spec::default_version())
 {
+    // if it is not seekable (e.g. a pipe), read it section by section
     const long beg = std::ftell(fp);
-    if (beg == -1L)
-    {
-        throw file_io_error(errno, "Failed to access", filename);
-    }
-
-    const int res_seekend = std::fseek(fp, 0, SEEK_END);
+    const int res_seekend = (beg == -1L) ? -1 : std::fseek(fp, 0, SEEK_END);
     if (res_seekend != 0)
     {
-        throw file_io_error(errno, "Failed to seek", filename);
+        return detail::parse_stream_impl<TC>(detail::make_read_function(fp),
+                                             std::move(filename), s);
     }
 
     const long end = std::ftell(fp);
@@ -3784,6 +5206,277 @@ parse(FILE* fp, std::string filename, spec s = spec::default_version())
     }
 }
 
+// -----------------------------------------------------------------------------
+// parse_stream
+//
+// It reads the input incrementally and does not need to seek, so it can parse
+// pipes, sockets, and std::cin. The input is split into sections at top-level
+// table headers and only the current section is buffered while reading.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_stream(std::istream& is, std::string fname = "unknown stream",
+                 spec s = spec::default_version())
+{
+    detail::section_reader reader(detail::make_read_function(is), s);
+    return detail::parse_stream_impl<TC>(reader, std::move(fname), s);
+}
+template<typename TC = type_config>
+basic_value<TC>
+parse_stream(std::istream& is, std::string fname = "unknown stream",
+             spec s = spec::default_version())
+{
+    return detail::parse_stream_impl<TC>(detail::make_read_function(is), std::move(fname), s);
+}
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_stream(FILE* fp, std::string filename, spec s = spec::default_version())
+{
+    detail::section_reader reader(detail::make_read_function(fp), s);
+    return detail::parse_stream_impl<TC>(reader, std::move(filename), s);
+}
+template<typename TC = type_config>
+basic_value<TC>
+parse_stream(FILE* fp, std::string filename, spec s = spec::default_version())
+{
+    return detail::parse_stream_impl<TC>(detail::make_read_function(fp), std::move(filename), s);
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_stream(const int fd, std::string filename, spec s = spec::default_version())
+{
+    detail::section_reader reader(detail::make_read_function(fd), s);
+    return detail::parse_stream_impl<TC>(reader, std::move(filename), s);
+}
+template<typename TC = type_config>
+basic_value<TC>
+parse_stream(const int fd, std::string filename, spec s = spec::default_version())
+{
+    return detail::parse_stream_impl<TC>(detail::make_read_function(fd), std::move(filename), s);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// parse_parallel
+//
+// It maps the file, splits it into sections at top-level table headers, and
+// parses the sections on `num_threads` threads (0 means the number of hardware
+// threads). The result is the same as parse. If the file has an error, it is
+// parsed again by a single thread to report the same errors.
+
+template<typename TC = type_config>
+result<basic_value<TC>, std::vector<error_info>>
+try_parse_parallel(std::string fname, spec s = spec::default_version(),
+                   const std::size_t num_threads = 0)
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        std::vector<error_info> e;
+        e.push_back(error_info("toml::parse_parallel: " + src.unwrap_err(), {}));
+        return err(std::move(e));
+    }
+    return detail::parse_parallel_impl<TC>(std::move(src.unwrap()),
+            std::move(fname), s, num_threads);
+}
+
+template<typename TC = type_config>
+basic_value<TC> parse_parallel(std::string fname, spec s = spec::default_version(),
+                               const std::size_t num_threads = 0)
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        throw file_io_error("toml::parse_parallel: " + src.unwrap_err(), fname);
+    }
+    auto res = detail::parse_parallel_impl<TC>(std::move(src.unwrap()),
+            std::move(fname), s, num_threads);
+    if(res.is_ok())
+    {
+        return res.unwrap();
+    }
+    else
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// parse_many
+//
+// It parses the files in a range (e.g. std::vector<std::string>) on
+// `num_threads` threads (0 means the number of hardware threads). The results
+// are in the same order as the files.
+
+template<typename TC = type_config, typename Paths>
+std::vector<result<basic_value<TC>, std::vector<error_info>>>
+try_parse_many(const Paths& fpaths, spec s = spec::default_version(),
+               const std::size_t num_threads = 0)
+{
+    auto files = detail::parse_many_impl<TC>(
+            detail::paths_to_strings(fpaths), s, num_threads);
+
+    std::vector<result<basic_value<TC>, std::vector<error_info>>> results;
+    results.reserve(files.size());
+    for(auto& file : files)
+    {
+        if( ! file.parsed.has_value())
+        {
+            std::vector<error_info> e;
+            e.push_back(error_info("toml::parse_many: " + file.io_error, {}));
+            results.push_back(err(std::move(e)));
+        }
+        else
+        {
+            results.push_back(std::move(file.parsed.value()));
+        }
+    }
+    return results;
+}
+
+// throws file_io_error or syntax_error of the first file that fails
+template<typename TC = type_config, typename Paths>
+std::vector<basic_value<TC>>
+parse_many(const Paths& fpaths, spec s = spec::default_version(),
+           const std::size_t num_threads = 0)
+{
+    const auto fnames = detail::paths_to_strings(fpaths);
+    auto files = detail::parse_many_impl<TC>(fnames, s, num_threads);
+
+    std::vector<basic_value<TC>> values;
+    values.reserve(files.size());
+    for(std::size_t i=0; i<files.size(); ++i)
+    {
+        auto& file = files.at(i);
+        if( ! file.parsed.has_value())
+        {
+            throw file_io_error("toml::parse_many: " + file.io_error, fnames.at(i));
+        }
+        auto& res = file.parsed.value();
+        if(res.is_err())
+        {
+            std::string msg;
+            for(const auto& err : res.unwrap_err())
+            {
+                msg += format_error(err);
+            }
+            throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+        }
+        values.push_back(std::move(res.unwrap()));
+    }
+    return values;
+}
+
+// -----------------------------------------------------------------------------
+// parse_events
+//
+// It reports the keys, the values, and the comments to an event_handler in the
+// order of the file instead of constructing a tree. The file is checked in the
+// same way as parse, and the same errors are returned. The events before the
+// first error have already been reported when it returns.
+
+template<typename TC>
+result<detail::none_t, std::vector<error_info>>
+try_parse_events(event_handler<TC>& handler, std::string fname,
+                 spec s = spec::default_version())
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        std::vector<error_info> e;
+        e.push_back(error_info("toml::parse_events: " + src.unwrap_err(), {}));
+        return err(std::move(e));
+    }
+    return detail::parse_events_impl(handler, std::move(src.unwrap()), std::move(fname), s);
+}
+
+template<typename TC>
+result<detail::none_t, std::vector<error_info>>
+try_parse_events(event_handler<TC>& handler, std::istream& is,
+                 std::string fname = "unknown file", spec s = spec::default_version())
+{
+    std::string content((std::istreambuf_iterator<char>(is)),
+                        std::istreambuf_iterator<char>());
+    return detail::parse_events_impl(handler,
+            detail::make_string_source(std::move(content)), std::move(fname), s);
+}
+
+template<typename TC>
+result<detail::none_t, std::vector<error_info>>
+try_parse_events_str(event_handler<TC>& handler, std::string content,
+        spec s = spec::default_version(),
+        cxx::source_location loc = cxx::source_location::current())
+{
+    std::string name("internal string" + cxx::to_string(loc));
+    return detail::parse_events_impl(handler,
+            detail::make_string_source(std::move(content)), std::move(name), s);
+}
+
+template<typename TC>
+void parse_events(event_handler<TC>& handler, std::string fname,
+                  spec s = spec::default_version())
+{
+    auto src = detail::map_source_file(fname, /*append_newline = */true);
+    if(src.is_err())
+    {
+        throw file_io_error("toml::parse_events: " + src.unwrap_err(), fname);
+    }
+    auto res = detail::parse_events_impl(handler, std::move(src.unwrap()), std::move(fname), s);
+    if(res.is_err())
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+    return;
+}
+
+template<typename TC>
+void parse_events(event_handler<TC>& handler, std::istream& is,
+                  std::string fname = "unknown file", spec s = spec::default_version())
+{
+    auto res = try_parse_events(handler, is, std::move(fname), std::move(s));
+    if(res.is_err())
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+    return;
+}
+
+template<typename TC>
+void parse_events_str(event_handler<TC>& handler, std::string content,
+        spec s = spec::default_version(),
+        cxx::source_location loc = cxx::source_location::current())
+{
+    auto res = try_parse_events_str(handler, std::move(content), std::move(s), std::move(loc));
+    if(res.is_err())
+    {
+        std::string msg;
+        for(const auto& err : res.unwrap_err())
+        {
+            msg += format_error(err);
+        }
+        throw syntax_error(std::move(msg), std::move(res.unwrap_err()));
+    }
+    return;
+}
+
 } // namespace toml
 
 #if defined(TOML11_COMPILE_SOURCES)
@@ -3796,25 +5489,81 @@ extern template result<basic_value<type_config>, std::vector<error_info>> try_pa
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::istream&, std::string, spec);
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::string, spec);
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(FILE*, std::string, spec);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(const unsigned char*, const std::size_t, std::string, spec);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_mmap<type_config>(std::string, spec);
 extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_str<type_config>(std::string, spec, cxx::source_location);
 
 extern template basic_value<type_config> parse<type_config>(std::vector<unsigned char>, std::string, spec);
 extern template basic_value<type_config> parse<type_config>(std::istream&, std::string, spec);
 extern template basic_value<type_config> parse<type_config>(std::string, spec);
 extern template basic_value<type_config> parse<type_config>(FILE*, std::string, spec);
+extern template basic_value<type_config> parse<type_config>(const unsigned char*, const std::size_t, std::string, spec);
+extern template basic_value<type_config> parse_mmap<type_config>(std::string, spec);
 extern template basic_value<type_config> parse_str<type_config>(std::string, spec, cxx::source_location);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::string, spec, const key_selection&);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_str<type_config>(std::string, spec, const key_selection&, cxx::source_location);
+extern template basic_value<type_config> parse<type_config>(std::string, spec, const key_selection&);
+extern template basic_value<type_config> parse_str<type_config>(std::string, spec, const key_selection&, cxx::source_location);
+extern template result<basic_value<type_config>, parse_failure> try_parse<type_config>(std::string, spec, fail_fast_t);
+extern template result<basic_value<type_config>, parse_failure> try_parse_str<type_config>(std::string, spec, fail_fast_t, cxx::source_location);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_parallel<type_config>(std::string, spec, const std::size_t);
+extern template basic_value<type_config> parse_parallel<type_config>(std::string, spec, const std::size_t);
+extern template std::vector<result<basic_value<type_config>, std::vector<error_info>>> try_parse_many<type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+extern template std::vector<basic_value<type_config>> parse_many<type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events<type_config>(event_handler<type_config>&, std::string, spec);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events<type_config>(event_handler<type_config>&, std::istream&, std::string, spec);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events_str<type_config>(event_handler<type_config>&, std::string, spec, cxx::source_location);
+extern template void parse_events<type_config>(event_handler<type_config>&, std::string, spec);
+extern template void parse_events<type_config>(event_handler<type_config>&, std::istream&, std::string, spec);
+extern template void parse_events_str<type_config>(event_handler<type_config>&, std::string, spec, cxx::source_location);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(std::istream&, std::string, spec);
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(FILE*, std::string, spec);
+extern template basic_value<type_config> parse_stream<type_config>(std::istream&, std::string, spec);
+extern template basic_value<type_config> parse_stream<type_config>(FILE*, std::string, spec);
+#if defined(TOML11_HAS_POSIX_FD)
+extern template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(const int, std::string, spec);
+extern template basic_value<type_config> parse_stream<type_config>(const int, std::string, spec);
+#endif
 
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::istream&, std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(FILE*, std::string, spec);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(const unsigned char*, const std::size_t, std::string, spec);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_mmap<ordered_type_config>(std::string, spec);
 extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
 
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::istream&, std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::string, spec);
 extern template basic_value<ordered_type_config> parse<ordered_type_config>(FILE*, std::string, spec);
+extern template basic_value<ordered_type_config> parse<ordered_type_config>(const unsigned char*, const std::size_t, std::string, spec);
+extern template basic_value<ordered_type_config> parse_mmap<ordered_type_config>(std::string, spec);
 extern template basic_value<ordered_type_config> parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::string, spec, const key_selection&);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_str<ordered_type_config>(std::string, spec, const key_selection&, cxx::source_location);
+extern template basic_value<ordered_type_config> parse<ordered_type_config>(std::string, spec, const key_selection&);
+extern template basic_value<ordered_type_config> parse_str<ordered_type_config>(std::string, spec, const key_selection&, cxx::source_location);
+extern template result<basic_value<ordered_type_config>, parse_failure> try_parse<ordered_type_config>(std::string, spec, fail_fast_t);
+extern template result<basic_value<ordered_type_config>, parse_failure> try_parse_str<ordered_type_config>(std::string, spec, fail_fast_t, cxx::source_location);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_parallel<ordered_type_config>(std::string, spec, const std::size_t);
+extern template basic_value<ordered_type_config> parse_parallel<ordered_type_config>(std::string, spec, const std::size_t);
+extern template std::vector<result<basic_value<ordered_type_config>, std::vector<error_info>>> try_parse_many<ordered_type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+extern template std::vector<basic_value<ordered_type_config>> parse_many<ordered_type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::istream&, std::string, spec);
+extern template result<detail::none_t, std::vector<error_info>> try_parse_events_str<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec, cxx::source_location);
+extern template void parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec);
+extern template void parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::istream&, std::string, spec);
+extern template void parse_events_str<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec, cxx::source_location);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(std::istream&, std::string, spec);
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(FILE*, std::string, spec);
+extern template basic_value<ordered_type_config> parse_stream<ordered_type_config>(std::istream&, std::string, spec);
+extern template basic_value<ordered_type_config> parse_stream<ordered_type_config>(FILE*, std::string, spec);
+#if defined(TOML11_HAS_POSIX_FD)
+extern template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(const int, std::string, spec);
+extern template basic_value<ordered_type_config> parse_stream<ordered_type_config>(const int, std::string, spec);
+#endif
 
 #if defined(TOML11_HAS_FILESYSTEM)
 extern template cxx::enable_if_t<std::is_same<std::filesystem::path, std::filesystem::path>::value, result<basic_value<type_config>,         std::vector<error_info>>> try_parse<type_config,         std::filesystem::path>(const std::filesystem::path&, spec);
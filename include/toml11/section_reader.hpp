@@ -0,0 +1,10 @@
+#ifndef TOML11_SECTION_READER_HPP
+#define TOML11_SECTION_READER_HPP
+
+#include "fwd/section_reader_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/section_reader_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_SECTION_READER_HPP
@@ -0,0 +1,141 @@
+#ifndef TOML11_SELECT_HPP
+#define TOML11_SELECT_HPP
+
+#include "traits.hpp"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace toml
+{
+
+// The key paths to build. See toml::select.
+class key_selection
+{
+  public:
+
+    explicit key_selection(std::vector<std::string> paths)
+        : paths_(std::move(paths))
+    {}
+
+    std::vector<std::string> const& paths() const noexcept {return paths_;}
+
+  private:
+
+    std::vector<std::string> paths_;
+};
+
+// `toml::parse(fname, spec, toml::select({"server.port", "routes[*].name"}))`
+// builds only the values at the paths and the tables that contain them. The
+// other values are checked, but not converted.
+//
+// A path is a dotted key. A path goes through every element of an array, so
+// `routes[*].name` and `routes.name` are the same.
+inline key_selection select(std::vector<std::string> paths)
+{
+    return key_selection(std::move(paths));
+}
+
+namespace detail
+{
+
+// A tree of the selected keys. A node is identified by its index, and the
+// root is 0. If a node is selected, everything under it is selected.
+template<typename TypeConfig>
+class key_filter
+{
+  public:
+
+    using key_type = typename config_key_type<TypeConfig>::type;
+
+  public:
+
+    key_filter(): nodes_(1, node{key_type{}, 0, false}) {}
+
+    static constexpr std::size_t root() noexcept {return 0;}
+
+    // not selected
+    static constexpr std::size_t npos() noexcept
+    {
+        return (std::numeric_limits<std::size_t>::max)();
+    }
+
+    void add(const std::vector<key_type>& keys)
+    {
+        std::size_t n = root();
+        for(const auto& k : keys)
+        {
+            if(this->nodes_.at(n).selected)
+            {
+                return;
+            }
+            const auto c = this->child(n, k);
+            if(c != npos())
+            {
+                n = c;
+            }
+            else
+            {
+                this->nodes_.push_back(node{k, n, false});
+                n = this->nodes_.size() - 1;
+            }
+        }
+        this->nodes_.at(n).selected = true;
+        return;
+    }
+
+    bool is_selected(const std::size_t n) const noexcept
+    {
+        return n != npos() && this->nodes_[n].selected;
+    }
+
+    // the node of `k` under `n`. If it is not selected, returns npos.
+    std::size_t find(const std::size_t n, const key_type& k) const
+    {
+        if(n == npos() || this->nodes_.at(n).selected)
+        {
+            return n;
+        }
+        return this->child(n, k);
+    }
+    std::size_t find(std::size_t n, const std::vector<key_type>& keys) const
+    {
+        for(const auto& k : keys)
+        {
+            n = this->find(n, k);
+        }
+        return n;
+    }
+
+  private:
+
+    std::size_t child(const std::size_t n, const key_type& k) const
+    {
+        // only a few keys are selected in practice
+        for(std::size_t i=n+1; i<this->nodes_.size(); ++i)
+        {
+            if(this->nodes_[i].parent == n && this->nodes_[i].key == k)
+            {
+                return i;
+            }
+        }
+        return npos();
+    }
+
+  private:
+
+    struct node
+    {
+        key_type    key;
+        std::size_t parent;
+        bool        selected;
+    };
+    std::vector<node> nodes_;
+};
+
+} // detail
+} // toml
+#endif // TOML11_SELECT_HPP
@@ -686,7 +686,7 @@ class serializer
             }
             else if(fmt.fmt == table_format::dotted)
             {
-                std::vector<string_type> keys;
+                std::vector<key_type> keys;
                 if(this->keys_.empty())
                 {
                     throw serialization_error(format_error("toml::serializer: "
@@ -1020,7 +1020,7 @@ class serializer
     } // }}}
 
     string_type format_dotted_table(const table_type& t, const table_format_info& fmt, // {{{
-            const source_location&, std::vector<string_type>& keys)
+            const source_location&, std::vector<key_type>& keys)
     {
         // lets say we have: `{"a": {"b": {"c": {"d": "foo", "e": "bar"} } }`
         // and `a` and `b` are `dotted`.
@@ -1155,7 +1155,9 @@ class serializer
     {
         return string_conv<string_type>("");
     } // }}}
-    string_type format_comments(const preserve_comments& comments, const indent_char indent_type) const // {{{
+    // preserve_comments or pooled_comments
+    template<typename Comments>
+    string_type format_comments(const Comments& comments, const indent_char indent_type) const // {{{
     {
         string_type retval;
         for(const auto& c : comments)
@@ -1163,7 +1165,7 @@ class serializer
             if(c.empty()) {continue;}
             retval += format_indent(indent_type);
             if(c.front() != '#') {retval += char_type('#');}
-            retval += string_conv<string_type>(c);
+            retval.append(c.begin(), c.end()); // c may not be a std::string
             if(c.back() != '\n') {retval += char_type('\n');}
         }
         return retval;
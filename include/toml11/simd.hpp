@@ -0,0 +1,292 @@
+#ifndef TOML11_SIMD_HPP
+#define TOML11_SIMD_HPP
+
+#include "version.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(TOML11_HAS_SSE2)
+#  include <emmintrin.h>
+#endif
+#if defined(TOML11_HAS_AVX2)
+#  include <immintrin.h>
+#endif
+#if defined(_MSC_VER) && ! defined(__clang__)
+#  include <intrin.h>
+#endif
+
+namespace toml
+{
+namespace detail
+{
+namespace simd
+{
+
+// ===========================================================================
+// Byte-search kernels.
+//
+// Each of them finds the first byte in [first, last) that satisfies a
+// predicate. If the target supports AVX2 or SSE2, it checks 32 or 16 bytes at
+// once and falls back to a scalar loop for the remaining bytes.
+// Define TOML11_DISABLE_SIMD to always use the scalar loop.
+//
+// Since those kernels only look at each byte independently, multibyte UTF-8
+// characters are always reported (their bytes are >= 0x80) and the caller
+// validates them.
+
+using char_type = unsigned char;
+using iterator  = const char_type*;
+
+inline std::size_t countr_zero(const std::uint32_t x) noexcept
+{
+    // x != 0
+#if defined(_MSC_VER) && ! defined(__clang__)
+    unsigned long idx = 0;
+    _BitScanForward(&idx, x);
+    return static_cast<std::size_t>(idx);
+#else
+    return static_cast<std::size_t>(__builtin_ctz(x));
+#endif
+}
+
+template<typename Pred>
+iterator find_first(iterator first, const iterator last) noexcept
+{
+#if defined(TOML11_HAS_AVX2)
+    while(last - first >= 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(Pred::avx2(v)));
+        if(mask != 0)
+        {
+            return first + countr_zero(mask);
+        }
+        first += 32;
+    }
+#endif
+#if defined(TOML11_HAS_SSE2)
+    while(last - first >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(Pred::sse2(v)));
+        if(mask != 0)
+        {
+            return first + countr_zero(mask);
+        }
+        first += 16;
+    }
+#endif
+    while(first != last && ! Pred::scalar(*first))
+    {
+        ++first;
+    }
+    return first;
+}
+
+// ---------------------------------------------------------------------------
+// predicates
+//
+// `sse2` and `avx2` return 0xFF for the bytes that satisfy the predicate.
+// Note that `cmplt/cmpgt` compare bytes as signed integers. So bytes >= 0x80
+// are less than any ASCII character.
+
+// neither a space nor a tab
+struct not_whitespace
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return c != ' ' && c != '\t';
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        const __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                        _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        return _mm_andnot_si128(ws, _mm_set1_epi8(-1));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        const __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                           _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+        return _mm256_andnot_si256(ws, _mm256_set1_epi8(-1));
+    }
+#endif
+};
+
+// v1.0.0: a comment consists of 0x09, 0x20-0x7E and non-ASCII characters.
+// It matches the others (newline, control characters, DEL) and non-ASCII.
+struct not_comment_char
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return (c < 0x20 && c != 0x09) || 0x7F <= c;
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        const __m128i ctrl = _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(0x09)),
+                                              _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));
+        return _mm_or_si128(ctrl, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        const __m256i ctrl = _mm256_andnot_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x09)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v));
+        return _mm256_or_si256(ctrl, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F)));
+    }
+#endif
+};
+
+// v1.1.0: a comment consists of 0x01-0x09, 0x0E-0x7F and non-ASCII characters.
+// It matches the others (NUL, newline, 0x0B-0x0D) and non-ASCII.
+struct not_comment_char_v1_1
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return c == 0x00 || (0x0A <= c && c <= 0x0D) || 0x80 <= c;
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        const __m128i allowed = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x00)),
+                                              _mm_cmplt_epi8(v, _mm_set1_epi8(0x0A)));
+        return _mm_andnot_si128(allowed, _mm_cmplt_epi8(v, _mm_set1_epi8(0x0E)));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        const __m256i allowed = _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x00)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(0x0A), v));
+        return _mm256_andnot_si256(allowed,
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(0x0E), v));
+    }
+#endif
+};
+
+// a basic string consists of 0x09, 0x20-0x7E and non-ASCII characters, except
+// for `"` and backslash. It matches `"`, backslash, control characters, DEL
+// and non-ASCII.
+struct basic_string_special
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return c == '"' || c == '\\' || (c < 0x20 && c != 0x09) || 0x7F <= c;
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        const __m128i quote = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                           _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+        return _mm_or_si128(quote, not_comment_char::sse2(v));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        const __m256i quote = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        return _mm256_or_si256(quote, not_comment_char::avx2(v));
+    }
+#endif
+};
+
+// a literal string consists of 0x09, 0x20-0x7E and non-ASCII characters,
+// except for `'`. It matches `'`, control characters, DEL and non-ASCII.
+struct literal_string_special
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return c == '\'' || (c < 0x20 && c != 0x09) || 0x7F <= c;
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\'')),
+                            not_comment_char::sse2(v));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')),
+                               not_comment_char::avx2(v));
+    }
+#endif
+};
+
+// a line feed
+struct newline
+{
+    static bool scalar(const char_type c) noexcept
+    {
+        return c == '\n';
+    }
+#if defined(TOML11_HAS_SSE2)
+    static __m128i sse2(const __m128i v) noexcept
+    {
+        return _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    }
+#endif
+#if defined(TOML11_HAS_AVX2)
+    static __m256i avx2(const __m256i v) noexcept
+    {
+        return _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+    }
+#endif
+};
+
+// ---------------------------------------------------------------------------
+// kernels
+
+inline iterator skip_whitespace(const iterator first, const iterator last) noexcept
+{
+    // most of the whitespaces are short. check the first byte before loading
+    // a vector.
+    if(first == last || not_whitespace::scalar(*first))
+    {
+        return first;
+    }
+    return find_first<not_whitespace>(first + 1, last);
+}
+
+inline iterator find_non_comment_char(const iterator first, const iterator last,
+                                      const bool allow_control_characters) noexcept
+{
+    if(allow_control_characters)
+    {
+        return find_first<not_comment_char_v1_1>(first, last);
+    }
+    else
+    {
+        return find_first<not_comment_char>(first, last);
+    }
+}
+
+inline iterator find_basic_string_special(const iterator first, const iterator last) noexcept
+{
+    return find_first<basic_string_special>(first, last);
+}
+
+inline iterator find_literal_string_special(const iterator first, const iterator last) noexcept
+{
+    return find_first<literal_string_special>(first, last);
+}
+
+inline iterator find_newline(const iterator first, const iterator last) noexcept
+{
+    return find_first<newline>(first, last);
+}
+
+} // simd
+} // detail
+} // toml
+#endif // TOML11_SIMD_HPP
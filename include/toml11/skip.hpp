@@ -4,10 +4,13 @@
 #include "context.hpp"
 #include "region.hpp"
 #include "scanner.hpp"
+#include "simd.hpp"
+#include "static_scanner.hpp"
 #include "syntax.hpp"
 #include "types.hpp"
 
 #include <cassert>
+#include <cstring>
 
 namespace toml
 {
@@ -15,18 +18,20 @@ namespace detail
 {
 
 template<typename TC>
-bool skip_whitespace(location& loc, const context<TC>& ctx)
+bool skip_whitespace(location& loc, const context<TC>&)
 {
-    return syntax::ws(ctx.toml_spec()).scan(loc).is_ok();
+    const auto first = static_scanner::current_of(loc);
+    const auto last  = static_scanner::end_of(loc);
+    loc.advance(static_cast<std::size_t>(simd::skip_whitespace(first, last) - first));
+    return true;
 }
 
 template<typename TC>
 bool skip_empty_lines(location& loc, const context<TC>& ctx)
 {
-    return repeat_at_least(1, sequence(
-            syntax::ws(ctx.toml_spec()),
-            syntax::newline(ctx.toml_spec())
-        )).scan(loc).is_ok();
+    namespace ss = static_scanner;
+    using empty_lines = ss::repeat_at_least<1, ss::sequence<ss::ws, ss::newline>>;
+    return ss::scan<empty_lines>(loc, ctx.toml_spec()).is_ok();
 }
 
 // For error recovery.
@@ -41,14 +46,18 @@ void skip_comment_block(location& loc, const context<TC>& ctx)
         skip_whitespace(loc, ctx);
         if(loc.current() == '#')
         {
-            while( ! loc.eof())
+            // both CRLF and LF ends with LF.
+            const auto first = static_scanner::current_of(loc);
+            const auto last  = static_scanner::end_of(loc);
+            const auto lf = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+            if(lf == nullptr)
             {
-                // both CRLF and LF ends with LF.
-                if(loc.current() == '\n')
-                {
-                    loc.advance();
-                    break;
-                }
+                loc.advance(static_cast<std::size_t>(last - first));
+            }
+            else
+            {
+                loc.advance(static_cast<std::size_t>(
+                    static_cast<const location::char_type*>(lf) - first) + 1);
             }
         }
         else if(syntax::newline(ctx.toml_spec()).scan(loc).is_ok())
@@ -67,12 +76,10 @@ void skip_comment_block(location& loc, const context<TC>& ctx)
 template<typename TC>
 void skip_empty_or_comment_lines(location& loc, const context<TC>& ctx)
 {
-    const auto& spec = ctx.toml_spec();
-    repeat_at_least(0, sequence(
-            syntax::ws(spec),
-            maybe(syntax::comment(spec)),
-            syntax::newline(spec))
-        ).scan(loc);
+    namespace ss = static_scanner;
+    using empty_or_comment_lines = ss::repeat_at_least<0,
+        ss::sequence<ss::ws, ss::maybe<ss::comment>, ss::newline>>;
+    ss::scan<empty_or_comment_lines>(loc, ctx.toml_spec());
     return ;
 }
 
@@ -307,6 +314,10 @@ void skip_value(location& loc, const context<TC>& ctx)
 template<typename TC>
 void skip_key_value_pair(location& loc, const context<TC>& ctx)
 {
+    if(ctx.should_stop()) // fail-fast. the parser does not recover.
+    {
+        return;
+    }
     while( ! loc.eof())
     {
         if(loc.current() == '=')
@@ -328,6 +339,10 @@ void skip_key_value_pair(location& loc, const context<TC>& ctx)
 template<typename TC>
 void skip_until_next_table(location& loc, const context<TC>& ctx)
 {
+    if(ctx.should_stop()) // fail-fast. the parser does not recover.
+    {
+        return;
+    }
     const auto& spec = ctx.toml_spec();
     while( ! loc.eof())
     {
@@ -0,0 +1,10 @@
+#ifndef TOML11_SOURCE_BUFFER_HPP
+#define TOML11_SOURCE_BUFFER_HPP
+
+#include "fwd/source_buffer_fwd.hpp" // IWYU pragma: export
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#include "impl/source_buffer_impl.hpp" // IWYU pragma: export
+#endif
+
+#endif // TOML11_SOURCE_BUFFER_HPP
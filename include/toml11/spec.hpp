@@ -117,5 +117,24 @@ struct spec
     bool ext_null_value; // allow `null` as a value
 };
 
+constexpr inline bool operator==(const spec& lhs, const spec& rhs) noexcept
+{
+    return lhs.version == rhs.version &&
+        lhs.v1_1_0_allow_control_characters_in_comments  == rhs.v1_1_0_allow_control_characters_in_comments &&
+        lhs.v1_1_0_allow_newlines_in_inline_tables       == rhs.v1_1_0_allow_newlines_in_inline_tables &&
+        lhs.v1_1_0_allow_trailing_comma_in_inline_tables == rhs.v1_1_0_allow_trailing_comma_in_inline_tables &&
+        lhs.v1_1_0_allow_non_english_in_bare_keys        == rhs.v1_1_0_allow_non_english_in_bare_keys &&
+        lhs.v1_1_0_add_escape_sequence_e                 == rhs.v1_1_0_add_escape_sequence_e &&
+        lhs.v1_1_0_add_escape_sequence_x                 == rhs.v1_1_0_add_escape_sequence_x &&
+        lhs.v1_1_0_make_seconds_optional                 == rhs.v1_1_0_make_seconds_optional &&
+        lhs.ext_hex_float                                == rhs.ext_hex_float &&
+        lhs.ext_num_suffix                               == rhs.ext_num_suffix &&
+        lhs.ext_null_value                               == rhs.ext_null_value;
+}
+constexpr inline bool operator!=(const spec& lhs, const spec& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
 } // namespace toml
 #endif // TOML11_SPEC_HPP
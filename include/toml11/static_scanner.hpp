@@ -0,0 +1,1035 @@
+#ifndef TOML11_STATIC_SCANNER_HPP
+#define TOML11_STATIC_SCANNER_HPP
+
+#include "location.hpp"
+#include "region.hpp"
+#include "simd.hpp"
+#include "spec.hpp"
+#include "value_t.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace toml
+{
+namespace detail
+{
+namespace static_scanner
+{
+
+// ===========================================================================
+// Statically composed scanners.
+//
+// `scanner_base` and its subclasses (scanner.hpp) form a tree of objects that
+// are dispatched through virtual functions. They know how to describe what
+// they expect, so they are used to build error messages. But the dispatch and
+// the `region` constructed at each node make them slow in the hot path.
+//
+// The scanners here are empty types composed by templates. Each of them has
+//
+//     static bool match(iterator& iter, const iterator last, const spec& s);
+//
+// that advances `iter` past the matched bytes and returns true, or returns
+// false without changing `iter`. Since everything is known at compile time,
+// the compiler can inline the whole grammar into a loop over raw bytes.
+// A `region` is constructed only once by `scan()`, at the top level.
+//
+// Grammar rules that depend on `spec` are written as a dedicated struct that
+// checks the flags at runtime.
+//
+// The syntax must be the same as the corresponding scanner in syntax.hpp.
+
+using char_type = location::char_type;
+using iterator  = const char_type*;
+
+// ---------------------------------------------------------------------------
+// combinators
+
+template<char_type C>
+struct character
+{
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        if(iter != last && *iter == C)
+        {
+            ++iter;
+            return true;
+        }
+        return false;
+    }
+};
+
+template<char_type From, char_type To>
+struct character_in_range
+{
+    static_assert(From <= To, "");
+
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        if(iter != last && From <= *iter && *iter <= To)
+        {
+            ++iter;
+            return true;
+        }
+        return false;
+    }
+};
+
+template<char_type ... Cs>
+struct character_either
+{
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        if(iter != last && is_one_of<Cs...>(*iter))
+        {
+            ++iter;
+            return true;
+        }
+        return false;
+    }
+
+  private:
+
+    template<typename T = void>
+    static constexpr bool is_one_of(const char_type) noexcept
+    {
+        return false;
+    }
+    template<char_type C, char_type ... Rest>
+    static constexpr bool is_one_of(const char_type c) noexcept
+    {
+        return c == C || is_one_of<Rest...>(c);
+    }
+};
+
+template<char_type ... Cs>
+struct literal
+{
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        constexpr std::size_t N = sizeof...(Cs);
+        constexpr char_type value[N] = {Cs...};
+
+        if(static_cast<std::size_t>(last - iter) < N)
+        {
+            return false;
+        }
+        for(std::size_t i=0; i<N; ++i)
+        {
+            if(iter[i] != value[i])
+            {
+                return false;
+            }
+        }
+        iter += N;
+        return true;
+    }
+};
+
+template<typename ... Ss>
+struct sequence
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        if( ! match_all<Ss...>(iter, last, s))
+        {
+            iter = first;
+            return false;
+        }
+        return true;
+    }
+
+  private:
+
+    template<typename S>
+    static bool match_all(iterator& iter, const iterator last, const spec& s)
+    {
+        return S::match(iter, last, s);
+    }
+    template<typename S, typename S2, typename ... Rest>
+    static bool match_all(iterator& iter, const iterator last, const spec& s)
+    {
+        return S::match(iter, last, s) && match_all<S2, Rest...>(iter, last, s);
+    }
+};
+
+// returns the first match, not the longest one (same as `detail::either`).
+template<typename ... Ss>
+struct either
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        return match_any<Ss...>(iter, last, s);
+    }
+
+  private:
+
+    template<typename S>
+    static bool match_any(iterator& iter, const iterator last, const spec& s)
+    {
+        return S::match(iter, last, s);
+    }
+    template<typename S, typename S2, typename ... Rest>
+    static bool match_any(iterator& iter, const iterator last, const spec& s)
+    {
+        return S::match(iter, last, s) || match_any<S2, Rest...>(iter, last, s);
+    }
+};
+
+template<std::size_t N, typename S>
+struct repeat_exact
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        for(std::size_t i=0; i<N; ++i)
+        {
+            if( ! S::match(iter, last, s))
+            {
+                iter = first;
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template<std::size_t N, typename S>
+struct repeat_at_least
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        for(std::size_t i=0; i<N; ++i)
+        {
+            if( ! S::match(iter, last, s))
+            {
+                iter = first;
+                return false;
+            }
+        }
+        while(iter != last && S::match(iter, last, s))
+        {
+            // continue
+        }
+        return true;
+    }
+};
+
+template<typename S>
+struct maybe
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        S::match(iter, last, s);
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// convert it into a region.
+
+// [current_of(loc), end_of(loc)) is contiguous. If loc is in the last line,
+// it contains the newline that is appended logically.
+inline iterator current_of(const location& loc) noexcept
+{
+    return loc.source()->pointer_to(loc.get_location());
+}
+inline iterator end_of(const location& loc) noexcept
+{
+    return loc.source()->end_from(loc.get_location());
+}
+
+template<typename Scanner>
+region scan(location& loc, const spec& s)
+{
+    const iterator first = current_of(loc);
+    const iterator last  = end_of(loc);
+
+    iterator iter = first;
+    if( ! Scanner::match(iter, last, s))
+    {
+        return region{};
+    }
+    const auto start = loc;
+    loc.advance(static_cast<std::size_t>(iter - first));
+    return region(start, loc);
+}
+
+// advances `loc` past the matched bytes, without constructing a region.
+template<typename Scanner>
+bool match(location& loc, const spec& s)
+{
+    const iterator first = current_of(loc);
+    const iterator last  = end_of(loc);
+
+    iterator iter = first;
+    if( ! Scanner::match(iter, last, s))
+    {
+        return false;
+    }
+    loc.advance(static_cast<std::size_t>(iter - first));
+    return true;
+}
+
+// ===========================================================================
+// syntax
+
+// ---------------------------------------------------------------------------
+// UTF-8
+
+using utf8_2bytes = sequence<
+    character_in_range<0xC2, 0xDF>,
+    character_in_range<0x80, 0xBF>
+    >;
+using utf8_3bytes = sequence<
+    either<
+        sequence<character         <0xE0>,       character_in_range<0xA0, 0xBF>>,
+        sequence<character_in_range<0xE1, 0xEC>, character_in_range<0x80, 0xBF>>,
+        sequence<character         <0xED>,       character_in_range<0x80, 0x9F>>,
+        sequence<character_in_range<0xEE, 0xEF>, character_in_range<0x80, 0xBF>>
+        >,
+    character_in_range<0x80, 0xBF>
+    >;
+using utf8_4bytes = sequence<
+    either<
+        sequence<character         <0xF0>,       character_in_range<0x90, 0xBF>>,
+        sequence<character_in_range<0xF1, 0xF3>, character_in_range<0x80, 0xBF>>,
+        sequence<character         <0xF4>,       character_in_range<0x80, 0x8F>>
+        >,
+    character_in_range<0x80, 0xBF>,
+    character_in_range<0x80, 0xBF>
+    >;
+
+using non_ascii = either<utf8_2bytes, utf8_3bytes, utf8_4bytes>;
+
+// ---------------------------------------------------------------------------
+// whitespace
+
+using wschar = character_either<' ', '\t'>;
+
+struct ws
+{
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        iter = simd::skip_whitespace(iter, last);
+        return true;
+    }
+};
+
+using newline = either<character<'\n'>, literal<'\r', '\n'>>;
+
+// ---------------------------------------------------------------------------
+// comment (it does not take newline)
+
+struct comment
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        if(iter == last || *iter != '#')
+        {
+            return false;
+        }
+        ++iter;
+        while(true)
+        {
+            iter = simd::find_non_comment_char(iter, last,
+                    s.v1_1_0_allow_control_characters_in_comments);
+
+            // non-ASCII characters are allowed only if it is valid UTF-8
+            if(iter == last || *iter < 0x80 || ! non_ascii::match(iter, last, s))
+            {
+                return true;
+            }
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// numbers
+
+using digit  = character_in_range<'0', '9'>;
+using alpha  = either<character_in_range<'a', 'z'>, character_in_range<'A', 'Z'>>;
+using hexdig = either<digit, character_in_range<'a', 'f'>, character_in_range<'A', 'F'>>;
+
+using dec_int = sequence<
+    maybe<character_either<'-', '+'>>,
+    either<
+        sequence<
+            character_in_range<'1', '9'>,
+            repeat_at_least<1, either<digit, sequence<character<'_'>, digit>>>
+            >,
+        digit
+        >
+    >;
+
+using hex_int = sequence<
+    literal<'0', 'x'>,
+    hexdig,
+    repeat_at_least<0, either<hexdig, sequence<character<'_'>, hexdig>>>
+    >;
+
+using oct_int = sequence<
+    literal<'0', 'o'>,
+    character_in_range<'0', '7'>,
+    repeat_at_least<0, either<
+        character_in_range<'0', '7'>,
+        sequence<character<'_'>, character_in_range<'0', '7'>>
+        >>
+    >;
+
+using bin_int = sequence<
+    literal<'0', 'b'>,
+    character_either<'0', '1'>,
+    repeat_at_least<0, either<
+        character_either<'0', '1'>,
+        sequence<character<'_'>, character_either<'0', '1'>>
+        >>
+    >;
+
+using zero_prefixable_int = sequence<
+    digit, repeat_at_least<0, either<digit, sequence<character<'_'>, digit>>>
+    >;
+
+using fractional_part = sequence<character<'.'>, zero_prefixable_int>;
+
+using exponent_part = sequence<
+    character_either<'e', 'E'>,
+    maybe<character_either<'+', '-'>>,
+    zero_prefixable_int
+    >;
+
+using floating = either<
+    sequence<
+        dec_int,
+        either<exponent_part, sequence<fractional_part, maybe<exponent_part>>>
+        >,
+    sequence<
+        maybe<character_either<'-', '+'>>,
+        either<literal<'i', 'n', 'f'>, literal<'n', 'a', 'n'>>
+        >
+    >;
+
+// ---------------------------------------------------------------------------
+// strings
+
+struct escaped
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        if(last - iter < 2 || *iter != '\\')
+        {
+            return false;
+        }
+        const auto first = iter;
+        ++iter; // backslash
+
+        const auto c = *iter;
+        if(c == '\"' || c == '\\' || c == 'b' || c == 'f' || c == 'n' ||
+           c == 'r'  || c == 't'  || (s.v1_1_0_add_escape_sequence_e && c == 'e'))
+        {
+            ++iter;
+            return true;
+        }
+        if(sequence<character<'u'>, repeat_exact<4, hexdig>>::match(iter, last, s) ||
+           sequence<character<'U'>, repeat_exact<8, hexdig>>::match(iter, last, s))
+        {
+            return true;
+        }
+        if(s.v1_1_0_add_escape_sequence_x &&
+           sequence<character<'x'>, repeat_exact<2, hexdig>>::match(iter, last, s))
+        {
+            return true;
+        }
+        iter = first;
+        return false;
+    }
+};
+
+using basic_unescaped = either<
+    wschar,
+    character<0x21>,                // 22 is "
+    character_in_range<0x23, 0x5B>, // 5C is backslash
+    character_in_range<0x5D, 0x7E>, // 7F is DEL
+    non_ascii
+    >;
+
+using basic_char = either<basic_unescaped, escaped>;
+
+// a run of multibyte UTF-8 characters. It stops at the first ASCII byte.
+struct non_ascii_run
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        while(iter != last && 0x80 <= *iter)
+        {
+            if( ! non_ascii::match(iter, last, s))
+            {
+                iter = first;
+                return false;
+            }
+        }
+        return iter != first;
+    }
+};
+
+// It is equivalent to `"` basic_char* `"`, but it skips the unescaped
+// characters using simd::find_basic_string_special.
+struct basic_string
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        if(iter == last || *iter != '"')
+        {
+            return false;
+        }
+        const auto first = iter;
+        ++iter;
+        while(true)
+        {
+            iter = simd::find_basic_string_special(iter, last);
+            if(iter == last)
+            {
+                break;
+            }
+            if(*iter == '"')
+            {
+                ++iter;
+                return true;
+            }
+            if( ! escaped::match(iter, last, s) && ! non_ascii_run::match(iter, last, s))
+            {
+                break; // control character, DEL, invalid escape or UTF-8
+            }
+        }
+        iter = first;
+        return false;
+    }
+};
+
+using escaped_newline = sequence<
+    character<'\\'>, ws, newline, repeat_at_least<0, either<wschar, newline>>
+    >;
+
+// It is equivalent to
+// `"""` newline? mlb_content* (mlb_quotes mlb_content+)* `"""` mlb_quotes?
+// where mlb_quotes is one or two `"`.
+struct ml_basic_string
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        if( ! literal<'"', '"', '"'>::match(iter, last, s))
+        {
+            return false;
+        }
+        maybe<newline>::match(iter, last, s);
+        while(true)
+        {
+            iter = simd::find_basic_string_special(iter, last);
+            if(iter == last)
+            {
+                break;
+            }
+            if(*iter == '"')
+            {
+                std::size_t quotes = 1;
+                while(iter + quotes != last && iter[quotes] == '"')
+                {
+                    ++quotes;
+                }
+                if(quotes < 3)
+                {
+                    iter += quotes; // a part of the content
+                    continue;
+                }
+                // """ closes the string. up to 2 quotes just before the
+                // delimiter belong to the content.
+                iter += (quotes < 5) ? quotes : 5;
+                return true;
+            }
+            if( ! newline::match(iter, last, s) &&
+                ! escaped::match(iter, last, s) &&
+                ! escaped_newline::match(iter, last, s) &&
+                ! non_ascii_run::match(iter, last, s))
+            {
+                break; // control character, DEL, invalid escape or UTF-8
+            }
+        }
+        iter = first;
+        return false;
+    }
+};
+
+using literal_char = either<
+    character<0x09>,
+    character_in_range<0x20, 0x26>,
+    character_in_range<0x28, 0x7E>,
+    non_ascii
+    >;
+
+// It is equivalent to `'` literal_char* `'`, but it skips the unescaped
+// characters using simd::find_literal_string_special.
+struct literal_string
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        if(iter == last || *iter != '\'')
+        {
+            return false;
+        }
+        const auto first = iter;
+        ++iter;
+        while(true)
+        {
+            iter = simd::find_literal_string_special(iter, last);
+            if(iter == last)
+            {
+                break;
+            }
+            if(*iter == '\'')
+            {
+                ++iter;
+                return true;
+            }
+            if( ! non_ascii_run::match(iter, last, s))
+            {
+                break; // control character, DEL or invalid UTF-8
+            }
+        }
+        iter = first;
+        return false;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// keys
+
+// It does not check `v1_1_0_allow_non_english_in_bare_keys`.
+// `unquoted_key` checks it before calling this.
+struct non_ascii_key_char
+{
+    static bool match(iterator& iter, const iterator last, const spec&) noexcept
+    {
+        const auto first = iter;
+        const auto cp = read_utf8(iter, last);
+
+        // ALPHA / DIGIT / %x2D / %x5F    ; a-z A-Z 0-9 - _
+        // / %xB2 / %xB3 / %xB9 / %xBC-BE ; superscript digits, fractions
+        // / %xC0-D6 / %xD8-F6 / %xF8-37D ; non-symbol chars in Latin block
+        // / %x37F-1FFF                   ; exclude GREEK QUESTION MARK, which is basically a semi-colon
+        // / %x200C-200D / %x203F-2040    ; from General Punctuation Block, include the two tie symbols and ZWNJ, ZWJ
+        // / %x2070-218F / %x2460-24FF    ; include super-/subscripts, letterlike/numberlike forms, enclosed alphanumerics
+        // / %x2C00-2FEF / %x3001-D7FF    ; skip arrows, math, box drawing etc, skip 2FF0-3000 ideographic up/down markers and spaces
+        // / %xF900-FDCF / %xFDF0-FFFD    ; skip D800-DFFF surrogate block, E000-F8FF Private Use area, FDD0-FDEF intended for process-internal use (unicode)
+        // / %x10000-EFFFF                ; all chars outside BMP range, excluding Private Use planes (F0000-10FFFF)
+
+        if(cp == 0xB2 || cp == 0xB3 || cp == 0xB9 || (0xBC <= cp && cp <= 0xBE) ||
+           (0xC0    <= cp && cp <= 0xD6  ) || (0xD8 <= cp && cp <= 0xF6) || (0xF8 <= cp && cp <= 0x37D) ||
+           (0x37F   <= cp && cp <= 0x1FFF) ||
+           (0x200C  <= cp && cp <= 0x200D) || (0x203F <= cp && cp <= 0x2040) ||
+           (0x2070  <= cp && cp <= 0x218F) || (0x2460 <= cp && cp <= 0x24FF) ||
+           (0x2C00  <= cp && cp <= 0x2FEF) || (0x3001 <= cp && cp <= 0xD7FF) ||
+           (0xF900  <= cp && cp <= 0xFDCF) || (0xFDF0 <= cp && cp <= 0xFFFD) ||
+           (0x10000 <= cp && cp <= 0xEFFFF) )
+        {
+            return true;
+        }
+        iter = first;
+        return false;
+    }
+
+  private:
+
+    // U+0000   ... U+0079  ; 0xxx_xxxx
+    // U+0080   ... U+07FF  ; 110y_yyyx 10xx_xxxx;
+    // U+0800   ... U+FFFF  ; 1110_yyyy 10yx_xxxx 10xx_xxxx
+    // U+010000 ... U+10FFFF; 1111_0yyy 10yy_xxxx 10xx_xxxx 10xx_xxxx
+    static std::uint32_t read_utf8(iterator& iter, const iterator last) noexcept
+    {
+        if(iter == last) {return 0xFFFFFFFF;}
+
+        const std::uint32_t b1 = *iter++;
+        if(b1 < 0x80)
+        {
+            return b1;
+        }
+        else if((b1 >> 5) == 6) // 0b110 == 6
+        {
+            if(last - iter < 1) {return 0xFFFFFFFF;}
+            const std::uint32_t c2 = *iter++ & ((1 << 6) - 1);
+
+            const std::uint32_t codep = ((b1 & ((1 << 5) - 1)) << 6) + c2;
+            return codep < 0x80 ? 0xFFFFFFFF : codep;
+        }
+        else if((b1 >> 4) == 14) // 0b1110 == 14
+        {
+            if(last - iter < 2) {return 0xFFFFFFFF;}
+            const std::uint32_t c2 = *iter++ & ((1 << 6) - 1);
+            const std::uint32_t c3 = *iter++ & ((1 << 6) - 1);
+
+            const std::uint32_t codep = ((b1 & ((1 << 4) - 1)) << 12) + (c2 << 6) + c3;
+            return codep < 0x800 ? 0xFFFFFFFF : codep;
+        }
+        else if((b1 >> 3) == 30) // 0b11110 == 30
+        {
+            if(last - iter < 3) {return 0xFFFFFFFF;}
+            const std::uint32_t c2 = *iter++ & ((1 << 6) - 1);
+            const std::uint32_t c3 = *iter++ & ((1 << 6) - 1);
+            const std::uint32_t c4 = *iter++ & ((1 << 6) - 1);
+
+            const std::uint32_t codep = ((b1 & ((1 << 3) - 1)) << 18) +
+                                        (c2 << 12) + (c3 << 6) + c4;
+            return codep < 0x10000 ? 0xFFFFFFFF : codep;
+        }
+        else // not a Unicode codepoint in UTF-8
+        {
+            return 0xFFFFFFFF;
+        }
+    }
+};
+
+struct unquoted_key
+{
+    static bool match(iterator& iter, const iterator last, const spec& s)
+    {
+        const auto first = iter;
+        while(keychar(iter, last, s))
+        {
+            // continue
+        }
+        return iter != first;
+    }
+
+  private:
+
+    static bool keychar(iterator& iter, const iterator last, const spec& s)
+    {
+        if(either<alpha, digit, character<0x2D>, character<0x5F>>::match(iter, last, s))
+        {
+            return true;
+        }
+        return s.v1_1_0_allow_non_english_in_bare_keys &&
+               non_ascii_key_char::match(iter, last, s);
+    }
+};
+
+using quoted_key = either<basic_string, literal_string>;
+using simple_key = either<unquoted_key, quoted_key>;
+using dot_sep    = sequence<ws, character<'.'>, ws>;
+using dotted_key = sequence<
+    simple_key, repeat_at_least<1, sequence<dot_sep, simple_key>>
+    >;
+using key = either<dotted_key, simple_key>;
+
+// ---------------------------------------------------------------------------
+// table headers
+
+using std_table   = sequence<character<'['>, ws, key, ws, character<']'>>;
+using array_table = sequence<literal<'[', '['>, ws, key, ws, literal<']', ']'>>;
+
+// ===========================================================================
+// number and datetime lexer
+//
+// Classifies a number or a datetime and finds the end of it in a single
+// forward pass, instead of trying all the rules one by one from the same
+// position.
+//
+// It only accepts well-formed tokens followed by a delimiter (whitespace,
+// newline, comment, `,`, `]`, `}`) or EOF. Otherwise, `type` becomes
+// `value_t::empty` and the caller needs to fall back to the syntax rules to
+// diagnose the error.
+
+struct number_token
+{
+    value_t     type;
+    std::size_t length;
+    std::size_t date_length; // `YYYY-MM-DD` in a date or a datetime, or 0
+    std::size_t time_length; // `HH:MM:SS.frac` in a time or a datetime, or 0
+};
+
+namespace lexer
+{
+
+inline bool is_digit(const char_type c) noexcept
+{
+    return char_type('0') <= c && c <= char_type('9');
+}
+inline bool is_hexdig(const char_type c) noexcept
+{
+    return is_digit(c) || (char_type('a') <= c && c <= char_type('f')) ||
+                          (char_type('A') <= c && c <= char_type('F'));
+}
+inline bool is_octdig(const char_type c) noexcept
+{
+    return char_type('0') <= c && c <= char_type('7');
+}
+inline bool is_bindig(const char_type c) noexcept
+{
+    return c == char_type('0') || c == char_type('1');
+}
+
+inline bool is_delimiter(const char_type c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+           c == ',' || c == ']'  || c == '}'  || c == '#';
+}
+
+// digit (digit | _ digit)*
+template<typename Pred>
+bool digits(iterator& iter, const iterator last, Pred is_valid) noexcept
+{
+    if(iter == last || ! is_valid(*iter))
+    {
+        return false;
+    }
+    ++iter;
+    while(iter != last)
+    {
+        if(is_valid(*iter))
+        {
+            ++iter;
+        }
+        else if(*iter == '_' && last - iter >= 2 && is_valid(iter[1]))
+        {
+            iter += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+// exactly N digits
+inline bool fixed_digits(iterator& iter, const iterator last, const std::size_t N) noexcept
+{
+    if(static_cast<std::size_t>(last - iter) < N)
+    {
+        return false;
+    }
+    for(std::size_t i=0; i<N; ++i)
+    {
+        if( ! is_digit(iter[i]))
+        {
+            return false;
+        }
+    }
+    iter += N;
+    return true;
+}
+
+inline bool expect(iterator& iter, const iterator last, const char_type c) noexcept
+{
+    if(iter != last && *iter == c)
+    {
+        ++iter;
+        return true;
+    }
+    return false;
+}
+
+// HH:MM:SS(.subsec)?, seconds can be omitted if v1.1.0 is enabled
+inline bool local_time(iterator& iter, const iterator last, const spec& s) noexcept
+{
+    if( ! fixed_digits(iter, last, 2) || ! expect(iter, last, ':') ||
+        ! fixed_digits(iter, last, 2))
+    {
+        return false;
+    }
+    if(iter != last && *iter == ':')
+    {
+        ++iter;
+        if( ! fixed_digits(iter, last, 2))
+        {
+            return false;
+        }
+        if(last - iter >= 2 && iter[0] == '.' && is_digit(iter[1]))
+        {
+            ++iter;
+            while(iter != last && is_digit(*iter)) {++iter;}
+        }
+        return true;
+    }
+    return s.v1_1_0_make_seconds_optional;
+}
+
+// Z | [+-]HH:MM
+inline bool time_offset(iterator& iter, const iterator last) noexcept
+{
+    if(iter == last)
+    {
+        return false;
+    }
+    if(*iter == 'Z' || *iter == 'z')
+    {
+        ++iter;
+        return true;
+    }
+    if(*iter == '+' || *iter == '-')
+    {
+        ++iter;
+        return fixed_digits(iter, last, 2) && expect(iter, last, ':') &&
+               fixed_digits(iter, last, 2);
+    }
+    return false;
+}
+
+} // lexer
+
+inline number_token lex_number(const iterator first, const iterator last,
+                               const spec& s) noexcept
+{
+    using namespace lexer;
+
+    const number_token failed{value_t::empty, 0, 0, 0};
+    std::size_t date_length = 0;
+    std::size_t time_length = 0;
+    const auto finish = [first, last, &date_length, &time_length](
+            const iterator iter, const value_t ty) -> number_token {
+        if(iter == last || is_delimiter(*iter))
+        {
+            return number_token{ty, static_cast<std::size_t>(iter - first),
+                                date_length, time_length};
+        }
+        return number_token{value_t::empty, 0, 0, 0};
+    };
+
+    iterator iter = first;
+
+    // ------------------------------------------------------------------------
+    // datetime. YYYY-MM-DD or HH:MM
+
+    if(last - iter >= 3 && is_digit(iter[0]) && is_digit(iter[1]) && iter[2] == ':')
+    {
+        if( ! lexer::local_time(iter, last, s))
+        {
+            return failed;
+        }
+        time_length = static_cast<std::size_t>(iter - first);
+        return finish(iter, value_t::local_time);
+    }
+    if(last - iter >= 5 && is_digit(iter[0]) && is_digit(iter[1]) &&
+                           is_digit(iter[2]) && is_digit(iter[3]) && iter[4] == '-')
+    {
+        iter += 5;
+        if( ! fixed_digits(iter, last, 2) || ! expect(iter, last, '-') ||
+            ! fixed_digits(iter, last, 2))
+        {
+            return failed;
+        }
+        date_length = static_cast<std::size_t>(iter - first);
+
+        // a space is a delimiter only if a time follows it.
+        if(iter != last && (*iter == 'T' || *iter == 't' ||
+                (*iter == ' ' && last - iter >= 2 && is_digit(iter[1]))))
+        {
+            ++iter;
+            const auto time_first = iter;
+            if( ! lexer::local_time(iter, last, s))
+            {
+                return failed;
+            }
+            time_length = static_cast<std::size_t>(iter - time_first);
+            if(iter != last && (*iter == 'Z' || *iter == 'z' || *iter == '+' || *iter == '-'))
+            {
+                if( ! lexer::time_offset(iter, last))
+                {
+                    return failed;
+                }
+                return finish(iter, value_t::offset_datetime);
+            }
+            return finish(iter, value_t::local_datetime);
+        }
+        return finish(iter, value_t::local_date);
+    }
+
+    // ------------------------------------------------------------------------
+    // number
+
+    const bool has_sign = (iter != last && (*iter == '+' || *iter == '-'));
+    if(has_sign)
+    {
+        ++iter;
+    }
+
+    if(last - iter >= 3 && ((iter[0] == 'i' && iter[1] == 'n' && iter[2] == 'f') ||
+                            (iter[0] == 'n' && iter[1] == 'a' && iter[2] == 'n')))
+    {
+        return finish(iter + 3, value_t::floating);
+    }
+
+    if( ! has_sign && last - iter >= 2 && iter[0] == '0')
+    {
+        // hex floats (extension) are left to the syntax rules
+        if(iter[1] == 'x')
+        {
+            iter += 2;
+            return digits(iter, last, is_hexdig) ?
+                finish(iter, value_t::integer) : failed;
+        }
+        if(iter[1] == 'o')
+        {
+            iter += 2;
+            return digits(iter, last, is_octdig) ?
+                finish(iter, value_t::integer) : failed;
+        }
+        if(iter[1] == 'b')
+        {
+            iter += 2;
+            return digits(iter, last, is_bindig) ?
+                finish(iter, value_t::integer) : failed;
+        }
+    }
+
+    if(iter == last || ! is_digit(*iter))
+    {
+        return failed;
+    }
+    if(*iter == '0')
+    {
+        ++iter; // leading zero is followed by a digit -> not a delimiter
+    }
+    else
+    {
+        digits(iter, last, is_digit);
+    }
+
+    bool is_float = false;
+    if(iter != last && *iter == '.')
+    {
+        ++iter;
+        if( ! digits(iter, last, is_digit))
+        {
+            return failed;
+        }
+        is_float = true;
+    }
+    if(iter != last && (*iter == 'e' || *iter == 'E'))
+    {
+        ++iter;
+        if(iter != last && (*iter == '+' || *iter == '-'))
+        {
+            ++iter;
+        }
+        if( ! digits(iter, last, is_digit))
+        {
+            return failed;
+        }
+        is_float = true;
+    }
+    return finish(iter, is_float ? value_t::floating : value_t::integer);
+}
+
+inline number_token lex_number(const location& loc, const spec& s) noexcept
+{
+    return lex_number(current_of(loc), end_of(loc), s);
+}
+
+} // static_scanner
+} // detail
+} // toml
+#endif // TOML11_STATIC_SCANNER_HPP
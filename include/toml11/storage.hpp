@@ -3,11 +3,50 @@
 
 #include "compat.hpp"
 
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
 namespace toml
 {
+
+// If TypeConfig::storage_type is copy_on_write, copies of a value share its
+// arrays and tables until one of them is modified. By default (deep_copy),
+// copying a value copies all the arrays and tables in it.
+struct deep_copy     {};
+struct copy_on_write {};
+
 namespace detail
 {
 
+// If T is an allocator-aware container (e.g. std::vector<T, arena_allocator<T>>),
+// storage<T> allocates T itself by the same allocator as the elements.
+struct has_get_allocator_impl
+{
+    template<typename T> static std::true_type  check(
+        decltype(std::declval<const T&>().get_allocator())*);
+    template<typename T> static std::false_type check(...);
+};
+template<typename T>
+using has_get_allocator = decltype(has_get_allocator_impl::check<T>(nullptr));
+
+template<typename T, bool = has_get_allocator<T>::value>
+struct storage_allocator
+{
+    using type = std::allocator<T>;
+    static type get(const T&) noexcept {return type();}
+};
+template<typename T>
+struct storage_allocator<T, true>
+{
+    using type = typename std::allocator_traits<
+        typename T::allocator_type>::template rebind_alloc<T>;
+    static type get(const T& v) noexcept {return type(v.get_allocator());}
+};
+
 // It owns a pointer to T. It does deep-copy when copied.
 // This struct is introduced to implement a recursive type.
 //
@@ -18,30 +57,229 @@ namespace detail
 // `std::vector<std::unique_ptr<toml::value>>`. Although `std::unique_ptr` is
 // noncopyable, we want to make `toml::value` copyable. `storage` is introduced
 // to resolve those problems.
+//
+// The allocator is a base class so that std::allocator takes no space.
 template<typename T>
-struct storage
+struct storage : private storage_allocator<T>::type
 {
-    using value_type = T;
+    using value_type     = T;
+    using allocator_type = typename storage_allocator<T>::type;
+    using traits_type    = std::allocator_traits<allocator_type>;
 
-    explicit storage(value_type v): ptr_(cxx::make_unique<T>(std::move(v))) {}
-    ~storage() = default;
+    explicit storage(value_type v)
+        : allocator_type(storage_allocator<T>::get(v)), ptr_(nullptr)
+    {
+        this->ptr_ = this->create(std::move(v));
+    }
+    ~storage() noexcept {this->destroy();}
 
-    storage(const storage& rhs): ptr_(cxx::make_unique<T>(*rhs.ptr_)) {}
+    storage(const storage& rhs)
+        : allocator_type(traits_type::select_on_container_copy_construction(
+                    rhs.allocator())), ptr_(nullptr)
+    {
+        this->ptr_ = this->create(*rhs.ptr_);
+    }
     storage& operator=(const storage& rhs)
     {
-        this->ptr_ = cxx::make_unique<T>(*rhs.ptr_);
+        storage tmp(rhs);
+        this->swap(tmp);
         return *this;
     }
 
-    storage(storage&&) = default;
-    storage& operator=(storage&&) = default;
+    storage(storage&& rhs) noexcept
+        : allocator_type(std::move(rhs.allocator())), ptr_(rhs.ptr_)
+    {
+        rhs.ptr_ = nullptr;
+    }
+    storage& operator=(storage&& rhs) noexcept
+    {
+        this->swap(rhs);
+        return *this;
+    }
 
-    bool is_ok() const noexcept {return static_cast<bool>(ptr_);}
+    bool is_ok() const noexcept {return this->ptr_ != nullptr;}
 
     value_type& get() const noexcept {return *ptr_;}
+    value_type& get_mutable() noexcept {return *ptr_;}
+
+  private:
+
+    allocator_type&       allocator()       noexcept {return *this;}
+    allocator_type const& allocator() const noexcept {return *this;}
+
+    void swap(storage& rhs) noexcept
+    {
+        using std::swap;
+        swap(this->allocator(), rhs.allocator());
+        swap(this->ptr_, rhs.ptr_);
+    }
+
+    template<typename U>
+    value_type* create(U&& v)
+    {
+        value_type* p = traits_type::allocate(this->allocator(), 1);
+        try
+        {
+            traits_type::construct(this->allocator(), p, std::forward<U>(v));
+        }
+        catch(...)
+        {
+            traits_type::deallocate(this->allocator(), p, 1);
+            throw;
+        }
+        return p;
+    }
+    void destroy() noexcept
+    {
+        if(this->ptr_)
+        {
+            traits_type::destroy(this->allocator(), this->ptr_);
+            traits_type::deallocate(this->allocator(), this->ptr_, 1);
+            this->ptr_ = nullptr;
+        }
+    }
+
+  private:
+    value_type* ptr_;
+};
+
+template<typename T>
+struct shared_node
+{
+    template<typename U>
+    explicit shared_node(U&& v): refs(1), value(std::forward<U>(v)) {}
+
+    std::atomic<std::size_t> refs;
+    T value;
+};
+
+// It owns a reference-counted pointer to T. Its copies share the same T, and
+// `get_mutable` copies T if it is shared (copy-on-write). Since the elements
+// of a copied T also share their arrays and tables, modifying a value in a
+// copied tree copies only the arrays and tables on the path to it.
+//
+// A reference returned by `get_mutable` is not protected; if the storage is
+// copied while it is held, modifying through it also changes the copy.
+template<typename T>
+struct shared_storage : private std::allocator_traits<
+    typename storage_allocator<T>::type>::template rebind_alloc<shared_node<T>>
+{
+    using value_type     = T;
+    using node_type      = shared_node<T>;
+    using allocator_type = typename std::allocator_traits<
+        typename storage_allocator<T>::type>::template rebind_alloc<node_type>;
+    using traits_type    = std::allocator_traits<allocator_type>;
+
+    explicit shared_storage(value_type v)
+        : allocator_type(storage_allocator<T>::get(v)), ptr_(nullptr)
+    {
+        this->ptr_ = this->create(std::move(v));
+    }
+    ~shared_storage() noexcept {this->release();}
+
+    // if the copy would use another allocator, it cannot share the node.
+    shared_storage(const shared_storage& rhs)
+        : allocator_type(traits_type::select_on_container_copy_construction(
+                    rhs.allocator())), ptr_(nullptr)
+    {
+        if(this->allocator() == rhs.allocator())
+        {
+            this->ptr_ = rhs.ptr_;
+            this->ptr_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            this->ptr_ = this->create(rhs.ptr_->value);
+        }
+    }
+    shared_storage& operator=(const shared_storage& rhs)
+    {
+        shared_storage tmp(rhs);
+        this->swap(tmp);
+        return *this;
+    }
+
+    shared_storage(shared_storage&& rhs) noexcept
+        : allocator_type(std::move(rhs.allocator())), ptr_(rhs.ptr_)
+    {
+        rhs.ptr_ = nullptr;
+    }
+    shared_storage& operator=(shared_storage&& rhs) noexcept
+    {
+        this->swap(rhs);
+        return *this;
+    }
+
+    bool is_ok() const noexcept {return this->ptr_ != nullptr;}
+
+    // true if it shares the value with other storages
+    bool is_shared() const noexcept
+    {
+        return this->ptr_->refs.load(std::memory_order_acquire) != 1;
+    }
+
+    value_type const& get() const noexcept {return ptr_->value;}
+    value_type& get_mutable()
+    {
+        if(this->is_shared())
+        {
+            node_type* p = this->create(this->ptr_->value);
+            this->release();
+            this->ptr_ = p;
+        }
+        return this->ptr_->value;
+    }
 
   private:
-    std::unique_ptr<value_type> ptr_;
+
+    allocator_type&       allocator()       noexcept {return *this;}
+    allocator_type const& allocator() const noexcept {return *this;}
+
+    void swap(shared_storage& rhs) noexcept
+    {
+        using std::swap;
+        swap(this->allocator(), rhs.allocator());
+        swap(this->ptr_, rhs.ptr_);
+    }
+
+    template<typename U>
+    node_type* create(U&& v)
+    {
+        node_type* p = traits_type::allocate(this->allocator(), 1);
+        try
+        {
+            traits_type::construct(this->allocator(), p, std::forward<U>(v));
+        }
+        catch(...)
+        {
+            traits_type::deallocate(this->allocator(), p, 1);
+            throw;
+        }
+        return p;
+    }
+    void release() noexcept
+    {
+        if(this->ptr_ && this->ptr_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            traits_type::destroy(this->allocator(), this->ptr_);
+            traits_type::deallocate(this->allocator(), this->ptr_, 1);
+        }
+        this->ptr_ = nullptr;
+    }
+
+  private:
+    node_type* ptr_;
+};
+
+template<typename T, typename Policy>
+struct storage_of
+{
+    using type = storage<T>;
+};
+template<typename T>
+struct storage_of<T, copy_on_write>
+{
+    using type = shared_storage<T>;
 };
 
 } // detail
@@ -42,6 +42,21 @@ struct has_key_type_impl
     template<typename T> static std::true_type  check(typename T::key_type*);
     template<typename T> static std::false_type check(...);
 };
+struct has_region_type_impl
+{
+    template<typename T> static std::true_type  check(typename T::region_type*);
+    template<typename T> static std::false_type check(...);
+};
+struct has_format_type_impl
+{
+    template<typename T> static std::true_type  check(typename T::format_type*);
+    template<typename T> static std::false_type check(...);
+};
+struct has_storage_type_impl
+{
+    template<typename T> static std::true_type  check(typename T::storage_type*);
+    template<typename T> static std::false_type check(...);
+};
 struct has_mapped_type_impl
 {
     template<typename T> static std::true_type  check(typename T::mapped_type*);
@@ -120,6 +135,12 @@ struct has_value_type: decltype(has_value_type_impl::check<T>(nullptr)){};
 template<typename T>
 struct has_key_type: decltype(has_key_type_impl::check<T>(nullptr)){};
 template<typename T>
+struct has_region_type: decltype(has_region_type_impl::check<T>(nullptr)){};
+template<typename T>
+struct has_format_type: decltype(has_format_type_impl::check<T>(nullptr)){};
+template<typename T>
+struct has_storage_type: decltype(has_storage_type_impl::check<T>(nullptr)){};
+template<typename T>
 struct has_mapped_type: decltype(has_mapped_type_impl::check<T>(nullptr)){};
 template<typename T>
 struct has_reserve_method: decltype(has_reserve_method_impl::check<T>(nullptr)){};
@@ -128,6 +149,18 @@ struct has_push_back_method: decltype(has_push_back_method_impl::check<T>(nullpt
 template<typename T>
 struct is_comparable: decltype(is_comparable_impl::check<T>(nullptr)){};
 
+// TypeConfig::key_type if it is defined. Otherwise, TypeConfig::string_type.
+template<typename TC, bool = has_key_type<TC>::value>
+struct config_key_type
+{
+    using type = typename TC::string_type;
+};
+template<typename TC>
+struct config_key_type<TC, true>
+{
+    using type = typename TC::key_type;
+};
+
 template<typename T, typename TC>
 struct has_from_toml_method: decltype(has_from_toml_method_impl::check<T, TC>(nullptr)){};
 
@@ -1,9 +1,12 @@
 #ifndef TOML11_TYPES_HPP
 #define TOML11_TYPES_HPP
 
+#include "arena.hpp"
 #include "comments.hpp"
 #include "error_info.hpp"
+#include "float_parser.hpp"
 #include "format.hpp"
+#include "key_pool.hpp"
 #include "ordered_map.hpp"
 #include "value.hpp"
 
@@ -14,8 +17,20 @@
 #include <unordered_map>
 #include <vector>
 
+#include <cassert>
 #include <cstdint>
-#include <cstdio>
+
+#if TOML11_CPLUSPLUS_STANDARD_VERSION >= TOML11_CXX17_VALUE
+#  if __has_include(<memory_resource>)
+#    include <memory_resource>
+#  endif
+#  if defined(__cpp_lib_memory_resource)
+#    if __cpp_lib_memory_resource >= 201603L
+#      define TOML11_HAS_STD_MEMORY_RESOURCE 1
+#    endif
+#  endif
+#endif
+#include <limits>
 
 namespace toml
 {
@@ -32,67 +47,170 @@ class basic_value;
 // Before this functions is called, syntax is checked and prefix(`0x` etc) and
 // spacer(`_`) are removed.
 
-template<typename T>
-result<T, error_info>
-read_dec_int(const std::string& str, const source_location src)
+namespace detail
 {
-    constexpr auto max_digits = std::numeric_limits<T>::digits;
-    assert( ! str.empty());
 
-    T val{0};
-    std::istringstream iss(str);
-    iss >> val;
-    if(iss.fail())
+// reads an integer from [first, last) that is already checked by the syntax.
+// It skips `_` and accepts a sign, but does not skip a prefix like `0x`.
+// It returns false if the value does not fit in T.
+template<typename T, typename Iterator>
+bool read_int_digits(Iterator first, const Iterator last, const std::uint8_t base, T& val) noexcept
+{
+    static_assert(std::is_integral<T>::value, "");
+
+    const bool negative = (first != last && *first == '-');
+    if(first != last && (*first == '-' || *first == '+'))
     {
-        return err(make_error_info("toml::parse_dec_integer: "
-            "too large integer: current max digits = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+        ++first;
     }
-    return ok(val);
+
+    const T b   = static_cast<T>(base);
+    const T min = (std::numeric_limits<T>::min)();
+    const T max = (std::numeric_limits<T>::max)();
+
+    val = T(0);
+    for(; first != last; ++first)
+    {
+        const auto c = static_cast<unsigned char>(*first);
+        if(c == '_')
+        {
+            continue;
+        }
+        const T d = static_cast<T>(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+        assert(d < b);
+
+        if(negative)
+        {
+            // read it as a negative value not to overflow at min (e.g. -2^63)
+            if(std::is_unsigned<T>::value && d != 0)
+            {
+                return false;
+            }
+            if(val < static_cast<T>((min + d) / b))
+            {
+                return false;
+            }
+            val = static_cast<T>(val * b - d);
+        }
+        else
+        {
+            if(val > static_cast<T>((max - d) / b))
+            {
+                return false;
+            }
+            val = static_cast<T>(val * b + d);
+        }
+    }
+    return true;
 }
 
 template<typename T>
-result<T, error_info>
-read_hex_int(const std::string& str, const source_location src)
+error_info make_int_overflow_error(const std::uint8_t base, source_location src)
 {
     constexpr auto max_digits = std::numeric_limits<T>::digits;
+    switch(base)
+    {
+        case 2:
+        {
+            return make_error_info("toml::parse_bin_integer: "
+                "too large integer: current max value = 2^" + std::to_string(max_digits),
+                std::move(src), "must be < 2^" + std::to_string(max_digits));
+        }
+        case 8:
+        {
+            return make_error_info("toml::parse_oct_integer: "
+                "too large integer: current max value = 2^" + std::to_string(max_digits),
+                std::move(src), "must be < 2^" + std::to_string(max_digits));
+        }
+        case 16:
+        {
+            return make_error_info("toml::parse_hex_integer: "
+                "too large integer: current max value = 2^" + std::to_string(max_digits),
+                std::move(src), "must be < 2^" + std::to_string(max_digits));
+        }
+        default:
+        {
+            assert(base == 10);
+            return make_error_info("toml::parse_dec_integer: "
+                "too large integer: current max digits = 2^" + std::to_string(max_digits),
+                std::move(src), "must be < 2^" + std::to_string(max_digits));
+        }
+    }
+}
+
+// built-in integers are read without iostreams. the others (e.g.
+// boost::multiprecision) are read by operator>>.
+template<typename T>
+cxx::enable_if_t<std::is_integral<T>::value, result<T, error_info>>
+read_int_impl(const std::string& str, const source_location src, const std::uint8_t base)
+{
     assert( ! str.empty());
 
     T val{0};
-    std::istringstream iss(str);
-    iss >> std::hex >> val;
-    if(iss.fail())
+    if( ! read_int_digits(str.begin(), str.end(), base, val))
     {
-        return err(make_error_info("toml::parse_hex_integer: "
-            "too large integer: current max value = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+        return err(make_int_overflow_error<T>(base, std::move(src)));
     }
     return ok(val);
 }
 
 template<typename T>
-result<T, error_info>
-read_oct_int(const std::string& str, const source_location src)
+cxx::enable_if_t< ! std::is_integral<T>::value, result<T, error_info>>
+read_int_impl(const std::string& str, const source_location src, const std::uint8_t base)
 {
-    constexpr auto max_digits = std::numeric_limits<T>::digits;
     assert( ! str.empty());
+    assert(base == 10 || base == 16 || base == 8);
 
     T val{0};
     std::istringstream iss(str);
-    iss >> std::oct >> val;
+    if(base == 16)
+    {
+        iss >> std::hex;
+    }
+    else if(base == 8)
+    {
+        iss >> std::oct;
+    }
+    iss >> val;
     if(iss.fail())
     {
-        return err(make_error_info("toml::parse_oct_integer: "
-            "too large integer: current max value = 2^" + std::to_string(max_digits),
-            std::move(src), "must be < 2^" + std::to_string(max_digits)));
+        return err(make_int_overflow_error<T>(base, std::move(src)));
     }
     return ok(val);
 }
 
+} // detail
+
+template<typename T>
+result<T, error_info>
+read_dec_int(const std::string& str, const source_location src)
+{
+    return detail::read_int_impl<T>(str, std::move(src), 10);
+}
+
+template<typename T>
+result<T, error_info>
+read_hex_int(const std::string& str, const source_location src)
+{
+    return detail::read_int_impl<T>(str, std::move(src), 16);
+}
+
+template<typename T>
+result<T, error_info>
+read_oct_int(const std::string& str, const source_location src)
+{
+    return detail::read_int_impl<T>(str, std::move(src), 8);
+}
+
 template<typename T>
 result<T, error_info>
 read_bin_int(const std::string& str, const source_location src)
 {
+    if(std::is_integral<T>::value)
+    {
+        return detail::read_int_impl<T>(str, std::move(src), 2);
+    }
+
     constexpr auto is_bounded =  std::numeric_limits<T>::is_bounded;
     constexpr auto max_digits =  std::numeric_limits<T>::digits;
     const auto max_value  = (std::numeric_limits<T>::max)();
@@ -156,43 +274,18 @@ read_int(const std::string& str, const source_location src, const std::uint8_t b
     }
 }
 
-inline result<float, error_info>
-read_hex_float(const std::string& str, const source_location src, float val)
-{
-#if defined(_MSC_VER) && ! defined(__clang__)
-    const auto res = ::sscanf_s(str.c_str(), "%a", std::addressof(val));
-#else
-    const auto res = std::sscanf(str.c_str(), "%a", std::addressof(val));
-#endif
-    if(res != 1)
-    {
-        return err(make_error_info("toml::parse_floating: "
-            "failed to read hexadecimal floating point value ",
-            std::move(src), "here"));
-    }
-    return ok(val);
-}
-inline result<double, error_info>
-read_hex_float(const std::string& str, const source_location src, double val)
+template<typename T>
+cxx::enable_if_t<detail::float_parser::is_supported<T>::value, result<T, error_info>>
+read_hex_float(const std::string& str, const source_location, T val)
 {
-#if defined(_MSC_VER) && ! defined(__clang__)
-    const auto res = ::sscanf_s(str.c_str(), "%la", std::addressof(val));
-#else
-    const auto res = std::sscanf(str.c_str(), "%la", std::addressof(val));
-#endif
-    if(res != 1)
-    {
-        return err(make_error_info("toml::parse_floating: "
-            "failed to read hexadecimal floating point value ",
-            std::move(src), "here"));
-    }
+    // the syntax is already checked. it rounds the value correctly and
+    // becomes inf if it is too large to represent.
+    detail::float_parser::read_hexadecimal(str.begin(), str.end(), val);
     return ok(val);
 }
 template<typename T>
-cxx::enable_if_t<cxx::conjunction<
-    cxx::negation<std::is_same<cxx::remove_cvref_t<T>, double>>,
-    cxx::negation<std::is_same<cxx::remove_cvref_t<T>, float>>
-    >::value, result<T, error_info>>
+cxx::enable_if_t<cxx::negation<detail::float_parser::is_supported<T>>::value,
+    result<T, error_info>>
 read_hex_float(const std::string&, const source_location src, T)
 {
     return err(make_error_info("toml::parse_floating: failed to read "
@@ -200,8 +293,31 @@ read_hex_float(const std::string&, const source_location src, T)
         std::move(src), "here"));
 }
 
+namespace detail
+{
+inline error_info make_float_read_error(source_location src)
+{
+    return make_error_info("toml::parse_floating: "
+        "failed to read floating point value from stream",
+        std::move(src), "here");
+}
+} // detail
+
 template<typename T>
-result<T, error_info>
+cxx::enable_if_t<detail::float_parser::is_supported<T>::value, result<T, error_info>>
+read_dec_float(const std::string& str, const source_location src)
+{
+    // it does not depend on the locale and rounds the value correctly.
+    T val;
+    if( ! detail::float_parser::read_decimal(str.begin(), str.end(), val))
+    {
+        return err(detail::make_float_read_error(std::move(src)));
+    }
+    return ok(val);
+}
+template<typename T>
+cxx::enable_if_t<cxx::negation<detail::float_parser::is_supported<T>>::value,
+    result<T, error_info>>
 read_dec_float(const std::string& str, const source_location src)
 {
     T val;
@@ -209,9 +325,7 @@ read_dec_float(const std::string& str, const source_location src)
     iss >> val;
     if(iss.fail())
     {
-        return err(make_error_info("toml::parse_floating: "
-            "failed to read floating point value from stream",
-            std::move(src), "here"));
+        return err(detail::make_float_read_error(std::move(src)));
     }
     return ok(val);
 }
@@ -290,6 +404,124 @@ using ordered_value = basic_value<ordered_type_config>;
 using ordered_table = typename ordered_value::table_type;
 using ordered_array = typename ordered_value::array_type;
 
+// ----------------------------------------------------------------------------
+// the keys in a document share their bytes. See key_pool.hpp.
+
+struct interned_type_config
+{
+    using comment_type  = preserve_comments;
+
+    using boolean_type  = bool;
+    using integer_type  = std::int64_t;
+    using floating_type = double;
+    using string_type   = std::string;
+    using key_type      = interned_key;
+
+    template<typename T>
+    using array_type = std::vector<T>;
+    template<typename K, typename T>
+    using table_type = std::unordered_map<K, T>;
+
+    static result<integer_type, error_info>
+    parse_int(const std::string& str, const source_location src, const std::uint8_t base)
+    {
+        return read_int<integer_type>(str, src, base);
+    }
+    static result<floating_type, error_info>
+    parse_float(const std::string& str, const source_location src, const bool is_hex)
+    {
+        return read_float<floating_type>(str, src, is_hex);
+    }
+};
+
+using interned_value = basic_value<interned_type_config>;
+
+// ----------------------------------------------------------------------------
+// strings, arrays, and tables draw from the arena of the current arena_scope.
+// See arena.hpp.
+
+namespace detail
+{
+// std::hash is only defined for strings with std::allocator
+struct arena_string_hash
+{
+    template<typename Str>
+    std::size_t operator()(const Str& s) const noexcept
+    {
+        // FNV-1a
+        std::uint64_t h = 14695981039346656037ull;
+        for(const auto c : s)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+} // detail
+
+struct arena_type_config
+{
+    using comment_type  = preserve_comments;
+
+    using boolean_type  = bool;
+    using integer_type  = std::int64_t;
+    using floating_type = double;
+    using string_type   = std::basic_string<char, std::char_traits<char>,
+                                            arena_allocator<char>>;
+
+    template<typename T>
+    using array_type = std::vector<T, arena_allocator<T>>;
+    template<typename K, typename T>
+    using table_type = std::unordered_map<K, T, detail::arena_string_hash,
+          std::equal_to<K>, arena_allocator<std::pair<const K, T>>>;
+
+    static result<integer_type, error_info>
+    parse_int(const std::string& str, const source_location src, const std::uint8_t base)
+    {
+        return read_int<integer_type>(str, src, base);
+    }
+    static result<floating_type, error_info>
+    parse_float(const std::string& str, const source_location src, const bool is_hex)
+    {
+        return read_float<floating_type>(str, src, is_hex);
+    }
+};
+
+using arena_value = basic_value<arena_type_config>;
+
+#if defined(TOML11_HAS_STD_MEMORY_RESOURCE)
+// strings, arrays, and tables draw from std::pmr::get_default_resource().
+// Note that the default resource is shared by all the threads.
+struct pmr_type_config
+{
+    using comment_type  = preserve_comments;
+
+    using boolean_type  = bool;
+    using integer_type  = std::int64_t;
+    using floating_type = double;
+    using string_type   = std::pmr::string;
+
+    template<typename T>
+    using array_type = std::pmr::vector<T>;
+    template<typename K, typename T>
+    using table_type = std::pmr::unordered_map<K, T>;
+
+    static result<integer_type, error_info>
+    parse_int(const std::string& str, const source_location src, const std::uint8_t base)
+    {
+        return read_int<integer_type>(str, src, base);
+    }
+    static result<floating_type, error_info>
+    parse_float(const std::string& str, const source_location src, const bool is_hex)
+    {
+        return read_float<floating_type>(str, src, is_hex);
+    }
+};
+
+using pmr_value = basic_value<pmr_type_config>;
+#endif // TOML11_HAS_STD_MEMORY_RESOURCE
+
 // ----------------------------------------------------------------------------
 // meta functions for internal use
 
@@ -383,6 +615,37 @@ using is_type_config = cxx::conjunction<
     has_parse_float<T>
     >;
 
+// true if T uses parse_int and parse_float of Base with the same integer_type
+// and floating_type, e.g. T is derived from Base and does not override them.
+struct inherits_number_readers_impl
+{
+    template<typename T, typename Base>
+    static std::integral_constant<bool,
+        (&T::parse_int   == &Base::parse_int  ) &&
+        (&T::parse_float == &Base::parse_float) &&
+        std::is_same<typename T::integer_type,  typename Base::integer_type >::value &&
+        std::is_same<typename T::floating_type, typename Base::floating_type>::value
+        > check(int);
+    template<typename T, typename Base>
+    static std::false_type check(...);
+};
+template<typename T, typename Base>
+using inherits_number_readers = decltype(inherits_number_readers_impl::check<T, Base>(0));
+
+// The parser reads numbers directly from the source if TC uses parse_int and
+// parse_float of the type_configs defined here. Otherwise, it calls
+// TC::parse_int and TC::parse_float.
+template<typename T>
+struct uses_default_number_readers : cxx::disjunction<
+    inherits_number_readers<T, type_config>,
+    inherits_number_readers<T, ordered_type_config>,
+    inherits_number_readers<T, interned_type_config>,
+#if defined(TOML11_HAS_STD_MEMORY_RESOURCE)
+    inherits_number_readers<T, pmr_type_config>,
+#endif
+    inherits_number_readers<T, arena_type_config>
+    >{};
+
 } // namespace detail
 } // namespace toml
 
@@ -165,6 +165,17 @@ string_conv(const char (&s)[N])
     return string_conv_impl<C, T, A, C2, T2, A2>::template invoke<N>(s);
 }
 
+// a key that is not a std::basic_string but refers to a std::string
+// (e.g. toml::interned_key)
+template<typename S, typename K>
+cxx::enable_if_t<cxx::conjunction<is_std_basic_string<S>, std::is_class<K>,
+    cxx::negation<is_std_basic_string<K>>,
+    std::is_convertible<const K&, std::string const&>>::value, S>
+string_conv(const K& k)
+{
+    return string_conv<S>(static_cast<std::string const&>(k));
+}
+
 } // namespace detail
 } // namespace toml
 #endif // TOML11_UTILITY_HPP
@@ -55,6 +55,65 @@ void change_region_of_value(basic_value<TC>&, const basic_value<TC>&);
 
 template<typename TC, value_t V>
 struct getter;
+
+// TypeConfig::region_type if it is defined. Otherwise, detail::region.
+template<typename TC, bool = has_region_type<TC>::value>
+struct config_region_type
+{
+    using type = region;
+};
+template<typename TC>
+struct config_region_type<TC, true>
+{
+    using type = typename TC::region_type;
+};
+
+// TypeConfig::format_type if it is defined. Otherwise, preserve_format.
+template<typename TC, bool = has_format_type<TC>::value>
+struct config_format_type
+{
+    using type = preserve_format;
+};
+template<typename TC>
+struct config_format_type<TC, true>
+{
+    using type = typename TC::format_type;
+};
+
+// The type returned by the non-const format accessors. With discard_format,
+// the values other than arrays and tables return a copy of the default format.
+template<typename TC, value_t V>
+struct format_reference
+{
+    using format_type = enum_to_fmt_type_t<V>;
+    using type = typename std::conditional<
+        std::is_same<typename config_format_type<TC>::type, discard_format>::value,
+        format_type, format_type&>::type;
+};
+template<typename TC>
+struct format_reference<TC, value_t::array>
+{
+    using type = array_format_info&;
+};
+template<typename TC>
+struct format_reference<TC, value_t::table>
+{
+    using type = table_format_info&;
+};
+template<typename TC, value_t V>
+using format_reference_t = typename format_reference<TC, V>::type;
+
+// TypeConfig::storage_type if it is defined. Otherwise, deep_copy.
+template<typename TC, bool = has_storage_type<TC>::value>
+struct config_storage_type
+{
+    using type = deep_copy;
+};
+template<typename TC>
+struct config_storage_type<TC, true>
+{
+    using type = typename TC::storage_type;
+};
 } // detail
 
 template<typename TypeConfig>
@@ -63,7 +122,7 @@ class basic_value
   public:
 
     using config_type          = TypeConfig;
-    using key_type             = typename config_type::string_type;
+    using key_type             = typename detail::config_key_type<config_type>::type;
     using value_type           = basic_value<config_type>;
     using boolean_type         = typename config_type::boolean_type;
     using integer_type         = typename config_type::integer_type;
@@ -80,12 +139,12 @@ class basic_value
 
   private:
 
-    using region_type = detail::region;
+    using region_type = typename detail::config_region_type<config_type>::type;
 
   public:
 
     basic_value() noexcept
-        : type_(value_t::empty), empty_('\0'), region_{}, comments_{}
+        : type_(value_t::empty), region_{}, empty_('\0'), comments_{}
     {}
     ~basic_value() noexcept {this->cleanup();}
 
@@ -109,7 +168,7 @@ class basic_value
             default                      : assigner(empty_          , '\0'              ); break;
         }
     }
-    basic_value(basic_value&& v)
+    basic_value(basic_value&& v) noexcept(is_nothrow_move_constructible::value)
         : type_(v.type()), region_(std::move(v.region_)),
           comments_(std::move(v.comments_))
     {
@@ -153,7 +212,7 @@ class basic_value
         }
         return *this;
     }
-    basic_value& operator=(basic_value&& v)
+    basic_value& operator=(basic_value&& v) noexcept(is_nothrow_move_assignable::value)
     {
         if(this == std::addressof(v)) {return *this;}
 
@@ -216,7 +275,14 @@ class basic_value
             case value_t::boolean        : assigner(boolean_        , std::move(other.boolean_        )); break;
             case value_t::integer        : assigner(integer_        , std::move(other.integer_        )); break;
             case value_t::floating       : assigner(floating_       , std::move(other.floating_       )); break;
-            case value_t::string         : assigner(string_         , std::move(other.string_         )); break;
+            case value_t::string         :
+            {
+                assigner(string_, string_storage(
+                        convert_string(std::move(other.string_.value)),
+                        std::move(detail::format_of(other.string_))
+                    ));
+                break;
+            }
             case value_t::offset_datetime: assigner(offset_datetime_, std::move(other.offset_datetime_)); break;
             case value_t::local_datetime : assigner(local_datetime_ , std::move(other.local_datetime_ )); break;
             case value_t::local_date     : assigner(local_date_     , std::move(other.local_date_     )); break;
@@ -226,22 +292,25 @@ class basic_value
             case value_t::array          :
             {
                 array_type tmp(
-                    std::make_move_iterator(other.array_.value.get().begin()),
-                    std::make_move_iterator(other.array_.value.get().end()));
+                    std::make_move_iterator(other.array_.value.get_mutable().begin()),
+                    std::make_move_iterator(other.array_.value.get_mutable().end()));
                 assigner(array_, array_storage(
-                        detail::storage<array_type>(std::move(tmp)),
-                        other.array_.format
+                        array_holder(std::move(tmp)),
+                        detail::format_of(other.array_)
                     ));
                 break;
             }
             case value_t::table          :
             {
-                table_type tmp(
-                    std::make_move_iterator(other.table_.value.get().begin()),
-                    std::make_move_iterator(other.table_.value.get().end()));
+                // may have different key type
+                table_type tmp;
+                for(auto& kv : other.table_.value.get_mutable())
+                {
+                    tmp.emplace(convert_string(kv.first), std::move(kv.second));
+                }
                 assigner(table_, table_storage(
-                        detail::storage<table_type>(std::move(tmp)),
-                        other.table_.format
+                        table_holder(std::move(tmp)),
+                        detail::format_of(other.table_)
                     ));
                 break;
             }
@@ -261,7 +330,14 @@ class basic_value
             case value_t::boolean        : assigner(boolean_        , std::move(other.boolean_        )); break;
             case value_t::integer        : assigner(integer_        , std::move(other.integer_        )); break;
             case value_t::floating       : assigner(floating_       , std::move(other.floating_       )); break;
-            case value_t::string         : assigner(string_         , std::move(other.string_         )); break;
+            case value_t::string         :
+            {
+                assigner(string_, string_storage(
+                        convert_string(std::move(other.string_.value)),
+                        std::move(detail::format_of(other.string_))
+                    ));
+                break;
+            }
             case value_t::offset_datetime: assigner(offset_datetime_, std::move(other.offset_datetime_)); break;
             case value_t::local_datetime : assigner(local_datetime_ , std::move(other.local_datetime_ )); break;
             case value_t::local_date     : assigner(local_date_     , std::move(other.local_date_     )); break;
@@ -271,22 +347,25 @@ class basic_value
             case value_t::array          :
             {
                 array_type tmp(
-                    std::make_move_iterator(other.array_.value.get().begin()),
-                    std::make_move_iterator(other.array_.value.get().end()));
+                    std::make_move_iterator(other.array_.value.get_mutable().begin()),
+                    std::make_move_iterator(other.array_.value.get_mutable().end()));
                 assigner(array_, array_storage(
-                        detail::storage<array_type>(std::move(tmp)),
-                        other.array_.format
+                        array_holder(std::move(tmp)),
+                        detail::format_of(other.array_)
                     ));
                 break;
             }
             case value_t::table          :
             {
-                table_type tmp(
-                    std::make_move_iterator(other.table_.value.get().begin()),
-                    std::make_move_iterator(other.table_.value.get().end()));
+                // may have different key type
+                table_type tmp;
+                for(auto& kv : other.table_.value.get_mutable())
+                {
+                    tmp.emplace(convert_string(kv.first), std::move(kv.second));
+                }
                 assigner(table_, table_storage(
-                        detail::storage<table_type>(std::move(tmp)),
-                        other.table_.format
+                        table_holder(std::move(tmp)),
+                        detail::format_of(other.table_)
                     ));
                 break;
             }
@@ -306,7 +385,14 @@ class basic_value
             case value_t::boolean        : assigner(boolean_        , std::move(other.boolean_        )); break;
             case value_t::integer        : assigner(integer_        , std::move(other.integer_        )); break;
             case value_t::floating       : assigner(floating_       , std::move(other.floating_       )); break;
-            case value_t::string         : assigner(string_         , std::move(other.string_         )); break;
+            case value_t::string         :
+            {
+                assigner(string_, string_storage(
+                        convert_string(std::move(other.string_.value)),
+                        std::move(detail::format_of(other.string_))
+                    ));
+                break;
+            }
             case value_t::offset_datetime: assigner(offset_datetime_, std::move(other.offset_datetime_)); break;
             case value_t::local_datetime : assigner(local_datetime_ , std::move(other.local_datetime_ )); break;
             case value_t::local_date     : assigner(local_date_     , std::move(other.local_date_     )); break;
@@ -316,22 +402,25 @@ class basic_value
             case value_t::array          :
             {
                 array_type tmp(
-                    std::make_move_iterator(other.array_.value.get().begin()),
-                    std::make_move_iterator(other.array_.value.get().end()));
+                    std::make_move_iterator(other.array_.value.get_mutable().begin()),
+                    std::make_move_iterator(other.array_.value.get_mutable().end()));
                 assigner(array_, array_storage(
-                        detail::storage<array_type>(std::move(tmp)),
-                        other.array_.format
+                        array_holder(std::move(tmp)),
+                        detail::format_of(other.array_)
                     ));
                 break;
             }
             case value_t::table          :
             {
-                table_type tmp(
-                    std::make_move_iterator(other.table_.value.get().begin()),
-                    std::make_move_iterator(other.table_.value.get().end()));
+                // may have different key type
+                table_type tmp;
+                for(auto& kv : other.table_.value.get_mutable())
+                {
+                    tmp.emplace(convert_string(kv.first), std::move(kv.second));
+                }
                 assigner(table_, table_storage(
-                        detail::storage<table_type>(std::move(tmp)),
-                        other.table_.format
+                        table_holder(std::move(tmp)),
+                        detail::format_of(other.table_)
                     ));
                 break;
             }
@@ -357,8 +446,8 @@ class basic_value
     {}
     basic_value(boolean_type x, boolean_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::boolean), boolean_(boolean_storage(x, fmt)),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::boolean), region_(std::move(reg)),
+          boolean_(boolean_storage(x, fmt)), comments_(std::move(com))
     {}
     basic_value& operator=(boolean_type x)
     {
@@ -391,8 +480,8 @@ class basic_value
         : basic_value(std::move(x), std::move(fmt), std::move(com), region_type{})
     {}
     basic_value(integer_type x, integer_format_info fmt, std::vector<std::string> com, region_type reg)
-        : type_(value_t::integer), integer_(integer_storage(std::move(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::integer), region_(std::move(reg)),
+          integer_(integer_storage(std::move(x), std::move(fmt))), comments_(std::move(com))
     {}
     basic_value& operator=(integer_type x)
     {
@@ -437,8 +526,8 @@ class basic_value
     {}
     template<typename T, enable_if_integer_like_t<T> = nullptr>
     basic_value(T x, integer_format_info fmt, std::vector<std::string> com, region_type reg)
-        : type_(value_t::integer), integer_(integer_storage(std::move(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::integer), region_(std::move(reg)),
+          integer_(integer_storage(std::move(x), std::move(fmt))), comments_(std::move(com))
     {}
     template<typename T, enable_if_integer_like_t<T> = nullptr>
     basic_value& operator=(T x)
@@ -472,8 +561,8 @@ class basic_value
         : basic_value(std::move(x), std::move(fmt), std::move(com), region_type{})
     {}
     basic_value(floating_type x, floating_format_info fmt, std::vector<std::string> com, region_type reg)
-        : type_(value_t::floating), floating_(floating_storage(std::move(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::floating), region_(std::move(reg)),
+          floating_(floating_storage(std::move(x), std::move(fmt))), comments_(std::move(com))
     {}
     basic_value& operator=(floating_type x)
     {
@@ -521,8 +610,8 @@ class basic_value
 
     template<typename T, enable_if_floating_like_t<T> = nullptr>
     basic_value(T x, floating_format_info fmt, std::vector<std::string> com, region_type reg)
-        : type_(value_t::floating), floating_(floating_storage(x, std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::floating), region_(std::move(reg)),
+          floating_(floating_storage(x, std::move(fmt))), comments_(std::move(com))
     {}
 
     template<typename T, enable_if_floating_like_t<T> = nullptr>
@@ -558,8 +647,8 @@ class basic_value
     {}
     basic_value(string_type x, string_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::string), string_(string_storage(std::move(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::string), region_(std::move(reg)),
+          string_(string_storage(std::move(x), std::move(fmt))), comments_(std::move(com))
     {}
     basic_value& operator=(string_type x)
     {
@@ -591,8 +680,8 @@ class basic_value
     {}
     basic_value(const typename string_type::value_type* x, string_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::string), string_(string_storage(string_type(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::string), region_(std::move(reg)),
+          string_(string_storage(string_type(x), std::move(fmt))), comments_(std::move(com))
     {}
     basic_value& operator=(const typename string_type::value_type* x)
     {
@@ -626,8 +715,8 @@ class basic_value
     {}
     basic_value(string_view_type x, string_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::string), string_(string_storage(string_type(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::string), region_(std::move(reg)),
+          string_(string_storage(string_type(x), std::move(fmt))), comments_(std::move(com))
     {}
     basic_value& operator=(string_view_type x)
     {
@@ -679,9 +768,9 @@ class basic_value
         >::value, std::nullptr_t> = nullptr>
     basic_value(const T& x, string_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::string),
+        : type_(value_t::string), region_(std::move(reg)),
           string_(string_storage(detail::string_conv<string_type>(x), std::move(fmt))),
-          region_(std::move(reg)), comments_(std::move(com))
+          comments_(std::move(com))
     {}
     template<typename T, cxx::enable_if_t<cxx::conjunction<
             cxx::negation<std::is_same<cxx::remove_cvref_t<T>, string_type>>,
@@ -719,8 +808,8 @@ class basic_value
     {}
     basic_value(local_date_type x, local_date_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::local_date), local_date_(local_date_storage(x, fmt)),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::local_date), region_(std::move(reg)),
+          local_date_(local_date_storage(x, fmt)), comments_(std::move(com))
     {}
     basic_value& operator=(local_date_type x)
     {
@@ -754,8 +843,8 @@ class basic_value
     {}
     basic_value(local_time_type x, local_time_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::local_time), local_time_(local_time_storage(x, fmt)),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::local_time), region_(std::move(reg)),
+          local_time_(local_time_storage(x, fmt)), comments_(std::move(com))
     {}
     basic_value& operator=(local_time_type x)
     {
@@ -826,8 +915,8 @@ class basic_value
     {}
     basic_value(local_datetime_type x, local_datetime_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::local_datetime), local_datetime_(local_datetime_storage(x, fmt)),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::local_datetime), region_(std::move(reg)),
+          local_datetime_(local_datetime_storage(x, fmt)), comments_(std::move(com))
     {}
     basic_value& operator=(local_datetime_type x)
     {
@@ -861,8 +950,8 @@ class basic_value
     {}
     basic_value(offset_datetime_type x, offset_datetime_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::offset_datetime), offset_datetime_(offset_datetime_storage(x, fmt)),
-          region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::offset_datetime), region_(std::move(reg)),
+          offset_datetime_(offset_datetime_storage(x, fmt)), comments_(std::move(com))
     {}
     basic_value& operator=(offset_datetime_type x)
     {
@@ -928,9 +1017,9 @@ class basic_value
     {}
     basic_value(array_type x, array_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::array), array_(array_storage(
-              detail::storage<array_type>(std::move(x)), std::move(fmt)
-          )), region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::array), region_(std::move(reg)), array_(array_storage(
+              array_holder(std::move(x)), std::move(fmt)
+          )), comments_(std::move(com))
     {}
     basic_value& operator=(array_type x)
     {
@@ -943,7 +1032,7 @@ class basic_value
         this->type_   = value_t::array;
         this->region_ = region_type{};
         assigner(this->array_, array_storage(
-                    detail::storage<array_type>(std::move(x)), std::move(fmt)));
+                    array_holder(std::move(x)), std::move(fmt)));
         return *this;
     }
 
@@ -982,12 +1071,12 @@ class basic_value
     template<typename T, enable_if_array_like_t<T> = nullptr>
     basic_value(T x, array_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::array), array_(array_storage(
-              detail::storage<array_type>(array_type(
+        : type_(value_t::array), region_(std::move(reg)), array_(array_storage(
+              array_holder(array_type(
                       std::make_move_iterator(x.begin()),
                       std::make_move_iterator(x.end()))
               ), std::move(fmt)
-          )), region_(std::move(reg)), comments_(std::move(com))
+          )), comments_(std::move(com))
     {}
     template<typename T, enable_if_array_like_t<T> = nullptr>
     basic_value& operator=(T x)
@@ -1004,7 +1093,7 @@ class basic_value
         array_type a(std::make_move_iterator(x.begin()),
                      std::make_move_iterator(x.end()));
         assigner(this->array_, array_storage(
-                    detail::storage<array_type>(std::move(a)), std::move(fmt)));
+                    array_holder(std::move(a)), std::move(fmt)));
         return *this;
     }
 
@@ -1026,9 +1115,9 @@ class basic_value
     {}
     basic_value(table_type x, table_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::table), table_(table_storage(
-                detail::storage<table_type>(std::move(x)), std::move(fmt)
-          )), region_(std::move(reg)), comments_(std::move(com))
+        : type_(value_t::table), region_(std::move(reg)), table_(table_storage(
+                table_holder(std::move(x)), std::move(fmt)
+          )), comments_(std::move(com))
     {}
     basic_value& operator=(table_type x)
     {
@@ -1041,7 +1130,7 @@ class basic_value
         this->type_   = value_t::table;
         this->region_ = region_type{};
         assigner(this->table_, table_storage(
-            detail::storage<table_type>(std::move(x)), std::move(fmt)));
+            table_holder(std::move(x)), std::move(fmt)));
         return *this;
     }
 
@@ -1078,12 +1167,12 @@ class basic_value
     template<typename T, enable_if_table_like_t<T> = nullptr>
     basic_value(T x, table_format_info fmt,
                 std::vector<std::string> com, region_type reg)
-        : type_(value_t::table), table_(table_storage(
-              detail::storage<table_type>(table_type(
+        : type_(value_t::table), region_(std::move(reg)), table_(table_storage(
+              table_holder(table_type(
                       std::make_move_iterator(x.begin()),
                       std::make_move_iterator(x.end())
               )), std::move(fmt)
-          )), region_(std::move(reg)), comments_(std::move(com))
+          )), comments_(std::move(com))
     {}
     template<typename T, enable_if_table_like_t<T> = nullptr>
     basic_value& operator=(T x)
@@ -1100,7 +1189,7 @@ class basic_value
         table_type t(std::make_move_iterator(x.begin()),
                      std::make_move_iterator(x.end()));
         assigner(this->table_, table_storage(
-            detail::storage<table_type>(std::move(t)), std::move(fmt)));
+            table_holder(std::move(t)), std::move(fmt)));
         return *this;
     }
 
@@ -1180,7 +1269,7 @@ class basic_value
 
     // mainly for `null` extension
     basic_value(detail::none_t, region_type reg) noexcept
-        : type_(value_t::empty), empty_('\0'), region_(std::move(reg)), comments_{}
+        : type_(value_t::empty), region_(std::move(reg)), empty_('\0'), comments_{}
     {}
 
     // }}}
@@ -1243,7 +1332,8 @@ class basic_value
     }
     template<value_t T>
     detail::enum_to_type_t<T, basic_value<config_type>>&
-    as(const std::nothrow_t&) noexcept
+    as(const std::nothrow_t&) noexcept(noexcept(
+        detail::getter<config_type, T>::get_nothrow(std::declval<basic_value&>())))
     {
         return detail::getter<config_type, T>::get_nothrow(*this);
     }
@@ -1267,8 +1357,18 @@ class basic_value
     local_datetime_type & as_local_datetime (const std::nothrow_t&) noexcept {return this->local_datetime_.value;}
     local_date_type     & as_local_date     (const std::nothrow_t&) noexcept {return this->local_date_.value;}
     local_time_type     & as_local_time     (const std::nothrow_t&) noexcept {return this->local_time_.value;}
-    array_type          & as_array          (const std::nothrow_t&) noexcept {return this->array_.value.get();}
-    table_type          & as_table          (const std::nothrow_t&) noexcept {return this->table_.value.get();}
+
+    // with copy_on_write, these copy a shared array or table and may throw
+    array_type& as_array(const std::nothrow_t&)
+        noexcept(noexcept(std::declval<array_holder&>().get_mutable()))
+    {
+        return this->array_.value.get_mutable();
+    }
+    table_type& as_table(const std::nothrow_t&)
+        noexcept(noexcept(std::declval<table_holder&>().get_mutable()))
+    {
+        return this->table_.value.get_mutable();
+    }
 
     // }}}
 
@@ -1439,7 +1539,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_array()", value_t::array);
         }
-        return this->array_.value.get();
+        return this->array_.value.get_mutable();
     }
     table_type& as_table()
     {
@@ -1447,7 +1547,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_table()", value_t::table);
         }
-        return this->table_.value.get();
+        return this->table_.value.get_mutable();
     }
 
     // }}}
@@ -1461,33 +1561,33 @@ class basic_value
         return detail::getter<config_type, T>::get_fmt_nothrow(*this);
     }
     template<value_t T>
-    detail::enum_to_fmt_type_t<T>&
+    detail::format_reference_t<config_type, T>
     as_fmt(const std::nothrow_t&) noexcept
     {
         return detail::getter<config_type, T>::get_fmt_nothrow(*this);
     }
 
-    boolean_format_info        & as_boolean_fmt        (const std::nothrow_t&) noexcept {return this->boolean_.format;}
-    integer_format_info        & as_integer_fmt        (const std::nothrow_t&) noexcept {return this->integer_.format;}
-    floating_format_info       & as_floating_fmt       (const std::nothrow_t&) noexcept {return this->floating_.format;}
-    string_format_info         & as_string_fmt         (const std::nothrow_t&) noexcept {return this->string_.format;}
-    offset_datetime_format_info& as_offset_datetime_fmt(const std::nothrow_t&) noexcept {return this->offset_datetime_.format;}
-    local_datetime_format_info & as_local_datetime_fmt (const std::nothrow_t&) noexcept {return this->local_datetime_.format;}
-    local_date_format_info     & as_local_date_fmt     (const std::nothrow_t&) noexcept {return this->local_date_.format;}
-    local_time_format_info     & as_local_time_fmt     (const std::nothrow_t&) noexcept {return this->local_time_.format;}
-    array_format_info          & as_array_fmt          (const std::nothrow_t&) noexcept {return this->array_.format;}
-    table_format_info          & as_table_fmt          (const std::nothrow_t&) noexcept {return this->table_.format;}
-
-    boolean_format_info         const& as_boolean_fmt        (const std::nothrow_t&) const noexcept {return this->boolean_.format;}
-    integer_format_info         const& as_integer_fmt        (const std::nothrow_t&) const noexcept {return this->integer_.format;}
-    floating_format_info        const& as_floating_fmt       (const std::nothrow_t&) const noexcept {return this->floating_.format;}
-    string_format_info          const& as_string_fmt         (const std::nothrow_t&) const noexcept {return this->string_.format;}
-    offset_datetime_format_info const& as_offset_datetime_fmt(const std::nothrow_t&) const noexcept {return this->offset_datetime_.format;}
-    local_datetime_format_info  const& as_local_datetime_fmt (const std::nothrow_t&) const noexcept {return this->local_datetime_.format;}
-    local_date_format_info      const& as_local_date_fmt     (const std::nothrow_t&) const noexcept {return this->local_date_.format;}
-    local_time_format_info      const& as_local_time_fmt     (const std::nothrow_t&) const noexcept {return this->local_time_.format;}
-    array_format_info           const& as_array_fmt          (const std::nothrow_t&) const noexcept {return this->array_.format;}
-    table_format_info           const& as_table_fmt          (const std::nothrow_t&) const noexcept {return this->table_.format;}
+    detail::format_reference_t<config_type, value_t::boolean        > as_boolean_fmt        (const std::nothrow_t&) noexcept {return detail::format_of(this->boolean_);}
+    detail::format_reference_t<config_type, value_t::integer        > as_integer_fmt        (const std::nothrow_t&) noexcept {return detail::format_of(this->integer_);}
+    detail::format_reference_t<config_type, value_t::floating       > as_floating_fmt       (const std::nothrow_t&) noexcept {return detail::format_of(this->floating_);}
+    detail::format_reference_t<config_type, value_t::string         > as_string_fmt         (const std::nothrow_t&) noexcept {return detail::format_of(this->string_);}
+    detail::format_reference_t<config_type, value_t::offset_datetime> as_offset_datetime_fmt(const std::nothrow_t&) noexcept {return detail::format_of(this->offset_datetime_);}
+    detail::format_reference_t<config_type, value_t::local_datetime > as_local_datetime_fmt (const std::nothrow_t&) noexcept {return detail::format_of(this->local_datetime_);}
+    detail::format_reference_t<config_type, value_t::local_date     > as_local_date_fmt     (const std::nothrow_t&) noexcept {return detail::format_of(this->local_date_);}
+    detail::format_reference_t<config_type, value_t::local_time     > as_local_time_fmt     (const std::nothrow_t&) noexcept {return detail::format_of(this->local_time_);}
+    array_format_info          & as_array_fmt          (const std::nothrow_t&) noexcept {return detail::format_of(this->array_);}
+    table_format_info          & as_table_fmt          (const std::nothrow_t&) noexcept {return detail::format_of(this->table_);}
+
+    boolean_format_info         const& as_boolean_fmt        (const std::nothrow_t&) const noexcept {return detail::format_of(this->boolean_);}
+    integer_format_info         const& as_integer_fmt        (const std::nothrow_t&) const noexcept {return detail::format_of(this->integer_);}
+    floating_format_info        const& as_floating_fmt       (const std::nothrow_t&) const noexcept {return detail::format_of(this->floating_);}
+    string_format_info          const& as_string_fmt         (const std::nothrow_t&) const noexcept {return detail::format_of(this->string_);}
+    offset_datetime_format_info const& as_offset_datetime_fmt(const std::nothrow_t&) const noexcept {return detail::format_of(this->offset_datetime_);}
+    local_datetime_format_info  const& as_local_datetime_fmt (const std::nothrow_t&) const noexcept {return detail::format_of(this->local_datetime_);}
+    local_date_format_info      const& as_local_date_fmt     (const std::nothrow_t&) const noexcept {return detail::format_of(this->local_date_);}
+    local_time_format_info      const& as_local_time_fmt     (const std::nothrow_t&) const noexcept {return detail::format_of(this->local_time_);}
+    array_format_info           const& as_array_fmt          (const std::nothrow_t&) const noexcept {return detail::format_of(this->array_);}
+    table_format_info           const& as_table_fmt          (const std::nothrow_t&) const noexcept {return detail::format_of(this->table_);}
 
     // }}}
 
@@ -1499,7 +1599,7 @@ class basic_value
         return detail::getter<config_type, T>::get_fmt(*this);
     }
     template<value_t T>
-    detail::enum_to_fmt_type_t<T>& as_fmt()
+    detail::format_reference_t<config_type, T> as_fmt()
     {
         return detail::getter<config_type, T>::get_fmt(*this);
     }
@@ -1510,7 +1610,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_boolean_fmt()", value_t::boolean);
         }
-        return this->boolean_.format;
+        return detail::format_of(this->boolean_);
     }
     integer_format_info const& as_integer_fmt() const
     {
@@ -1518,7 +1618,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_integer_fmt()", value_t::integer);
         }
-        return this->integer_.format;
+        return detail::format_of(this->integer_);
     }
     floating_format_info const& as_floating_fmt() const
     {
@@ -1526,7 +1626,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_floating_fmt()", value_t::floating);
         }
-        return this->floating_.format;
+        return detail::format_of(this->floating_);
     }
     string_format_info const& as_string_fmt() const
     {
@@ -1534,7 +1634,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_string_fmt()", value_t::string);
         }
-        return this->string_.format;
+        return detail::format_of(this->string_);
     }
     offset_datetime_format_info const& as_offset_datetime_fmt() const
     {
@@ -1542,7 +1642,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_offset_datetime_fmt()", value_t::offset_datetime);
         }
-        return this->offset_datetime_.format;
+        return detail::format_of(this->offset_datetime_);
     }
     local_datetime_format_info const& as_local_datetime_fmt() const
     {
@@ -1550,7 +1650,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_local_datetime_fmt()", value_t::local_datetime);
         }
-        return this->local_datetime_.format;
+        return detail::format_of(this->local_datetime_);
     }
     local_date_format_info const& as_local_date_fmt() const
     {
@@ -1558,7 +1658,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_local_date_fmt()", value_t::local_date);
         }
-        return this->local_date_.format;
+        return detail::format_of(this->local_date_);
     }
     local_time_format_info const& as_local_time_fmt() const
     {
@@ -1566,7 +1666,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_local_time_fmt()", value_t::local_time);
         }
-        return this->local_time_.format;
+        return detail::format_of(this->local_time_);
     }
     array_format_info const& as_array_fmt() const
     {
@@ -1574,7 +1674,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_array_fmt()", value_t::array);
         }
-        return this->array_.format;
+        return detail::format_of(this->array_);
     }
     table_format_info const& as_table_fmt() const
     {
@@ -1582,75 +1682,75 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_table_fmt()", value_t::table);
         }
-        return this->table_.format;
+        return detail::format_of(this->table_);
     }
 
     // ------------------------------------------------------------------------
     // nonconst reference
 
-    boolean_format_info& as_boolean_fmt()
+    detail::format_reference_t<config_type, value_t::boolean> as_boolean_fmt()
     {
         if(this->type_ != value_t::boolean)
         {
             this->throw_bad_cast("toml::value::as_boolean_fmt()", value_t::boolean);
         }
-        return this->boolean_.format;
+        return detail::format_of(this->boolean_);
     }
-    integer_format_info& as_integer_fmt()
+    detail::format_reference_t<config_type, value_t::integer> as_integer_fmt()
     {
         if(this->type_ != value_t::integer)
         {
             this->throw_bad_cast("toml::value::as_integer_fmt()", value_t::integer);
         }
-        return this->integer_.format;
+        return detail::format_of(this->integer_);
     }
-    floating_format_info& as_floating_fmt()
+    detail::format_reference_t<config_type, value_t::floating> as_floating_fmt()
     {
         if(this->type_ != value_t::floating)
         {
             this->throw_bad_cast("toml::value::as_floating_fmt()", value_t::floating);
         }
-        return this->floating_.format;
+        return detail::format_of(this->floating_);
     }
-    string_format_info& as_string_fmt()
+    detail::format_reference_t<config_type, value_t::string> as_string_fmt()
     {
         if(this->type_ != value_t::string)
         {
             this->throw_bad_cast("toml::value::as_string_fmt()", value_t::string);
         }
-        return this->string_.format;
+        return detail::format_of(this->string_);
     }
-    offset_datetime_format_info& as_offset_datetime_fmt()
+    detail::format_reference_t<config_type, value_t::offset_datetime> as_offset_datetime_fmt()
     {
         if(this->type_ != value_t::offset_datetime)
         {
             this->throw_bad_cast("toml::value::as_offset_datetime_fmt()", value_t::offset_datetime);
         }
-        return this->offset_datetime_.format;
+        return detail::format_of(this->offset_datetime_);
     }
-    local_datetime_format_info& as_local_datetime_fmt()
+    detail::format_reference_t<config_type, value_t::local_datetime> as_local_datetime_fmt()
     {
         if(this->type_ != value_t::local_datetime)
         {
             this->throw_bad_cast("toml::value::as_local_datetime_fmt()", value_t::local_datetime);
         }
-        return this->local_datetime_.format;
+        return detail::format_of(this->local_datetime_);
     }
-    local_date_format_info& as_local_date_fmt()
+    detail::format_reference_t<config_type, value_t::local_date> as_local_date_fmt()
     {
         if(this->type_ != value_t::local_date)
         {
             this->throw_bad_cast("toml::value::as_local_date_fmt()", value_t::local_date);
         }
-        return this->local_date_.format;
+        return detail::format_of(this->local_date_);
     }
-    local_time_format_info& as_local_time_fmt()
+    detail::format_reference_t<config_type, value_t::local_time> as_local_time_fmt()
     {
         if(this->type_ != value_t::local_time)
         {
             this->throw_bad_cast("toml::value::as_local_time_fmt()", value_t::local_time);
         }
-        return this->local_time_.format;
+        return detail::format_of(this->local_time_);
     }
     array_format_info& as_array_fmt()
     {
@@ -1658,7 +1758,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_array_fmt()", value_t::array);
         }
-        return this->array_.format;
+        return detail::format_of(this->array_);
     }
     table_format_info& as_table_fmt()
     {
@@ -1666,7 +1766,7 @@ class basic_value
         {
             this->throw_bad_cast("toml::value::as_table_fmt()", value_t::table);
         }
-        return this->table_.format;
+        return detail::format_of(this->table_);
     }
     // }}}
 
@@ -1777,7 +1877,8 @@ class basic_value
         return ar.at(idx);
     }
 
-    value_type&       operator[](const std::size_t idx) noexcept
+    value_type&       operator[](const std::size_t idx)
+        noexcept(noexcept(std::declval<basic_value&>().as_array(std::nothrow)))
     {
         // no check...
         return this->as_array(std::nothrow)[idx];
@@ -1880,6 +1981,14 @@ class basic_value
         return;
     }
 
+    // converts a string (or a key) of another type_config
+    static string_type convert_string(string_type s) {return s;}
+    template<typename S>
+    static string_type convert_string(const S& s)
+    {
+        return string_type(s.begin(), s.end());
+    }
+
     template<typename T, typename U>
     static void assigner(T& dst, U&& v)
     {
@@ -1912,20 +2021,52 @@ class basic_value
 
   private:
 
-    using boolean_storage         = detail::value_with_format<boolean_type,                boolean_format_info        >;
-    using integer_storage         = detail::value_with_format<integer_type,                integer_format_info        >;
-    using floating_storage        = detail::value_with_format<floating_type,               floating_format_info       >;
-    using string_storage          = detail::value_with_format<string_type,                 string_format_info         >;
-    using offset_datetime_storage = detail::value_with_format<offset_datetime_type,        offset_datetime_format_info>;
-    using local_datetime_storage  = detail::value_with_format<local_datetime_type,         local_datetime_format_info >;
-    using local_date_storage      = detail::value_with_format<local_date_type,             local_date_format_info     >;
-    using local_time_storage      = detail::value_with_format<local_time_type,             local_time_format_info     >;
-    using array_storage           = detail::value_with_format<detail::storage<array_type>, array_format_info          >;
-    using table_storage           = detail::value_with_format<detail::storage<table_type>, table_format_info          >;
+    using format_policy = typename detail::config_format_type<config_type>::type;
+
+    using boolean_storage         = typename detail::format_storage<boolean_type,         boolean_format_info,         format_policy>::type;
+    using integer_storage         = typename detail::format_storage<integer_type,         integer_format_info,         format_policy>::type;
+    using floating_storage        = typename detail::format_storage<floating_type,        floating_format_info,        format_policy>::type;
+    using string_storage          = typename detail::format_storage<string_type,          string_format_info,          format_policy>::type;
+    using offset_datetime_storage = typename detail::format_storage<offset_datetime_type, offset_datetime_format_info, format_policy>::type;
+    using local_datetime_storage  = typename detail::format_storage<local_datetime_type,  local_datetime_format_info,  format_policy>::type;
+    using local_date_storage      = typename detail::format_storage<local_date_type,      local_date_format_info,      format_policy>::type;
+    using local_time_storage      = typename detail::format_storage<local_time_type,      local_time_format_info,      format_policy>::type;
+    using storage_policy = typename detail::config_storage_type<config_type>::type;
+
+    using array_holder = typename detail::storage_of<array_type, storage_policy>::type;
+    using table_holder = typename detail::storage_of<table_type, storage_policy>::type;
+
+    // the parser needs the formats of arrays and tables. they are always stored.
+    using array_storage           = detail::value_with_format<array_holder, array_format_info          >;
+    using table_storage           = detail::value_with_format<table_holder, table_format_info          >;
+
+    // moving a value move-assigns (or constructs) the region and the comments,
+    // and move-constructs one of the storages. They are noexcept if all of
+    // those are.
+    using is_nothrow_move_constructible = cxx::conjunction<
+        std::is_nothrow_move_constructible<region_type>,
+        std::is_nothrow_move_constructible<comment_type>,
+        std::is_nothrow_move_constructible<boolean_storage>,
+        std::is_nothrow_move_constructible<integer_storage>,
+        std::is_nothrow_move_constructible<floating_storage>,
+        std::is_nothrow_move_constructible<string_storage>,
+        std::is_nothrow_move_constructible<offset_datetime_storage>,
+        std::is_nothrow_move_constructible<local_datetime_storage>,
+        std::is_nothrow_move_constructible<local_date_storage>,
+        std::is_nothrow_move_constructible<local_time_storage>,
+        std::is_nothrow_move_constructible<array_storage>,
+        std::is_nothrow_move_constructible<table_storage>
+        >;
+    using is_nothrow_move_assignable = cxx::conjunction<
+        std::is_nothrow_move_assignable<region_type>,
+        std::is_nothrow_move_assignable<comment_type>,
+        is_nothrow_move_constructible
+        >;
 
   private:
 
-    value_t type_;
+    value_t      type_;
+    region_type  region_; // next to type_ so that discard_region fits in the padding
     union
     {
         char                    empty_; // the smallest type
@@ -1940,7 +2081,6 @@ class basic_value
         array_storage           array_;
         table_storage           table_;
     };
-    region_type  region_;
     comment_type comments_;
 };
 
@@ -2194,6 +2334,7 @@ error_info make_not_found_error(const basic_value<TC>& v, const std::string& fna
         using value_type = basic_value<TC>;                                     \
         using result_type = enum_to_type_t<value_t::ty, value_type>;            \
         using format_type = enum_to_fmt_type_t<value_t::ty>;                    \
+        using format_reference = format_reference_t<TC, value_t::ty>;           \
                                                                                 \
         static result_type&       get(value_type& v)                            \
         {                                                                       \
@@ -2204,7 +2345,8 @@ error_info make_not_found_error(const basic_value<TC>& v, const std::string& fna
             return v.as_ ## ty();                                               \
         }                                                                       \
                                                                                 \
-        static result_type&       get_nothrow(value_type& v) noexcept           \
+        static result_type&       get_nothrow(value_type& v)                    \
+            noexcept(noexcept(v.as_ ## ty(std::nothrow)))                       \
         {                                                                       \
             return v.as_ ## ty(std::nothrow);                                   \
         }                                                                       \
@@ -2213,7 +2355,7 @@ error_info make_not_found_error(const basic_value<TC>& v, const std::string& fna
             return v.as_ ## ty(std::nothrow);                                   \
         }                                                                       \
                                                                                 \
-        static format_type&       get_fmt(value_type& v)                        \
+        static format_reference   get_fmt(value_type& v)                        \
         {                                                                       \
             return v.as_ ## ty ## _fmt();                                       \
         }                                                                       \
@@ -2222,7 +2364,7 @@ error_info make_not_found_error(const basic_value<TC>& v, const std::string& fna
             return v.as_ ## ty ## _fmt();                                       \
         }                                                                       \
                                                                                 \
-        static format_type&       get_fmt_nothrow(value_type& v) noexcept       \
+        static format_reference   get_fmt_nothrow(value_type& v) noexcept       \
         {                                                                       \
             return v.as_ ## ty ## _fmt(std::nothrow);                           \
         }                                                                       \
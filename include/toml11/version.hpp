@@ -83,6 +83,31 @@
 #  endif
 #endif
 
+#ifndef TOML11_DISABLE_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define TOML11_HAS_SSE2 1
+#  endif
+#  if defined(__AVX2__)
+#    define TOML11_HAS_AVX2 1
+#  endif
+#endif
+
+#ifndef TOML11_DISABLE_MMAP
+#  if defined(_WIN32)
+#    define TOML11_HAS_WIN32_MMAP 1
+#  elif defined(__unix__) || defined(__APPLE__)
+#    define TOML11_HAS_POSIX_MMAP 1
+#  endif
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#  define TOML11_HAS_POSIX_FD 1
+#endif
+
+#ifndef TOML11_DISABLE_THREADS
+#  define TOML11_HAS_THREADS 1
+#endif
+
 #if defined(TOML11_COMPILE_SOURCES)
 #  define TOML11_INLINE
 #else
@@ -0,0 +1,5 @@
+#include <toml11/impl/arena_impl.hpp>
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#error "Define `TOML11_COMPILE_SOURCES` before compiling source code!"
+#endif
@@ -0,0 +1,12 @@
+#include <toml11/lazy_document.hpp>
+#include <toml11/types.hpp>
+
+#if ! defined(TOML11_COMPILE_SOURCES)
+#error "Define `TOML11_COMPILE_SOURCES` before compiling source code!"
+#endif
+
+namespace toml
+{
+template class lazy_document<::toml::type_config>;
+template class lazy_document<::toml::ordered_type_config>;
+} // toml
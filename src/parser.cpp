@@ -12,25 +12,81 @@ template result<basic_value<type_config>, std::vector<error_info>> try_parse<typ
 template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::istream&, std::string, spec);
 template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::string, spec);
 template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(FILE*, std::string, spec);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(const unsigned char*, const std::size_t, std::string, spec);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_mmap<type_config>(std::string, spec);
 template result<basic_value<type_config>, std::vector<error_info>> try_parse_str<type_config>(std::string, spec, cxx::source_location);
 
 template basic_value<type_config> parse<type_config>(std::vector<unsigned char>, std::string, spec);
 template basic_value<type_config> parse<type_config>(std::istream&, std::string, spec);
 template basic_value<type_config> parse<type_config>(std::string, spec);
 template basic_value<type_config> parse<type_config>(FILE*, std::string, spec);
+template basic_value<type_config> parse<type_config>(const unsigned char*, const std::size_t, std::string, spec);
+template basic_value<type_config> parse_mmap<type_config>(std::string, spec);
 template basic_value<type_config> parse_str<type_config>(std::string, spec, cxx::source_location);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse<type_config>(std::string, spec, const key_selection&);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_str<type_config>(std::string, spec, const key_selection&, cxx::source_location);
+template basic_value<type_config> parse<type_config>(std::string, spec, const key_selection&);
+template basic_value<type_config> parse_str<type_config>(std::string, spec, const key_selection&, cxx::source_location);
+template result<basic_value<type_config>, parse_failure> try_parse<type_config>(std::string, spec, fail_fast_t);
+template result<basic_value<type_config>, parse_failure> try_parse_str<type_config>(std::string, spec, fail_fast_t, cxx::source_location);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_parallel<type_config>(std::string, spec, const std::size_t);
+template basic_value<type_config> parse_parallel<type_config>(std::string, spec, const std::size_t);
+template std::vector<result<basic_value<type_config>, std::vector<error_info>>> try_parse_many<type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+template std::vector<basic_value<type_config>> parse_many<type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+template result<detail::none_t, std::vector<error_info>> try_parse_events<type_config>(event_handler<type_config>&, std::string, spec);
+template result<detail::none_t, std::vector<error_info>> try_parse_events<type_config>(event_handler<type_config>&, std::istream&, std::string, spec);
+template result<detail::none_t, std::vector<error_info>> try_parse_events_str<type_config>(event_handler<type_config>&, std::string, spec, cxx::source_location);
+template void parse_events<type_config>(event_handler<type_config>&, std::string, spec);
+template void parse_events<type_config>(event_handler<type_config>&, std::istream&, std::string, spec);
+template void parse_events_str<type_config>(event_handler<type_config>&, std::string, spec, cxx::source_location);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(std::istream&, std::string, spec);
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(FILE*, std::string, spec);
+template basic_value<type_config> parse_stream<type_config>(std::istream&, std::string, spec);
+template basic_value<type_config> parse_stream<type_config>(FILE*, std::string, spec);
+#if defined(TOML11_HAS_POSIX_FD)
+template result<basic_value<type_config>, std::vector<error_info>> try_parse_stream<type_config>(const int, std::string, spec);
+template basic_value<type_config> parse_stream<type_config>(const int, std::string, spec);
+#endif
 
 template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::istream&, std::string, spec);
 template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::string, spec);
 template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(FILE*, std::string, spec);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(const unsigned char*, const std::size_t, std::string, spec);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_mmap<ordered_type_config>(std::string, spec);
 template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
 
 template basic_value<ordered_type_config> parse<ordered_type_config>(std::vector<unsigned char>, std::string, spec);
 template basic_value<ordered_type_config> parse<ordered_type_config>(std::istream&, std::string, spec);
 template basic_value<ordered_type_config> parse<ordered_type_config>(std::string, spec);
 template basic_value<ordered_type_config> parse<ordered_type_config>(FILE*, std::string, spec);
+template basic_value<ordered_type_config> parse<ordered_type_config>(const unsigned char*, const std::size_t, std::string, spec);
+template basic_value<ordered_type_config> parse_mmap<ordered_type_config>(std::string, spec);
 template basic_value<ordered_type_config> parse_str<ordered_type_config>(std::string, spec, cxx::source_location);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse<ordered_type_config>(std::string, spec, const key_selection&);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_str<ordered_type_config>(std::string, spec, const key_selection&, cxx::source_location);
+template basic_value<ordered_type_config> parse<ordered_type_config>(std::string, spec, const key_selection&);
+template basic_value<ordered_type_config> parse_str<ordered_type_config>(std::string, spec, const key_selection&, cxx::source_location);
+template result<basic_value<ordered_type_config>, parse_failure> try_parse<ordered_type_config>(std::string, spec, fail_fast_t);
+template result<basic_value<ordered_type_config>, parse_failure> try_parse_str<ordered_type_config>(std::string, spec, fail_fast_t, cxx::source_location);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_parallel<ordered_type_config>(std::string, spec, const std::size_t);
+template basic_value<ordered_type_config> parse_parallel<ordered_type_config>(std::string, spec, const std::size_t);
+template std::vector<result<basic_value<ordered_type_config>, std::vector<error_info>>> try_parse_many<ordered_type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+template std::vector<basic_value<ordered_type_config>> parse_many<ordered_type_config, std::vector<std::string>>(const std::vector<std::string>&, spec, const std::size_t);
+template result<detail::none_t, std::vector<error_info>> try_parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec);
+template result<detail::none_t, std::vector<error_info>> try_parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::istream&, std::string, spec);
+template result<detail::none_t, std::vector<error_info>> try_parse_events_str<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec, cxx::source_location);
+template void parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec);
+template void parse_events<ordered_type_config>(event_handler<ordered_type_config>&, std::istream&, std::string, spec);
+template void parse_events_str<ordered_type_config>(event_handler<ordered_type_config>&, std::string, spec, cxx::source_location);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(std::istream&, std::string, spec);
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(FILE*, std::string, spec);
+template basic_value<ordered_type_config> parse_stream<ordered_type_config>(std::istream&, std::string, spec);
+template basic_value<ordered_type_config> parse_stream<ordered_type_config>(FILE*, std::string, spec);
+#if defined(TOML11_HAS_POSIX_FD)
+template result<basic_value<ordered_type_config>, std::vector<error_info>> try_parse_stream<ordered_type_config>(const int, std::string, spec);
+template basic_value<ordered_type_config> parse_stream<ordered_type_config>(const int, std::string, spec);
+#endif
 
 #if defined(TOML11_HAS_FILESYSTEM)
 template cxx::enable_if_t<std::is_same<std::filesystem::path, std::filesystem::path>::value, result<basic_value<type_config>,         std::vector<error_info>>> try_parse<type_config,         std::filesystem::path>(const std::filesystem::path&, spec);
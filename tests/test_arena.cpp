@@ -0,0 +1,198 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cstdint>
+
+namespace
+{
+const std::string config(
+    "title = \"a string that is longer than the small string buffer\"\n"
+    "# comment\n"
+    "[server]\n"
+    "ports = [8000, 8001, {alt = \"a string that is longer than the small string buffer\"}]\n"
+    "[[products]]\n"
+    "name = \"a\"\n"
+    "[[products]]\n"
+    "name = \"b\"\n"
+    "[products.detail]\n"
+    "weight = 1.5\n"
+    "date = 1979-05-27\n");
+
+// a string whose move constructor may throw
+struct throwing_string : std::string
+{
+    using std::string::string;
+    throwing_string() = default;
+    throwing_string(const throwing_string&) = default;
+    throwing_string(throwing_string&& other) noexcept(false)
+        : std::string(std::move(other))
+    {}
+    throwing_string& operator=(const throwing_string&) = default;
+    throwing_string& operator=(throwing_string&&) = default;
+};
+struct throwing_move_config : toml::type_config
+{
+    using string_type = throwing_string;
+    using key_type    = std::string;
+};
+} // anonymous
+
+TEST_CASE("testing value_arena")
+{
+    toml::value_arena arena(256);
+    CHECK_EQ(arena.capacity(), 0);
+
+    void* p = arena.allocate(10);
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(p) % toml::value_arena::alignment(), 0);
+    CHECK_EQ(arena.capacity(), 256);
+
+    // a freed chunk is reused for the same size class
+    arena.deallocate(p, 10);
+    CHECK_EQ(arena.allocate(16), p);
+
+    // larger than a block
+    void* q = arena.allocate(1000);
+    CHECK_NE(q, nullptr);
+    CHECK_EQ(arena.capacity(), 256 + 1024);
+
+    // larger than the largest size class
+    CHECK_THROWS_AS(arena.allocate(toml::value_arena::max_chunk_size() + 1), std::bad_alloc);
+    CHECK_EQ(arena.capacity(), 256 + 1024);
+}
+
+TEST_CASE("testing arena_allocator")
+{
+    toml::value_arena arena;
+    {
+        const toml::arena_allocator<int> heap;
+        CHECK_EQ(heap.arena(), nullptr);
+    }
+    {
+        toml::arena_scope scope(arena);
+        const toml::arena_allocator<int> a;
+        CHECK_EQ(a.arena(), &arena);
+
+        toml::value_arena inner;
+        {
+            toml::arena_scope inner_scope(inner);
+            CHECK_EQ(toml::arena_allocator<int>().arena(), &inner);
+        }
+        CHECK_EQ(toml::arena_allocator<int>().arena(), &arena);
+        CHECK_NE(toml::arena_allocator<int>(), toml::arena_allocator<int>(&inner));
+    }
+    CHECK_EQ(toml::arena_allocator<int>().arena(), nullptr);
+
+    std::vector<int, toml::arena_allocator<int>> v;
+    {
+        toml::arena_scope scope(arena);
+        std::vector<int, toml::arena_allocator<int>> w{1, 2, 3};
+        CHECK_EQ(w.get_allocator().arena(), &arena);
+
+        v = std::move(w); // moved container keeps its arena
+    }
+    CHECK_EQ(v.get_allocator().arena(), &arena);
+
+    const auto copied = v; // copied out of the scope goes to the heap
+    CHECK_EQ(copied.get_allocator().arena(), nullptr);
+    CHECK_EQ(copied, v);
+}
+
+TEST_CASE("testing parse with arena_type_config")
+{
+    const auto expected = toml::parse_str(config);
+
+    toml::value_arena arena;
+    toml::arena_value v;
+    {
+        toml::arena_scope scope(arena);
+        v = toml::parse_str<toml::arena_type_config>(config);
+    }
+    CHECK_NE(arena.capacity(), 0);
+    CHECK_EQ(v.as_table().get_allocator().arena(), &arena);
+    CHECK_EQ(v.at("title").as_string().get_allocator().arena(), &arena);
+
+    CHECK_EQ(toml::find<std::string>(v, "title"), toml::find<std::string>(expected, "title"));
+    CHECK_EQ(toml::find<int>(v, "server", "ports", 1), 8001);
+    CHECK_EQ(toml::find<double>(v, "products", 1, "detail", "weight"), 1.5);
+    CHECK_EQ(v.at("title").comments().size(), 0);
+    CHECK_EQ(v.at("server").comments().at(0), "# comment");
+
+    const auto formatted = toml::format(v);
+    CHECK_EQ(toml::parse_str(std::string(formatted.begin(), formatted.end())), expected);
+
+    // copied out of the scope; it does not depend on the arena
+    const toml::arena_value copied(v);
+    CHECK_EQ(copied.as_table().get_allocator().arena(), nullptr);
+    CHECK_EQ(copied.at("title").as_string().get_allocator().arena(), nullptr);
+    CHECK_EQ(copied, v);
+
+    // conversion between type_configs
+    const toml::value converted(v);
+    CHECK_EQ(converted, expected);
+    const toml::arena_value back(converted);
+    CHECK_EQ(back, v);
+}
+
+TEST_CASE("testing arena_scope in multiple threads")
+{
+    std::vector<std::thread> threads;
+    std::vector<toml::value> results(4);
+    for(std::size_t n=0; n<results.size(); ++n)
+    {
+        threads.emplace_back([&results, n]() {
+            toml::value_arena arena;
+            toml::arena_scope scope(arena);
+            const auto v = toml::parse_str<toml::arena_type_config>(config);
+            results.at(n) = toml::value(v);
+        });
+    }
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+    for(const auto& r : results)
+    {
+        CHECK_EQ(r, toml::parse_str(config));
+    }
+}
+
+TEST_CASE("testing noexcept of the move of basic_value")
+{
+    CHECK_UNARY(std::is_nothrow_move_constructible<toml::value>::value);
+    CHECK_UNARY(std::is_nothrow_move_assignable<toml::value>::value);
+    CHECK_UNARY(std::is_nothrow_move_constructible<toml::arena_value>::value);
+    CHECK_UNARY(std::is_nothrow_move_assignable<toml::arena_value>::value);
+
+    using throwing_value = toml::basic_value<throwing_move_config>;
+    CHECK_UNARY( ! std::is_nothrow_move_constructible<throwing_value>::value);
+    CHECK_UNARY( ! std::is_nothrow_move_assignable<throwing_value>::value);
+
+    throwing_value v(throwing_string("foo"));
+    throwing_value w(std::move(v));
+    CHECK_EQ(w.as_string(), "foo");
+}
+
+#if defined(TOML11_HAS_STD_MEMORY_RESOURCE)
+TEST_CASE("testing parse with pmr_type_config")
+{
+    std::pmr::monotonic_buffer_resource resource;
+    auto* previous = std::pmr::set_default_resource(&resource);
+    {
+        const auto v = toml::parse_str<toml::pmr_type_config>(config);
+        CHECK_EQ(v.as_table().get_allocator().resource(), &resource);
+        CHECK_EQ(v.at("title").as_string().get_allocator().resource(), &resource);
+        CHECK_EQ(v.at("server").at("ports").as_array().get_allocator().resource(), &resource);
+        CHECK_EQ(v.at("server").at("ports").at(2).at("alt").as_string().get_allocator().resource(), &resource);
+        CHECK_EQ(toml::value(v), toml::parse_str(config));
+    }
+    std::pmr::set_default_resource(previous);
+}
+#endif
@@ -0,0 +1,112 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <new>
+#include <string>
+
+namespace
+{
+struct cow_config : toml::type_config
+{
+    using storage_type = toml::copy_on_write;
+};
+using cow_value = toml::basic_value<cow_config>;
+} // anonymous
+
+TEST_CASE("testing copies share arrays and tables")
+{
+    const std::string content(
+        "a = [1, 2, 3]\n"
+        "[t]\n"
+        "b = 'b'\n"
+        "[t.u]\n"
+        "c = [[1], [2]]\n"
+        "[v]\n"
+        "d = 42\n");
+
+    const auto original = toml::parse_str<cow_config>(content);
+    CHECK_EQ(toml::value(original), toml::parse_str(content));
+
+    const cow_value copied = original;
+    CHECK_EQ(&copied.as_table(), &original.as_table());
+    CHECK_EQ(&copied.at("t").as_table(), &original.at("t").as_table());
+    CHECK_EQ(copied, original);
+}
+
+TEST_CASE("testing modification detaches the path")
+{
+    const auto original = toml::parse_str<cow_config>(
+        "a = [1, 2, 3]\n"
+        "[t]\n"
+        "b = 'b'\n"
+        "[t.u]\n"
+        "c = [[1], [2]]\n"
+        "[v]\n"
+        "d = 42\n");
+
+    auto copied = original;
+    copied["t"]["u"]["c"][0][0] = 100;
+
+    CHECK_EQ(copied.at("t").at("u").at("c").at(0).at(0).as_integer(), 100);
+    CHECK_EQ(original.at("t").at("u").at("c").at(0).at(0).as_integer(), 1);
+
+    // the tables and arrays on the path are copied
+    const auto& c = copied;
+    CHECK_NE(&c.as_table(), &original.as_table());
+    CHECK_NE(&c.at("t").as_table(), &original.at("t").as_table());
+    CHECK_NE(&c.at("t").at("u").at("c").as_array(),
+             &original.at("t").at("u").at("c").as_array());
+
+    // the others are still shared
+    CHECK_EQ(&c.at("a").as_array(), &original.at("a").as_array());
+    CHECK_EQ(&c.at("v").as_table(), &original.at("v").as_table());
+    CHECK_EQ(&c.at("t").at("u").at("c").at(1).as_array(),
+             &original.at("t").at("u").at("c").at(1).as_array());
+
+    copied.at("a").as_array().push_back(4);
+    CHECK_EQ(c.at("a").size(), 4);
+    CHECK_EQ(original.at("a").size(), 3);
+
+    copied.as_table().erase("v");
+    CHECK_UNARY( ! c.contains("v"));
+    CHECK_UNARY(original.contains("v"));
+}
+
+TEST_CASE("testing nothrow accessors that may copy are not noexcept")
+{
+    // copying a shared array or table may throw
+    cow_value cv(toml::array{1, 2});
+    CHECK_UNARY( ! noexcept(cv.as_array(std::nothrow)));
+    CHECK_UNARY( ! noexcept(cv.as_table(std::nothrow)));
+    CHECK_UNARY( ! noexcept(cv.as<toml::value_t::array>(std::nothrow)));
+    CHECK_UNARY( ! noexcept(cv[0]));
+
+    const cow_value& ccv = cv;
+    CHECK_UNARY(noexcept(ccv.as_array(std::nothrow)));
+    CHECK_UNARY(noexcept(ccv[0]));
+
+    toml::value v(toml::array{1, 2});
+    CHECK_UNARY(noexcept(v.as_array(std::nothrow)));
+    CHECK_UNARY(noexcept(v.as_table(std::nothrow)));
+    CHECK_UNARY(noexcept(v.as<toml::value_t::array>(std::nothrow)));
+    CHECK_UNARY(noexcept(v[0]));
+
+    auto copied = cv;
+    copied.as_array(std::nothrow).push_back(3);
+    CHECK_EQ(cv.size(), 2);
+    CHECK_EQ(copied.size(), 3);
+}
+
+TEST_CASE("testing conversion from and to copy-on-write values")
+{
+    const toml::value v(toml::table{{"a", toml::array{1, 2}}, {"b", "b"}});
+    const cow_value w(v);
+    CHECK_EQ(toml::value(w), v);
+
+    auto x = w;
+    toml::value y(std::move(x)); // does not move the elements out of `w`
+    CHECK_EQ(y, v);
+    CHECK_EQ(toml::value(w), v);
+}
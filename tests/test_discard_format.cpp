@@ -0,0 +1,75 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <string>
+#include <type_traits>
+
+namespace
+{
+struct no_format_config : toml::type_config
+{
+    using format_type = toml::discard_format;
+};
+using no_format_value = toml::basic_value<no_format_config>;
+} // anonymous
+
+TEST_CASE("testing discard_format makes values smaller")
+{
+    CHECK_UNARY(sizeof(no_format_value) < sizeof(toml::value));
+}
+
+TEST_CASE("testing parse with discard_format")
+{
+    const std::string content(
+        "a = 0xDEAD_BEEF\n"
+        "b = 1_000\n"
+        "c = 6.02e23\n"
+        "d = 'literal'\n"
+        "e = 1979-05-27T07:32:00.999Z\n"
+        "[table]\n"
+        "inline = {x = 1, y = [1, 2, 3]}\n"
+        "[[array]]\n"
+        "z = true\n");
+
+    const auto v = toml::parse_str<no_format_config>(content);
+    const auto expected = toml::parse_str(content);
+
+    CHECK_EQ(toml::value(v), expected);
+    CHECK_EQ(no_format_value(expected), v);
+
+    // the formats of scalars are the default ones
+    CHECK_EQ(v.at("a").as_integer(), 0xDEADBEEF);
+    CHECK_EQ(v.at("a").as_integer_fmt(), toml::integer_format_info{});
+    CHECK_EQ(v.at("b").as_integer_fmt(), toml::integer_format_info{});
+    CHECK_EQ(v.at("d").as_string_fmt(), toml::string_format_info{});
+    CHECK_EQ(toml::format(v.at("a")), "3735928559");
+    CHECK_EQ(toml::format(v.at("d")), "\"literal\"");
+
+    // arrays and tables keep their formats
+    CHECK_EQ(v.at("table").at("inline").as_table_fmt().fmt, toml::table_format::oneline);
+    CHECK_EQ(v.at("array").as_array_fmt().fmt, toml::array_format::array_of_tables);
+
+    // the non-const accessors return a copy of the default format, so it
+    // cannot be modified in place
+    auto w = v;
+    static_assert(std::is_same<decltype(w.at("b").as_integer_fmt()),
+                  toml::integer_format_info>::value, "");
+    static_assert(std::is_same<decltype(w.at("b").as_fmt<toml::value_t::integer>()),
+                  toml::integer_format_info>::value, "");
+    static_assert(std::is_same<decltype(w.at("table").as_table_fmt()),
+                  toml::table_format_info&>::value, "");
+    auto fmt = w.at("b").as_integer_fmt();
+    fmt.fmt = toml::integer_format::hex;
+    CHECK_EQ(w.at("b").as_integer_fmt().fmt, toml::integer_format::dec);
+
+    CHECK_EQ(toml::parse_str<no_format_config>(toml::format(v)), v);
+}
+
+TEST_CASE("testing errors with discard_format")
+{
+    // an inline table cannot be extended
+    const auto r = toml::try_parse_str<no_format_config>("t = {a = 1}\n[t]\nb = 2\n");
+    CHECK_UNARY(r.is_err());
+}
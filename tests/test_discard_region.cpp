@@ -0,0 +1,62 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <string>
+
+namespace
+{
+struct no_region_config : toml::type_config
+{
+    using region_type = toml::discard_region;
+};
+using no_region_value = toml::basic_value<no_region_config>;
+} // anonymous
+
+TEST_CASE("testing discard_region does not take space")
+{
+    CHECK_UNARY(std::is_empty<toml::discard_region>::value);
+    CHECK_UNARY(sizeof(no_region_value) + sizeof(toml::detail::region) <= sizeof(toml::value));
+}
+
+TEST_CASE("testing parse with discard_region")
+{
+    const std::string content(
+        "# the title\n"
+        "title = \"regions\"\n"
+        "[table]\n"
+        "array = [1, 2, 3]\n"
+        "inline = {a = 1.5, b = 1979-05-27T07:32:00Z}\n");
+
+    const auto v = toml::parse_str<no_region_config>(content);
+    const auto expected = toml::parse_str(content);
+
+    CHECK_UNARY( ! v.location().is_ok());
+    CHECK_UNARY( ! v.at("title").location().is_ok());
+    CHECK_UNARY( ! v.at("table").at("array").at(2).location().is_ok());
+    CHECK_EQ(v.at("title").location().file_name(), "unknown file");
+
+    // the other information is kept
+    CHECK_EQ(v.at("title").as_string(), "regions");
+    CHECK_EQ(v.at("title").comments().size(), 1);
+    CHECK_EQ(toml::find<double>(v, "table", "inline", "a"), 1.5);
+    CHECK_EQ(v.at("table").at("inline").as_table_fmt().fmt, toml::table_format::oneline);
+
+    CHECK_EQ(toml::value(v), expected);
+    CHECK_EQ(no_region_value(expected), v);
+    CHECK_EQ(toml::format(v), toml::format(expected));
+}
+
+TEST_CASE("testing errors with discard_region")
+{
+    // the error about the current position still points it
+    const auto r = toml::try_parse_str<no_region_config>("a = 1\na = 2\n");
+    REQUIRE_UNARY(r.is_err());
+    const auto& locs = r.as_err().at(0).locations();
+    REQUIRE_UNARY( ! locs.empty());
+    CHECK_EQ(locs.front().first.first_line_number(), 2);
+
+    const auto v = toml::parse_str<no_region_config>("a = 1\n");
+    CHECK_THROWS_AS(v.at("a").as_string(), toml::type_error);
+}
@@ -77,3 +77,28 @@ TEST_CASE("testing custom error message using source_location and value")
     CHECK_EQ(err.locations().at(1).second, "upper limit is defined here");
     CHECK_EQ(err.locations().at(2).second, "this is not in the range"   );
 }
+
+TEST_CASE("testing error message outlives the value")
+{
+    toml::error_info err("", {});
+    {
+        const toml::value root = toml::parse_str(
+            "a = [\n"
+            "  1,\n"
+            "  2,\n"
+            "]\n");
+        err = toml::make_error_info("invalid array",
+                root.at("a").location(), "defined here");
+    }
+    const auto& loc = err.locations().at(0).first;
+    CHECK_EQ(loc.first_line_number(), 1);
+    CHECK_EQ(loc.last_line_number(), 4);
+    CHECK_EQ(loc.num_lines(), 4);
+    CHECK_EQ(loc.first_line(), "a = [");
+    CHECK_EQ(loc.last_line(), "]");
+    CHECK_EQ(loc.lines().at(1), "  1,");
+
+    const auto msg = toml::format_error(err);
+    CHECK_NE(msg.find(" 1 | a = ["), std::string::npos);
+    CHECK_NE(msg.find(" 4 | ]"), std::string::npos);
+}
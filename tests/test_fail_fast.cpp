@@ -0,0 +1,106 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+TEST_CASE("testing fail_fast parses a valid file")
+{
+    const std::string content(
+        "a = 1\n"
+        "b = [1, 2, {x = 3}] # comment\n"
+        "[t]\n"
+        "c = \"c\"\n");
+
+    const auto res = toml::try_parse_str(content, toml::spec::default_version(), toml::fail_fast);
+    REQUIRE_UNARY(res.is_ok());
+    CHECK_EQ(res.unwrap(), toml::parse_str(content));
+}
+
+TEST_CASE("testing fail_fast stops at the first error")
+{
+    struct testcase
+    {
+        std::string           content;
+        toml::parse_error_code code;
+        std::size_t           offset;
+    };
+    const std::vector<testcase> cases{
+        {"a = 1\nb = \n[t]\nc = \n",          toml::parse_error_code::syntax,       10},
+        {"a = 1\nb = [1, 2, ?]\n",            toml::parse_error_code::syntax,       17},
+        {"a = 1\nb = {x = 1, x = 2}\n",       toml::parse_error_code::redefinition, 18},
+        {"a = 1\na = 2\n",                    toml::parse_error_code::redefinition,  6},
+        {"a = 1\n[t]\nb = 1\n[t]\nc = 2\n",   toml::parse_error_code::redefinition, 16},
+        {"a = 1\n[t\nb = 1\n",                toml::parse_error_code::table_header,  8},
+        {"a = 1\n[t] x\nb = 1\n",             toml::parse_error_code::table_header, 10},
+        {"a = 1 # \x01\nb = \n",              toml::parse_error_code::syntax,       10},
+    };
+
+    for(const auto& c : cases)
+    {
+        const auto res = toml::try_parse_str(c.content, toml::spec::default_version(), toml::fail_fast);
+        REQUIRE_MESSAGE(res.is_err(), c.content);
+
+        const auto& f = res.unwrap_err();
+        CHECK_MESSAGE(f.code() == c.code, c.content);
+        CHECK_MESSAGE(f.offset() == c.offset, c.content);
+
+        // the messages are the same as the normal mode
+        const auto expected = toml::try_parse_str(c.content);
+        REQUIRE_UNARY(expected.is_err());
+        const auto errs = f.errors();
+        REQUIRE_EQ(errs.size(), expected.unwrap_err().size());
+        for(std::size_t i=0; i<errs.size(); ++i)
+        {
+            const auto& e = expected.unwrap_err().at(i);
+            CHECK_EQ(errs.at(i).title(), e.title());
+            CHECK_EQ(errs.at(i).locations().front().first.first_line_number(),
+                     e.locations().front().first.first_line_number());
+            CHECK_EQ(errs.at(i).locations().front().first.first_column_number(),
+                     e.locations().front().first.first_column_number());
+        }
+        CHECK_EQ(f.message().empty(), false);
+    }
+}
+
+TEST_CASE("testing fail_fast with a file")
+{
+    const std::string fname("test_fail_fast.toml");
+    {
+        std::ofstream ofs(fname);
+        ofs << "a = 1\n[t]\nb = 1.\n";
+    }
+    const auto res = toml::try_parse(fname, toml::spec::default_version(), toml::fail_fast);
+    std::remove(fname.c_str());
+
+    REQUIRE_UNARY(res.is_err());
+    CHECK_EQ(res.unwrap_err().code(), toml::parse_error_code::syntax);
+    CHECK_EQ(res.unwrap_err().offset(), 15u);
+    CHECK_EQ(res.unwrap_err().file_name(), fname);
+    CHECK_EQ(res.unwrap_err().errors().size(), 1u);
+
+    const auto io = toml::try_parse("nonexistent.toml", toml::spec::default_version(), toml::fail_fast);
+    REQUIRE_UNARY(io.is_err());
+    CHECK_EQ(io.unwrap_err().code(), toml::parse_error_code::file_io);
+    CHECK_EQ(io.unwrap_err().errors().size(), 1u);
+    CHECK_EQ(toml::to_string(io.unwrap_err().code()), "file_io");
+}
+
+TEST_CASE("testing fail_fast offset in a section")
+{
+    const std::string content("a = 1\n[t]\nb = 1.\n");
+    const auto src = toml::detail::make_source(
+        toml::detail::source_buffer::container_type(content.begin(), content.end()));
+    const auto sections = toml::detail::split_source(src, std::vector<std::size_t>{6});
+    REQUIRE_EQ(sections.size(), 2u);
+
+    CHECK_EQ(toml::detail::error_offset(*src, src, 15), 15u);
+    CHECK_EQ(toml::detail::error_offset(*src, sections.at(1), 9), 15u);
+    CHECK_EQ(toml::detail::error_offset(*src, sections.at(1), 100), content.size());
+    CHECK_EQ(toml::detail::error_offset(*src, nullptr, 9), 0u);
+}
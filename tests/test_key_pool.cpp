@@ -0,0 +1,101 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <string>
+#include <unordered_map>
+
+TEST_CASE("testing interned_key")
+{
+    const toml::interned_key empty;
+    CHECK_UNARY(empty.empty());
+    CHECK_EQ(empty, toml::interned_key(""));
+    CHECK_EQ(empty.hash(), std::hash<std::string>{}(""));
+
+    toml::key_pool pool;
+    const auto a1 = pool.intern("a long key that does not fit in the buffer");
+    const auto a2 = pool.intern("a long key that does not fit in the buffer");
+    const auto b  = pool.intern("b");
+    CHECK_EQ(pool.size(), 2);
+
+    CHECK_UNARY(a1.same_bytes(a2));
+    CHECK_EQ(a1.data(), a2.data());
+    CHECK_EQ(a1, a2);
+    CHECK_NE(a1, b);
+    CHECK_UNARY(a1 < b);
+
+    // made without a pool
+    const toml::interned_key a3("a long key that does not fit in the buffer");
+    CHECK_UNARY_FALSE(a1.same_bytes(a3));
+    CHECK_EQ(a1, a3);
+    CHECK_EQ(a1.hash(), a3.hash());
+    CHECK_EQ(std::hash<toml::interned_key>{}(a1), a3.hash());
+
+    CHECK_EQ(b, "b");
+    CHECK_EQ(b, std::string("b"));
+    CHECK_EQ("key " + b, "key b");
+    CHECK_EQ(b.str(), "b");
+    CHECK_EQ(b.size(), 1);
+
+    std::unordered_map<toml::interned_key, int> m;
+    m[a1] = 1;
+    m[b]  = 2;
+    CHECK_EQ(m.at(a3), 1);
+    CHECK_EQ(m.at("b"), 2);
+}
+
+TEST_CASE("testing parse with interned_type_config")
+{
+    const std::string content(
+        "title = \"hosts\"\n"
+        "[[host]]\n"
+        "name = \"a\"\n"
+        "operating_system_version = \"1\"\n"
+        "[[host]]\n"
+        "'name' = \"b\"\n"
+        "\"operating_system_version\" = \"2\"\n"
+        "[[host]]\n"
+        "name = \"c\"\n"
+        "operating_system_version.major = 3\n");
+
+    const auto v = toml::parse_str<toml::interned_type_config>(content);
+    const auto expected = toml::parse_str(content);
+
+    const auto& hosts = v.at("host").as_array();
+    REQUIRE_EQ(hosts.size(), 3);
+    for(const auto& key : {"name", "operating_system_version"})
+    {
+        const auto k0 = hosts.at(0).as_table().find(key);
+        const auto k1 = hosts.at(1).as_table().find(key);
+        const auto k2 = hosts.at(2).as_table().find(key);
+        REQUIRE_UNARY(k0 != hosts.at(0).as_table().end());
+        CHECK_UNARY(k0->first.same_bytes(k1->first));
+        CHECK_UNARY(k0->first.same_bytes(k2->first));
+    }
+
+    CHECK_EQ(toml::find<std::string>(v, "host", 1, "name"), "b");
+    CHECK_EQ(toml::find<int>(v, "host", 2, "operating_system_version", "major"), 3);
+    CHECK_UNARY(v.contains("title"));
+
+    const toml::value converted(v);
+    CHECK_EQ(converted, expected);
+    CHECK_EQ(toml::interned_value(converted), v);
+
+    CHECK_EQ(toml::parse_str<toml::interned_type_config>(toml::format(v)), v);
+
+    // the keys outlive the pool in the parser
+    const auto copied = v.at("host").at(0);
+    CHECK_EQ(copied.as_table().begin()->first, copied.as_table().begin()->first.str());
+}
+
+TEST_CASE("testing interned_type_config with select")
+{
+    const auto v = toml::parse_str<toml::interned_type_config>(
+        "[[host]]\nname = \"a\"\nip = \"1\"\n[[host]]\nname = \"b\"\nip = \"2\"\n",
+        toml::spec::default_version(), toml::select({"host[*].name"}));
+
+    CHECK_EQ(v.at("host").size(), 2);
+    CHECK_EQ(v.at("host").at(1).at("name").as_string(), "b");
+    CHECK_UNARY_FALSE(v.at("host").at(1).contains("ip"));
+}
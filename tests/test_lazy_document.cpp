@@ -0,0 +1,166 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdio>
+
+namespace
+{
+toml::lazy_document<> make_document(const std::string& content)
+{
+    return toml::lazy_document<>(toml::detail::make_source(std::vector<unsigned char>(
+                content.begin(), content.end()), /*append_newline = */true), "lazy");
+}
+} // anonymous
+
+TEST_CASE("testing lazy_document is the same as parse")
+{
+    const std::string content(
+        "\xEF\xBB\xBF# top comment\n"
+        "\n"
+        "title = \"lazy\"\n"
+        "a.b = 1\n"
+        "\n"
+        "# comment for server\n"
+        "[server]\n"
+        "port = 8080\n"
+        "[[products]] # trailing\n"
+        "name = \"a\"\n"
+        "[[products]]\n"
+        "name = \"b\"\n"
+        "[x.y.z]\n"
+        "w = 1\n"
+        "[products.detail]\n"
+        "weight = 1.5\n"
+        "  [x] # reopening an implicit table\n"
+        "r.s = 2\n"
+        "[server.alpha]\n"
+        "ip = \"10.0.0.1\"");
+
+    const auto expected = toml::parse_str(content);
+    const auto doc = make_document(content);
+
+    for(const auto& kv : expected.as_table())
+    {
+        CHECK_UNARY(doc.contains(kv.first));
+        CHECK_EQ(doc.at(kv.first), kv.second);
+        CHECK_EQ(toml::format(kv.first, doc.at(kv.first)), toml::format(kv.first, kv.second));
+    }
+    CHECK_UNARY_FALSE(doc.contains("nonexistent"));
+    CHECK_THROWS_AS(doc.at("nonexistent"), std::out_of_range);
+
+    const auto& ip = doc.at("server").at("alpha").at("ip");
+    CHECK_EQ(ip.location().first_line_number(), 20);
+    CHECK_EQ(ip.location().first_line(), "ip = \"10.0.0.1\"");
+
+    CHECK_EQ(toml::find<int>(doc, "server", "port"), 8080);
+    CHECK_EQ(toml::find<std::string>(doc, "title"), "lazy");
+    CHECK_EQ(toml::find(doc, "products", 1, "name").as_string(), "b");
+
+    CHECK_UNARY(doc.validate().is_ok());
+}
+
+TEST_CASE("testing lazy_document parses only the sections it needs")
+{
+    const auto doc = make_document(
+        "a = 1\n"
+        "[good]\n"
+        "x = 1\n"
+        "[bad]\n"
+        "x = \n"
+        "[good.sub]\n"
+        "y = 2\n");
+
+    CHECK_EQ(doc.at("a").as_integer(), 1);
+    CHECK_EQ(doc.at("good").at("sub").at("y").as_integer(), 2);
+    CHECK_THROWS_AS(doc.at("bad"), toml::syntax_error);
+
+    const auto res = doc.validate();
+    REQUIRE_UNARY(res.is_err());
+    const auto expected = toml::try_parse_str("a = 1\n[good]\nx = 1\n[bad]\nx = \n[good.sub]\ny = 2\n");
+    REQUIRE_UNARY(expected.is_err());
+    CHECK_EQ(res.unwrap_err().size(), expected.unwrap_err().size());
+}
+
+TEST_CASE("testing lazy_document reports conflicts with the root table")
+{
+    const auto doc = make_document(
+        "t.a = 1\n"
+        "[t]\n"
+        "b = 2\n"
+        "[u]\n"
+        "c = 3\n");
+
+    CHECK_THROWS_AS(doc.at("t"), toml::syntax_error);
+    CHECK_EQ(doc.at("u").at("c").as_integer(), 3);
+}
+
+TEST_CASE("testing lazy_document with an empty root")
+{
+    const auto doc = make_document("[t]\na = 1\n");
+    CHECK_EQ(doc.at("t").at("a").as_integer(), 1);
+
+    const auto empty = make_document("");
+    CHECK_UNARY_FALSE(empty.contains("t"));
+}
+
+TEST_CASE("testing lazy_document from multiple threads")
+{
+    std::string content;
+    for(int i=0; i<100; ++i)
+    {
+        content += "[t" + std::to_string(i) + "]\nv = " + std::to_string(i) + "\n";
+    }
+    const auto doc = make_document(content);
+
+    std::vector<std::thread> threads;
+    std::vector<int> sums(4, 0);
+    for(std::size_t n=0; n<sums.size(); ++n)
+    {
+        threads.emplace_back([&doc, &sums, n]() {
+            for(int i=0; i<100; ++i)
+            {
+                sums.at(n) += toml::find<int>(doc, "t" + std::to_string(i), "v");
+            }
+        });
+    }
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+    for(const auto s : sums)
+    {
+        CHECK_EQ(s, 4950);
+    }
+}
+
+TEST_CASE("testing lazy_document with a file")
+{
+    const std::string fname("test_lazy_document.toml");
+    {
+        std::ofstream ofs(fname);
+        ofs << "a = 1\n[t]\nb = 2\n[u]\nc = 3\n";
+    }
+    const toml::lazy_document<> read(fname);
+    const toml::lazy_document<> mapped(fname, toml::map_file);
+    CHECK_EQ(toml::find<int>(mapped, "u", "c"), 3);
+
+    // it is read into memory, so the file can be modified after construction
+    {
+        std::ofstream ofs(fname, std::ios_base::trunc);
+    }
+    CHECK_EQ(toml::find<int>(read, "a"), 1);
+    CHECK_EQ(toml::find<int>(read, "t", "b"), 2);
+    CHECK_EQ(toml::find<int>(read, "u", "c"), 3);
+    std::remove(fname.c_str());
+
+    CHECK_THROWS_AS(toml::lazy_document<>("nonexistent.toml"), toml::file_io_error);
+    CHECK_THROWS_AS(toml::lazy_document<>("nonexistent.toml", toml::map_file), toml::file_io_error);
+}
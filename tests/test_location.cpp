@@ -2,6 +2,9 @@
 #include "doctest.h"
 
 #include <toml11/location.hpp>
+#include <toml11/region.hpp>
+
+#include <string>
 
 TEST_CASE("testing location")
 {
@@ -61,3 +64,87 @@ TEST_CASE("testing multiline location")
     CHECK_EQ(loc.line_number(), 2);
     CHECK_EQ(loc.column_number(), 5);
 }
+
+TEST_CASE("testing line numbers of a long source")
+{
+    // longer than a SIMD register so that the index is built by vectors
+    std::string str;
+    for(std::size_t i=0; i<100; ++i)
+    {
+        str += std::string(i % 40, 'a') + "\n";
+    }
+    const auto first = toml::detail::make_temporary_location(str);
+
+    std::size_t line   = 1;
+    std::size_t column = 1;
+    auto loc = first;
+    for(std::size_t i=0; i<str.size(); ++i)
+    {
+        CHECK_EQ(loc.get_location(), i);
+        CHECK_EQ(loc.line_number(), line);
+        CHECK_EQ(loc.column_number(), column);
+        if(str.at(i) == '\n')
+        {
+            line  += 1;
+            column = 1;
+        }
+        else
+        {
+            column += 1;
+        }
+        loc.advance();
+    }
+    CHECK_UNARY(loc.eof());
+    CHECK_EQ(loc.line_number(), 101);
+    CHECK_EQ(loc.column_number(), 1);
+
+    // moving backward does not need to count lines
+    loc.retrace(str.size() - 2);
+    CHECK_EQ(loc.line_number(), 2); // "\na\n"
+    CHECK_EQ(loc.column_number(), 2);
+    loc.set_location(str.size() - 1);
+    CHECK_EQ(loc.line_number(), 100);
+    CHECK_EQ(loc.column_number(), 20);
+    loc.retrace(str.size() + 10);
+    CHECK_EQ(loc.get_location(), 0);
+    CHECK_EQ(loc.line_number(), 1);
+
+    // copies share the same index
+    const auto copied = loc;
+    CHECK_EQ(copied.record(), first.record());
+}
+
+TEST_CASE("testing region shares the source with locations")
+{
+    const auto first = toml::detail::make_temporary_location("a = 42\nb = [\n  1,\n]\n");
+
+    auto second = first;
+    second.advance(11); // `[`
+    auto last = second;
+    last.advance(8);    // after `]`
+
+    const toml::detail::region reg(second, last);
+    CHECK_UNARY(reg.is_ok());
+    CHECK_EQ(reg.source(), first.source());
+    CHECK_EQ(reg.source_name(), "internal temporary");
+    CHECK_EQ(reg.length(), 8);
+    CHECK_EQ(reg.as_string(), "[\n  1,\n]");
+    CHECK_EQ(reg.first_line_number(),   2);
+    CHECK_EQ(reg.first_column_number(), 5);
+    CHECK_EQ(reg.last_line_number(),    4);
+    CHECK_EQ(reg.last_column_number(),  2);
+
+    const toml::detail::region ch(last); // the newline after `]`
+    CHECK_EQ(ch.length(), 1);
+    CHECK_EQ(ch.last_line_number(),   4);
+    CHECK_EQ(ch.last_column_number(), 3);
+
+    const toml::detail::region none;
+    CHECK_UNARY( ! none.is_ok());
+    CHECK_UNARY( ! none.source());
+    CHECK_EQ(none.source_name(), "");
+    CHECK_EQ(none.first_line_number(), 0);
+
+    // a pointer to the shared source and 32-bit offsets
+    CHECK_UNARY(sizeof(toml::detail::region) <= sizeof(void*) * 2 + 8);
+}
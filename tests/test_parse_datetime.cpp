@@ -305,3 +305,45 @@ TEST_CASE("testing local_time")
         toml11_test_parse_success<toml::value_t::local_time>("01:23:45.123456789", toml::local_time(1, 23, 45, 123, 456, 789), comments(), fmt(true,  9), ctx);
     }
 }
+
+TEST_CASE("testing datetime and floating lexed by lex_number")
+{
+    // parse_value passes the length of the token found by the lexer. The
+    // value and the region must be the same as the ones scanned by the rules.
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,1,0));
+
+    const std::vector<std::string> tokens{
+        "1979-05-27T07:32:00Z", "1979-05-27t07:32:00.999999z",
+        "1979-05-27 07:32:00+09:00", "1979-05-27T07:32-07:00",
+        "1979-05-27T07:32:00", "1979-05-27 07:32:00.999", "1979-05-27T07:32",
+        "1979-05-27", "07:32:00", "07:32:00.999999", "07:32",
+        "3.14", "-6.02e+23", "1_000.5e-3", "+inf", "nan"
+    };
+    for(const auto& token : tokens)
+    {
+        const std::string in = token + " # comment";
+
+        auto loc1 = toml::detail::make_temporary_location(in);
+        const auto lexed = toml::detail::parse_value(loc1, ctx);
+        REQUIRE_MESSAGE(lexed.is_ok(), token);
+
+        auto loc2 = toml::detail::make_temporary_location(in);
+        const auto ty = lexed.unwrap().type();
+        const auto scanned =
+            (ty == toml::value_t::offset_datetime) ? toml::detail::parse_offset_datetime(loc2, ctx) :
+            (ty == toml::value_t::local_datetime)  ? toml::detail::parse_local_datetime (loc2, ctx) :
+            (ty == toml::value_t::local_date)      ? toml::detail::parse_local_date     (loc2, ctx) :
+            (ty == toml::value_t::local_time)      ? toml::detail::parse_local_time     (loc2, ctx) :
+                                                     toml::detail::parse_floating       (loc2, ctx);
+        REQUIRE_MESSAGE(scanned.is_ok(), token);
+
+        CHECK_MESSAGE(loc1.get_location() == token.size(), token);
+        CHECK_MESSAGE(loc1.get_location() == loc2.get_location(), token);
+        CHECK_MESSAGE(lexed.unwrap().location().length() == token.size(), token);
+        CHECK_MESSAGE(toml::format(lexed.unwrap()) == toml::format(scanned.unwrap()), token);
+        if(ty != toml::value_t::floating || token != "nan")
+        {
+            CHECK_MESSAGE(lexed.unwrap() == scanned.unwrap(), token);
+        }
+    }
+}
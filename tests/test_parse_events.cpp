@@ -0,0 +1,242 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "utility.hpp"
+
+#include <toml.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+template<typename TC>
+struct basic_recorder final : public toml::event_handler<TC>
+{
+    using base_type            = toml::event_handler<TC>;
+    using key_type             = typename base_type::key_type;
+    using boolean_type         = typename base_type::boolean_type;
+    using integer_type         = typename base_type::integer_type;
+    using floating_type        = typename base_type::floating_type;
+    using string_type          = typename base_type::string_type;
+    using local_time_type      = typename base_type::local_time_type;
+    using local_date_type      = typename base_type::local_date_type;
+    using local_datetime_type  = typename base_type::local_datetime_type;
+    using offset_datetime_type = typename base_type::offset_datetime_type;
+
+    std::vector<std::string> events;
+
+    static std::string join(const std::vector<key_type>& keys)
+    {
+        std::string retval;
+        for(const auto& k : keys)
+        {
+            retval += retval.empty() ? k : "." + k;
+        }
+        return retval;
+    }
+
+    void on_table_header(const std::vector<key_type>& keys, const bool aot) override
+    {
+        events.push_back(aot ? "[[" + join(keys) + "]]" : "[" + join(keys) + "]");
+    }
+    void on_key(const std::vector<key_type>& keys) override
+    {
+        events.push_back(join(keys) + " =");
+    }
+    void on_null() override {events.push_back("null");}
+    void on_boolean(const boolean_type x) override
+    {
+        events.push_back(x ? "true" : "false");
+    }
+    void on_integer(const integer_type x) override
+    {
+        events.push_back(std::to_string(x));
+    }
+    void on_floating(const floating_type x) override
+    {
+        events.push_back(toml::format(toml::basic_value<TC>(x)));
+    }
+    void on_string(const string_type& x) override
+    {
+        events.push_back("\"" + x + "\"");
+    }
+    void on_offset_datetime(const offset_datetime_type& x) override
+    {
+        std::ostringstream oss; oss << x; events.push_back(oss.str());
+    }
+    void on_local_datetime(const local_datetime_type& x) override
+    {
+        std::ostringstream oss; oss << x; events.push_back(oss.str());
+    }
+    void on_local_date(const local_date_type& x) override
+    {
+        std::ostringstream oss; oss << x; events.push_back(oss.str());
+    }
+    void on_local_time(const local_time_type& x) override
+    {
+        std::ostringstream oss; oss << x; events.push_back(oss.str());
+    }
+    void on_array_begin()        override {events.push_back("[");}
+    void on_array_end()          override {events.push_back("]");}
+    void on_inline_table_begin() override {events.push_back("{");}
+    void on_inline_table_end()   override {events.push_back("}");}
+    void on_comment(const std::string& com) override {events.push_back(com);}
+};
+using recorder = basic_recorder<toml::ordered_type_config>;
+} // anonymous
+
+TEST_CASE("testing parse_events")
+{
+    const std::string content(
+        "# root comment\n"
+        "\n"
+        "# comment for a\n"
+        "a.b = [1, {c = \"foo\", d.e = 2.5}] # trailing\n"
+        "t = true\n"
+        "date = 1979-05-27\n"
+        "odt = 1979-05-27T07:32:00Z\n"
+        "ldt = 1979-05-27T07:32:00\n"
+        "lt = 07:32:00\n"
+        "\n"
+        "[[aot]]\n"
+        "x = [\n"
+        "  # comment for 3\n"
+        "  3,\n"
+        "]\n"
+        "# comment for table\n"
+        "[tab.le] # trailing\n");
+
+    recorder r;
+    const auto res = toml::try_parse_events_str(r, content);
+    REQUIRE_UNARY(res.is_ok());
+
+    const std::vector<std::string> expected{
+        "# root comment",
+        "# comment for a", "a.b =",
+            "[", "1", "{", "c =", "\"foo\"", "d.e =", "2.5", "}", "]", "# trailing",
+        "t =", "true",
+        "date =", "1979-05-27",
+        "odt =", "1979-05-27T07:32:00Z",
+        "ldt =", "1979-05-27T07:32:00",
+        "lt =", "07:32:00",
+        "[[aot]]",
+        "x =", "[", "# comment for 3", "3", "]",
+        "# comment for table", "# trailing", "[tab.le]",
+    };
+    CHECK_EQ(r.events, expected);
+
+    // the istream overload reports the same events
+    recorder s;
+    std::istringstream iss(content);
+    toml::parse_events(s, iss, "events.toml");
+    CHECK_EQ(s.events, expected);
+}
+
+TEST_CASE("testing parse_events reports inline tables in the order of the file")
+{
+    // toml::type_config uses std::unordered_map
+    basic_recorder<toml::type_config> r;
+    toml::parse_events_str(r, "t = {zeta = 1, alpha = 2, mid = 3, omega = 4, beta = 5}\n");
+
+    const std::vector<std::string> expected{
+        "t =", "{", "zeta =", "1", "alpha =", "2", "mid =", "3",
+        "omega =", "4", "beta =", "5", "}"
+    };
+    CHECK_EQ(r.events, expected);
+}
+
+TEST_CASE("testing parse_events with comments in arrays and inline tables")
+{
+    auto spec = toml::spec::v(1, 1, 0);
+
+    recorder r;
+    toml::parse_events_str(r,
+        "a = [ # not for 1\n"
+        "  # for 1\n"
+        "  1, # after 1\n"
+        "  [2, 3], # after [2, 3]\n"
+        "]\n"
+        "t = {\n"
+        "  # for x\n"
+        "  x = 1, # after x\n"
+        "  y.z = {w = 2}\n"
+        "}\n", spec);
+
+    const std::vector<std::string> expected{
+        "a =", "[", "# not for 1", "# for 1", "1", "# after 1",
+            "[", "2", "3", "]", "# after [2, 3]", "]",
+        "t =", "{", "# for x", "x =", "1", "# after x",
+            "y.z =", "{", "w =", "2", "}", "}",
+    };
+    CHECK_EQ(r.events, expected);
+}
+
+TEST_CASE("testing parse_events with the null extension")
+{
+    auto spec = toml::spec::v(1, 0, 0);
+    spec.ext_null_value = true;
+
+    recorder r;
+    toml::parse_events_str(r, "a = null\n", spec);
+    CHECK_EQ(r.events, std::vector<std::string>{"a =", "null"});
+}
+
+TEST_CASE("testing parse_events with an empty input")
+{
+    recorder r;
+    CHECK_UNARY(toml::try_parse_events_str(r, "").is_ok());
+    CHECK_UNARY(toml::try_parse_events_str(r, "\xEF\xBB\xBF").is_ok());
+    CHECK_UNARY(r.events.empty());
+}
+
+TEST_CASE("testing parse_events reports the same errors as parse")
+{
+    const std::vector<std::string> invalids{
+        "a = 1\na = 2\n",
+        "a.b = 1\na.b.c = 2\n",
+        "a = {b = 1}\na.c = 2\n",
+        "a = [{b = 1}]\n[[a]]\n",
+        "a = [{b = 1}]\n[a.b]\n",
+        "[a]\nb.c = 1\n[a.b]\n",
+        "[a.b]\n[a]\n[a]\n",
+        "[[a]]\n[a]\n",
+        "a = 1\n[a]\n",
+        "a = [1, 2\n",
+        "a = \"unterminated\n[t]\nb = 1\nb = 2\n",
+        "a = {b = 1, b = 2}\n",
+        "a = [{b = 1}, {c = {d = 1, d = 2}}]\n",
+        "a.b = [1 2]\n[a]\nc = 1\nc = 2\n",
+        "a = {b = 1}\na = {b = 2}\n",
+    };
+    for(const auto& content : invalids)
+    {
+        const auto expected = toml::try_parse(
+            std::vector<unsigned char>(content.begin(), content.end()), "events.toml");
+        REQUIRE_UNARY(expected.is_err());
+
+        recorder r;
+        std::istringstream iss(content);
+        const auto res = toml::try_parse_events(r, iss, "events.toml");
+        REQUIRE_UNARY(res.is_err());
+        CHECK_EQ(format_errors(res.unwrap_err()), format_errors(expected.unwrap_err()));
+    }
+
+    // events before the first error are reported
+    recorder r;
+    CHECK_THROWS_AS(toml::parse_events_str(r, "a = 1\nb = 2\na = 3\nc = 4\n"), toml::syntax_error);
+    CHECK_EQ(r.events, std::vector<std::string>{"a =", "1", "b =", "2"});
+
+    recorder s;
+    CHECK_THROWS_AS(toml::parse_events_str(s, "a = [1, {b = 2, b = 3}]\nc = 4\n"), toml::syntax_error);
+    CHECK_EQ(s.events, std::vector<std::string>{"a =", "[", "1", "{", "b =", "2"});
+}
+
+TEST_CASE("testing parse_events with a nonexistent file")
+{
+    recorder r;
+    const auto res = toml::try_parse_events(r, "nonexistent.toml");
+    REQUIRE_UNARY(res.is_err());
+    CHECK_THROWS_AS(toml::parse_events(r, "nonexistent.toml"), toml::file_io_error);
+}
@@ -6,6 +6,12 @@
 #include <toml11/parser.hpp>
 #include <toml11/types.hpp>
 
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
 TEST_CASE("testing fractional float")
 {
     toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
@@ -165,3 +171,171 @@ TEST_CASE("testing hexfloat")
         CHECK_EQ(val.as_floating(), 343.5);
     }
 }
+
+namespace
+{
+// compares the bit patterns to distinguish 0.0 and -0.0 or values differ by 1 ulp
+template<typename T>
+bool same_bits(const T lhs, const T rhs)
+{
+    return std::memcmp(std::addressof(lhs), std::addressof(rhs), sizeof(T)) == 0;
+}
+
+template<typename TC>
+typename toml::basic_value<TC>::floating_type
+parse_floating_value(const std::string& str, const toml::detail::context<TC>& ctx)
+{
+    auto loc = toml::detail::make_temporary_location(str);
+    const auto res = toml::detail::parse_floating(loc, ctx);
+    REQUIRE_MESSAGE(res.is_ok(), str);
+    return res.unwrap().as_floating();
+}
+} // anonymous
+
+TEST_CASE("testing correctly rounded floats")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+
+    // the compiler rounds the literals correctly.
+    const std::vector<std::pair<std::string, double>> inputs = {
+        {"0.1",                       0.1},
+        {"0.3",                       0.3},
+        {"9007199254740993.0",        9007199254740993.0},
+        {"9007199254740995.0",        9007199254740995.0},
+        {"1.7976931348623157e308",    1.7976931348623157e308},
+        {"1.7976931348623158e308",    1.7976931348623158e308},
+        {"2.2250738585072011e-308",   2.2250738585072011e-308},
+        {"2.2250738585072012e-308",   2.2250738585072012e-308},
+        {"4.9406564584124654e-324",   4.9406564584124654e-324},
+        {"2.4703282292062328e-324",   4.9406564584124654e-324},
+        {"2.4703282292062327e-324",   0.0},
+        {"1e-400",                    0.0},
+        {"-1e-400",                  -0.0},
+        {"7.038531e-26",              7.038531e-26},
+        {"1_234.567_8e-1_0",          1234.5678e-10},
+
+        // more than 19 significant digits. they are halfway or just above
+        // the halfway between two doubles.
+        {"9007199254740992.5",        9007199254740992.0},
+        {"9007199254740993.0000000000000000000000000001", 9007199254740994.0},
+        {"9_007_199_254_740_992.999_999_999_999_999_999", 9007199254740992.0},
+        {"123456789012345678901234567890e-10", 123456789012345678901234567890e-10},
+        {"0.30000000000000001665334536937734810635447502136230468750000001",
+          0.30000000000000004},
+        {"2.4703282292062327208828439643411068618252990130716238221279284125"
+         "03377536351043759326499181808179961898982823477228588654633283551779"
+         "69898199387398005390939063150356595155702263922908583924491051844359"
+         "31802849936536152500319370457678249219365623669863658480757001585769"
+         "269903706311928279558551332927834338409351978015531246597263579574622"
+         "766465272827220056374006485499977096599470454020828166226237857393450"
+         "736339007967761930577506740176324673600968951340535537458516661134223"
+         "766678604162159680461914467291840300530057530849048765391711386591646"
+         "239524912623653881879636239373280423891018672348497668235089863388587"
+         "925628302755995657524455507255189313690836254779186948667994968324049"
+         "705821028513185451396213837722826145437693412532098591327667236328125e-324",
+          0.0},
+        {"2.4703282292062327208828439643411068618252990130716238221279284125"
+         "03377536351043759326499181808179961898982823477228588654633283551779"
+         "69898199387398005390939063150356595155702263922908583924491051844359"
+         "31802849936536152500319370457678249219365623669863658480757001585769"
+         "269903706311928279558551332927834338409351978015531246597263579574622"
+         "766465272827220056374006485499977096599470454020828166226237857393450"
+         "736339007967761930577506740176324673600968951340535537458516661134223"
+         "766678604162159680461914467291840300530057530849048765391711386591646"
+         "239524912623653881879636239373280423891018672348497668235089863388587"
+         "925628302755995657524455507255189313690836254779186948667994968324049"
+         "7058210285131854513962138377228261454376934125320985913276672363281251e-324",
+          4.9406564584124654e-324},
+    };
+    for(const auto& in : inputs)
+    {
+        const auto val = parse_floating_value(in.first, ctx);
+        CHECK_MESSAGE(same_bits(val, in.second), in.first);
+    }
+}
+
+TEST_CASE("testing floating overflow")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    for(const std::string str : {"1e309", "-1.8e308", "1_000e1_000"})
+    {
+        auto loc = toml::detail::make_temporary_location(str);
+        const auto res = toml::detail::parse_floating(loc, ctx);
+        CHECK_MESSAGE(res.is_err(), str);
+    }
+
+    const auto src = toml::source_location(toml::detail::region{});
+    CHECK_UNARY(toml::read_dec_float<float>("3.5e38", src).is_err());
+    CHECK_UNARY(same_bits(toml::read_dec_float<float>("3.4028235e38", src).unwrap(),
+                          std::numeric_limits<float>::max()));
+    CHECK_UNARY(same_bits(toml::read_dec_float<float>("1.00000005960464477550", src).unwrap(),
+                          1.0000001f));
+    CHECK_UNARY(same_bits(toml::read_dec_float<float>("1.4e-45", src).unwrap(),
+                          std::numeric_limits<float>::denorm_min()));
+}
+
+TEST_CASE("testing hexfloat rounding")
+{
+    toml::spec s = toml::spec::v(1,0,0);
+    s.ext_hex_float = true;
+    toml::detail::context<toml::type_config> ctx(s);
+
+    const std::vector<std::pair<std::string, double>> inputs = {
+        {"0x1p0",                    1.0},
+        {"0x1.8p1",                  3.0},
+        {"0x.8p1",                   1.0},
+        {"0x1.fffffffffffffp1023",   std::numeric_limits<double>::max()},
+        {"0x1p-1074",                std::numeric_limits<double>::denorm_min()},
+        {"0x1p-1075",                0.0},
+        {"0x1.0000000000001p-1075",  std::numeric_limits<double>::denorm_min()},
+        {"0x1.00000000000008p0",     1.0},                    // tie, to even
+        {"0x1.00000000000018p0",     1.0000000000000004},     // tie, to even
+        {"0x1.000000000000080001p0", 1.0000000000000002},     // above the tie
+        {"0x1p1024",                 std::numeric_limits<double>::infinity()},
+    };
+    for(const auto& in : inputs)
+    {
+        const auto val = parse_floating_value(in.first, ctx);
+        CHECK_MESSAGE(same_bits(val, in.second), in.first);
+    }
+
+    const auto src = toml::source_location(toml::detail::region{});
+    CHECK_UNARY(same_bits(toml::read_hex_float("-0x1.8p1", src, double{}).unwrap(), -3.0));
+    CHECK_UNARY(same_bits(toml::read_hex_float("0x1.000001p0", src, float{}).unwrap(), 1.0f));
+    CHECK_UNARY(same_bits(toml::read_hex_float("0x1.000003p0", src, float{}).unwrap(), 1.0000002f));
+}
+
+namespace
+{
+// counts the number of floats read by parse_float
+struct counting_type_config : toml::type_config
+{
+    static std::size_t count;
+
+    static toml::result<floating_type, toml::error_info>
+    parse_float(const std::string& str, const toml::source_location src, const bool is_hex)
+    {
+        count += 1;
+        return toml::read_float<floating_type>(str, src, is_hex);
+    }
+};
+std::size_t counting_type_config::count = 0;
+} // anonymous
+
+TEST_CASE("testing custom parse_float")
+{
+    toml::spec s = toml::spec::v(1,0,0);
+    s.ext_hex_float = true;
+    toml::detail::context<counting_type_config> ctx(s);
+
+    const std::vector<std::pair<std::string, double>> inputs = {
+        {"3.141_592", 3.141592}, {"-6.02e2_3", -6.02e23}, {"0x1.8p1", 3.0}
+    };
+    for(const auto& in : inputs)
+    {
+        CHECK_EQ(parse_floating_value(in.first, ctx), in.second);
+    }
+    // inf and nan do not call parse_float
+    CHECK_UNARY(std::isinf(parse_floating_value("-inf", ctx)));
+    CHECK_EQ(counting_type_config::count, inputs.size());
+}
@@ -7,6 +7,11 @@
 #include <toml11/parser.hpp>
 #include <toml11/types.hpp>
 
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
 TEST_CASE("testing decimal_value")
 {
     toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
@@ -128,6 +133,109 @@ TEST_CASE("testing integer_overflow")
     }
 }
 
+TEST_CASE("testing integer limits")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    {
+        auto loc = toml::detail::make_temporary_location("9_223_372_036_854_775_807");
+        const auto res = toml::detail::parse_dec_integer(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_integer(), (std::numeric_limits<std::int64_t>::max)());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("-9223372036854775808");
+        const auto res = toml::detail::parse_dec_integer(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_integer(), (std::numeric_limits<std::int64_t>::min)());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("-9223372036854775809");
+        const auto res = toml::detail::parse_dec_integer(loc, ctx);
+        CHECK_UNARY(res.is_err());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("0x7FFF_FFFF_FFFF_FFFF");
+        const auto res = toml::detail::parse_hex_integer(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_integer(), (std::numeric_limits<std::int64_t>::max)());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("0x8000_0000_0000_0000");
+        const auto res = toml::detail::parse_hex_integer(loc, ctx);
+        CHECK_UNARY(res.is_err());
+    }
+
+    const auto src = toml::source_location(toml::detail::region{});
+    CHECK_EQ(toml::read_dec_int<std::int8_t>( "127", src).unwrap(),  127);
+    CHECK_EQ(toml::read_dec_int<std::int8_t>("-128", src).unwrap(), -128);
+    CHECK_UNARY(toml::read_dec_int<std::int8_t>( "128", src).is_err());
+    CHECK_UNARY(toml::read_dec_int<std::int8_t>("-129", src).is_err());
+    CHECK_EQ(toml::read_hex_int<std::uint8_t>("FF", src).unwrap(), 255);
+    CHECK_UNARY(toml::read_hex_int<std::uint8_t>("100", src).is_err());
+    CHECK_EQ(toml::read_oct_int<std::uint16_t>("177777", src).unwrap(), 65535);
+    CHECK_UNARY(toml::read_oct_int<std::uint16_t>("200000", src).is_err());
+    CHECK_EQ(toml::read_bin_int<std::int8_t>("1111111", src).unwrap(), 127);
+    CHECK_UNARY(toml::read_bin_int<std::int8_t>("10000000", src).is_err());
+}
+
+namespace
+{
+// counts the number of integers read by parse_int
+struct counting_type_config : toml::type_config
+{
+    static std::size_t count;
+
+    static toml::result<integer_type, toml::error_info>
+    parse_int(const std::string& str, const toml::source_location src, const std::uint8_t base)
+    {
+        count += 1;
+        return toml::read_int<integer_type>(str, src, base);
+    }
+};
+std::size_t counting_type_config::count = 0;
+} // anonymous
+
+TEST_CASE("testing custom parse_int")
+{
+    toml::detail::context<counting_type_config> ctx(toml::spec::v(1,0,0));
+
+    const std::vector<std::pair<std::string, std::int64_t>> inputs = {
+        {"1_000", 1000}, {"-42", -42}, {"0xDEAD_beef", 0xDEADBEEF},
+        {"0o0_755", 0755}, {"0b0000_0101", 5}, {"0x0000", 0}
+    };
+    for(const auto& in : inputs)
+    {
+        auto loc = toml::detail::make_temporary_location(in.first);
+        const auto res = toml::detail::parse_integer(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_integer(), in.second);
+    }
+    CHECK_EQ(counting_type_config::count, inputs.size());
+}
+
+namespace
+{
+struct derived_type_config : toml::type_config
+{
+    using comment_type = toml::discard_comments;
+};
+} // anonymous
+
+TEST_CASE("testing default number readers of derived type_configs")
+{
+    using toml::detail::uses_default_number_readers;
+    CHECK_UNARY(uses_default_number_readers<toml::type_config>::value);
+    CHECK_UNARY(uses_default_number_readers<toml::ordered_type_config>::value);
+    CHECK_UNARY(uses_default_number_readers<toml::interned_type_config>::value);
+    CHECK_UNARY(uses_default_number_readers<derived_type_config>::value);
+    CHECK_UNARY( ! uses_default_number_readers<counting_type_config>::value);
+
+    const auto v = toml::parse_str<derived_type_config>("a = 0xdead_beef\nb = 1_000\nc = 1_0.5\n");
+    CHECK_EQ(v.at("a").as_integer(), 0xDEADBEEF);
+    CHECK_EQ(v.at("b").as_integer(), 1000);
+    CHECK_EQ(v.at("c").as_floating(), 10.5);
+}
+
 TEST_CASE("testing decimal_value with suffix extension")
 {
     auto spec = toml::spec::v(1, 0, 0);
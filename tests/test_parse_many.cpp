@@ -0,0 +1,94 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+namespace
+{
+std::vector<std::string> write_files(const std::vector<std::string>& contents)
+{
+    std::vector<std::string> fnames;
+    for(std::size_t i=0; i<contents.size(); ++i)
+    {
+        fnames.push_back("test_parse_many_" + std::to_string(i) + ".toml");
+        std::ofstream ofs(fnames.back(), std::ios_base::binary);
+        ofs << contents.at(i);
+    }
+    return fnames;
+}
+
+void remove_files(const std::vector<std::string>& fnames)
+{
+    for(const auto& fname : fnames)
+    {
+        std::remove(fname.c_str());
+    }
+}
+} // anonymous
+
+TEST_CASE("testing parse_many is the same as parse")
+{
+    std::vector<std::string> contents;
+    for(int i=0; i<100; ++i)
+    {
+        contents.push_back("id = " + std::to_string(i) + "\n"
+                           "[server]\n"
+                           "port = " + std::to_string(8000 + i));
+    }
+    contents.push_back(""); // an empty file is valid
+    const auto fnames = write_files(contents);
+
+    for(const std::size_t num_threads : {std::size_t(0), std::size_t(1), std::size_t(4)})
+    {
+        const auto res = toml::try_parse_many(fnames, toml::spec::default_version(), num_threads);
+        REQUIRE_EQ(res.size(), fnames.size());
+        for(std::size_t i=0; i<fnames.size(); ++i)
+        {
+            REQUIRE_UNARY(res.at(i).is_ok());
+            CHECK_EQ(res.at(i).unwrap(), toml::parse(fnames.at(i)));
+        }
+        CHECK_EQ(res.at(42).unwrap().at("server").at("port").as_integer(), 8042);
+        CHECK_EQ(res.at(42).unwrap().at("server").at("port").location().file_name(),
+                 fnames.at(42));
+
+        const auto values = toml::parse_many(fnames, toml::spec::default_version(), num_threads);
+        REQUIRE_EQ(values.size(), fnames.size());
+        CHECK_EQ(values.at(99).at("id").as_integer(), 99);
+    }
+    remove_files(fnames);
+}
+
+TEST_CASE("testing parse_many with errors")
+{
+    const auto fnames = write_files({"a = 1\n", "a = 1\na = 2\n", "b = \"ok\"\n"});
+
+    std::vector<std::string> paths(fnames);
+    paths.push_back("test_parse_many_nonexistent.toml");
+
+    const auto res = toml::try_parse_many(paths);
+    REQUIRE_EQ(res.size(), 4);
+    CHECK_UNARY(res.at(0).is_ok());
+    CHECK_UNARY(res.at(2).is_ok());
+
+    // the same errors as parse
+    REQUIRE_UNARY(res.at(1).is_err());
+    const auto expected = toml::try_parse(fnames.at(1));
+    REQUIRE_UNARY(expected.is_err());
+    REQUIRE_EQ(res.at(1).unwrap_err().size(), expected.unwrap_err().size());
+    CHECK_EQ(toml::format_error(res.at(1).unwrap_err().at(0)),
+             toml::format_error(expected.unwrap_err().at(0)));
+
+    REQUIRE_UNARY(res.at(3).is_err());
+    CHECK_EQ(res.at(3).unwrap_err().size(), 1);
+
+    CHECK_THROWS_AS(toml::parse_many(fnames), toml::syntax_error);
+    CHECK_THROWS_AS(toml::parse_many(std::vector<std::string>{paths.back()}), toml::file_io_error);
+
+    remove_files(fnames);
+}
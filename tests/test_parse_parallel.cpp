@@ -0,0 +1,173 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "utility.hpp"
+
+#include <toml.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+namespace
+{
+// splits `content` at every top-level header and parses them on 4 threads
+toml::result<toml::value, std::vector<toml::error_info>>
+parse_in_parallel(const std::string& content,
+                  const toml::spec s = toml::spec::default_version())
+{
+    auto src = toml::detail::make_source(std::vector<unsigned char>(
+                content.begin(), content.end()), /*append_newline = */true);
+    return toml::detail::parse_parallel_impl<toml::type_config>(
+            std::move(src), "parallel", s, /*num_threads = */4, /*min_section_size = */1);
+}
+} // anonymous
+
+TEST_CASE("testing find_section_boundaries")
+{
+    const std::string content(
+        "a = 1\n"
+        "b = [\n"
+        "[1, 2],\n"
+        "]\n"
+        "c = \"\"\"\n"
+        "[not.a.table]\n"
+        "\"\"\"\n"
+        "\n"
+        "# comment for t\n"
+        "[t]\n"
+        "x = 1\n"
+        "[[arr]]");
+
+    const auto src = toml::detail::make_source(std::vector<unsigned char>(
+                content.begin(), content.end()), /*append_newline = */true);
+
+    // the comments and the empty lines before a header belong to the next
+    const auto b = toml::detail::find_section_boundaries(
+            *src, toml::spec::default_version(), 1);
+    REQUIRE_EQ(b.size(), 2);
+    CHECK_EQ(content.substr(0, b.at(0)),
+        "a = 1\nb = [\n[1, 2],\n]\nc = \"\"\"\n[not.a.table]\n\"\"\"\n");
+    CHECK_EQ(content.substr(b.at(0), b.at(1) - b.at(0)),
+        "\n# comment for t\n[t]\nx = 1\n");
+
+    // short sections are merged into the next one
+    const auto c = toml::detail::find_section_boundaries(
+            *src, toml::spec::default_version(), 64);
+    REQUIRE_EQ(c.size(), 1);
+    CHECK_EQ(c.at(0), b.at(1));
+}
+
+TEST_CASE("testing parse_parallel is the same as parse")
+{
+    const std::string content(
+        "\xEF\xBB\xBF# top comment\n"
+        "\n"
+        "title = \"parallel\"\n"
+        "\n"
+        "# comment for server\n"
+        "[server]\n"
+        "ports = [ 8000,\n"
+        "  8001 ]\n"
+        "[[products]] # trailing\n"
+        "name = \"a\"\n"
+        "[[products]]\n"
+        "name = \"b\"\n"
+        "[products.detail]\n"
+        "weight = 1.5\n"
+        "[x.y.z]\n"
+        "w = 1\n"
+        "  [x] # reopening an implicit table\n"
+        "r.s = 2\n"
+        "[server.alpha]\n"
+        "ip = \"10.0.0.1\"");
+
+    const auto expected = toml::parse_str(content);
+
+    const auto res = parse_in_parallel(content);
+    REQUIRE_UNARY(res.is_ok());
+    CHECK_EQ(res.unwrap(), expected);
+    CHECK_EQ(toml::format(res.unwrap()), toml::format(expected));
+
+    const auto& ip = res.unwrap().at("server").at("alpha").at("ip");
+    CHECK_EQ(ip.location().first_line_number(), 20);
+    CHECK_EQ(ip.location().first_line(), "ip = \"10.0.0.1\"");
+}
+
+TEST_CASE("testing parse_parallel reports the same errors as parse")
+{
+    const std::vector<std::string> contents{
+        // a syntax error in a section
+        "a = 1\n[t]\nb = '''\n[u]\nc = \"unterminated\n[t]\n",
+        // redefinition of a table in another section
+        "[t]\na = 1\n[u]\nb = 2\n[t]\nc = 3\n",
+        // reopening a dotted-key table by a header
+        "[t]\nu.v = 1\n[t.u]\nw = 2\n",
+        // reopening an implicit table by dotted keys
+        "[x.y.z]\nw = 1\n[x]\ny.c = 2\n",
+        // keys that conflict with an implicit table
+        "[x.y.z]\nw = 1\n[x]\ny = 2\n",
+        // appending to a static array
+        "a = [{b = 1}]\n[[a]]\nb = 2\n",
+    };
+
+    for(const auto& content : contents)
+    {
+        const auto expected = toml::try_parse(
+            std::vector<unsigned char>(content.begin(), content.end()), "parallel");
+        REQUIRE_UNARY(expected.is_err());
+
+        const auto res = parse_in_parallel(content);
+        REQUIRE_UNARY(res.is_err());
+        CHECK_EQ(format_errors(res.unwrap_err()), format_errors(expected.unwrap_err()));
+    }
+}
+
+TEST_CASE("testing parse_parallel with a file")
+{
+    const std::string fname("test_parse_parallel.toml");
+    {
+        std::ofstream ofs(fname);
+        ofs << "title = \"rules\"\n";
+        for(int i=0; i<1000; ++i)
+        {
+            ofs << "\n[[rule]]\nid = " << i << "\nname = \"rule-" << i << "\"\n";
+        }
+    }
+
+    const auto expected = toml::parse(fname);
+    for(const std::size_t num_threads : {std::size_t(0), std::size_t(1), std::size_t(3)})
+    {
+        const auto v = toml::parse_parallel(fname, toml::spec::default_version(), num_threads);
+        CHECK_EQ(v, expected);
+        REQUIRE_EQ(v.at("rule").size(), 1000);
+        CHECK_EQ(v.at("rule").at(999).at("id").as_integer(), 999);
+    }
+    std::remove(fname.c_str());
+
+    const auto res = toml::try_parse_parallel("nonexistent.toml");
+    CHECK_UNARY(res.is_err());
+    CHECK_THROWS_AS(toml::parse_parallel("nonexistent.toml"), toml::file_io_error);
+}
+
+TEST_CASE("testing parallel_for")
+{
+    std::vector<std::atomic<int>> called(100);
+    for(auto& c : called) {c.store(0);}
+
+    toml::detail::parallel_for(called.size(), 4, [&](const std::size_t i) {
+        called.at(i).fetch_add(1);
+    });
+    for(const auto& c : called)
+    {
+        CHECK_EQ(c.load(), 1);
+    }
+
+    CHECK_THROWS_AS(toml::detail::parallel_for(100, 4, [](const std::size_t i) {
+            if(i == 42) {throw std::runtime_error("42");}
+        }), std::runtime_error);
+}
@@ -0,0 +1,237 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "utility.hpp"
+
+#include <toml.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(TOML11_HAS_POSIX_FD)
+#include <unistd.h>
+#endif
+
+namespace
+{
+// reads `content` in chunks of `chunk` bytes and splits it at every header
+toml::result<toml::value, std::vector<toml::error_info>>
+parse_in_sections(const std::string& content, const std::size_t chunk,
+                  const toml::spec s = toml::spec::default_version())
+{
+    std::size_t pos = 0;
+    toml::detail::section_reader reader(
+        [&content, &pos](unsigned char* buf, const std::size_t len)
+            -> toml::result<std::size_t, std::string>
+        {
+            const auto n = (std::min)(len, content.size() - pos);
+            std::memcpy(buf, content.data() + pos, n);
+            pos += n;
+            return toml::ok(n);
+        }, s, /*section size = */1, chunk);
+
+    return toml::detail::parse_stream_impl<toml::type_config>(reader, "stream", s);
+}
+} // anonymous
+
+TEST_CASE("testing section_reader")
+{
+    const std::string content(
+        "a = 1\n"
+        "b = [\n"
+        "[1, 2],\n"
+        "]\n"
+        "c = \"\"\"\n"
+        "[not.a.table]\n"
+        "\"\"\"\n"
+        "\n"
+        "# comment for t\n"
+        "[t]\n"
+        "x = 1\n"
+        "[[arr]]");
+
+    std::size_t pos = 0;
+    toml::detail::section_reader reader(
+        [&content, &pos](unsigned char* buf, const std::size_t len)
+            -> toml::result<std::size_t, std::string>
+        {
+            const auto n = (std::min)(len, content.size() - pos);
+            std::memcpy(buf, content.data() + pos, n);
+            pos += n;
+            return toml::ok(n);
+        }, toml::spec::default_version(), 1, 3);
+
+    // the first section ends before the comment for [t]
+    const auto s1 = reader.next();
+    REQUIRE_UNARY(s1.is_ok());
+    REQUIRE_UNARY(s1.unwrap());
+    CHECK_EQ(s1.unwrap()->substr(0, s1.unwrap()->size()),
+        "a = 1\nb = [\n[1, 2],\n]\nc = \"\"\"\n[not.a.table]\n\"\"\"\n");
+    CHECK_EQ(s1.unwrap()->line_offset(), 0);
+
+    const auto s2 = reader.next();
+    REQUIRE_UNARY(s2.is_ok());
+    REQUIRE_UNARY(s2.unwrap());
+    CHECK_EQ(s2.unwrap()->substr(0, s2.unwrap()->size()), "\n# comment for t\n[t]\nx = 1\n");
+    CHECK_EQ(s2.unwrap()->line_offset(), 7);
+
+    // the last section has the logical newline
+    const auto s3 = reader.next();
+    REQUIRE_UNARY(s3.is_ok());
+    REQUIRE_UNARY(s3.unwrap());
+    CHECK_EQ(s3.unwrap()->substr(0, s3.unwrap()->size()), "[[arr]]\n");
+    CHECK_UNARY(s3.unwrap()->appends_newline());
+    CHECK_EQ(s3.unwrap()->line_offset(), 11);
+
+    const auto s4 = reader.next();
+    REQUIRE_UNARY(s4.is_ok());
+    CHECK_UNARY( ! s4.unwrap());
+}
+
+TEST_CASE("testing parse_stream is the same as parse")
+{
+    const std::string content(
+        "\xEF\xBB\xBF# top comment\n"
+        "\n"
+        "title = \"stream\"\n"
+        "\n"
+        "# comment for server\n"
+        "[server]\n"
+        "ports = [ 8000,\n"
+        "  8001 ]\n"
+        "[[products]] # trailing\n"
+        "name = \"a\"\n"
+        "[[products]]\n"
+        "name = \"b\"\n"
+        "[server.alpha]\n"
+        "ip = \"10.0.0.1\"");
+
+    const auto expected = toml::parse_str(content);
+    for(const std::size_t chunk : {std::size_t(1), std::size_t(5), std::size_t(4096)})
+    {
+        const auto res = parse_in_sections(content, chunk);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap(), expected);
+        CHECK_EQ(toml::format(res.unwrap()), toml::format(expected));
+
+        const auto& ip = res.unwrap().at("server").at("alpha").at("ip");
+        CHECK_EQ(ip.location().first_line_number(), 14);
+        CHECK_EQ(ip.location().first_line(), "ip = \"10.0.0.1\"");
+    }
+
+    std::istringstream iss(content);
+    CHECK_EQ(toml::parse_stream(iss, "stream"), expected);
+}
+
+TEST_CASE("testing parse_stream reports the same errors as parse")
+{
+    const std::string content(
+        "a = 1\n"
+        "[t]\n"
+        "b = '''\n"
+        "[u]\n"
+        "c = \"unterminated\n"
+        "[t]\n");
+
+    const auto expected = toml::try_parse(
+        std::vector<unsigned char>(content.begin(), content.end()), "stream");
+    REQUIRE_UNARY(expected.is_err());
+
+    for(const std::size_t chunk : {std::size_t(1), std::size_t(5), std::size_t(4096)})
+    {
+        const auto res = parse_in_sections(content, chunk);
+        REQUIRE_UNARY(res.is_err());
+        CHECK_EQ(format_errors(res.unwrap_err()), format_errors(expected.unwrap_err()));
+    }
+}
+
+TEST_CASE("testing parse_stream reports the errors in every section")
+{
+    const std::string content(
+        "a = 1\n"
+        "a = 2\n"
+        "[t]\n"
+        "b = [1 2]\n"
+        "[u]\n"
+        "c = 1\n"
+        "c = 2\n");
+
+    const auto expected = toml::try_parse(
+        std::vector<unsigned char>(content.begin(), content.end()), "stream");
+    REQUIRE_UNARY(expected.is_err());
+    REQUIRE_EQ(expected.unwrap_err().size(), 3);
+
+    for(const std::size_t chunk : {std::size_t(1), std::size_t(5), std::size_t(4096)})
+    {
+        const auto res = parse_in_sections(content, chunk);
+        REQUIRE_UNARY(res.is_err());
+        CHECK_EQ(format_errors(res.unwrap_err()), format_errors(expected.unwrap_err()));
+    }
+}
+
+TEST_CASE("testing parse_large_impl parses a file in sections")
+{
+    // a file larger than region::max_source_size() is parsed in this way
+    const std::string content(
+        "# root\n"
+        "\n"
+        "a = 1\n"
+        "[t]\n"
+        "b = 2\n"
+        "# comment for u\n"
+        "[[u]]\n"
+        "c = 3\n"
+        "[[u]]\n"
+        "c = 4\n");
+
+    const auto expected = toml::parse_str(content);
+
+    toml::detail::context<toml::type_config> ctx(toml::spec::default_version());
+    const auto res = toml::detail::parse_large_impl<toml::type_config>(
+        toml::detail::make_string_source(content), "large", ctx);
+    REQUIRE_UNARY(res.is_ok());
+    CHECK_EQ(res.unwrap(), expected);
+    CHECK_EQ(res.unwrap().at("u").at(1).at("c").location().first_line_number(), 10);
+}
+
+TEST_CASE("testing parse_stream with an empty input")
+{
+    std::istringstream iss("");
+    const auto v = toml::parse_stream(iss);
+    CHECK_UNARY(v.is_table());
+    CHECK_UNARY(v.as_table().empty());
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+TEST_CASE("testing parse_stream from a pipe")
+{
+    const std::string content("a = 42\n[t]\nb = \"pipe\"");
+
+    int fds[2];
+    REQUIRE_EQ(::pipe(fds), 0);
+    REQUIRE_EQ(::write(fds[1], content.data(), content.size()),
+               static_cast<ssize_t>(content.size()));
+    ::close(fds[1]);
+
+    const auto v = toml::parse_stream(fds[0], "pipe");
+    ::close(fds[0]);
+
+    CHECK_EQ(v.at("a").as_integer(), 42);
+    CHECK_EQ(v.at("t").at("b").as_string(), "pipe");
+    CHECK_EQ(v.at("t").at("b").location().file_name(), "pipe");
+
+    // FILE* and istream overloads of parse also accept a pipe
+    REQUIRE_EQ(::pipe(fds), 0);
+    REQUIRE_EQ(::write(fds[1], content.data(), content.size()),
+               static_cast<ssize_t>(content.size()));
+    ::close(fds[1]);
+
+    FILE* fp = ::fdopen(fds[0], "rb");
+    REQUIRE_UNARY(fp != nullptr);
+    const auto w = toml::parse(fp, "pipe");
+    std::fclose(fp);
+    CHECK_EQ(v, w);
+}
+#endif
@@ -67,6 +67,69 @@ TEST_CASE("testing basic string")
         string_fmt(), ctx);
 }
 
+TEST_CASE("testing long basic and literal strings")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+    const auto string_fmt = [](const toml::string_format f) {
+        toml::string_format_info fmt;
+        fmt.fmt = f;
+        return fmt;
+    };
+
+    // long enough to use vector instructions, with non-ASCII and escape
+    // sequences placed across the vector boundaries.
+    const std::string blob = "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAu1SU1LfVLPHCozMxH2Mo";
+    const std::string kanji = "\xE4\xB8\xAD\xE5\x9B\xBD";
+
+    toml11_test_parse_success<toml::value_t::string>(
+        "\"" + blob + blob + "\"", blob + blob, comments(),
+        string_fmt(toml::string_format::basic), ctx);
+    toml11_test_parse_success<toml::value_t::string>(
+        "\"" + blob + "\\n" + kanji + blob.substr(0, 13) + "\\t\\u00E9" + blob + "\\\\\"",
+        blob + "\n" + kanji + blob.substr(0, 13) + "\t\xC3\xA9" + blob + "\\", comments(),
+        string_fmt(toml::string_format::basic), ctx);
+    toml11_test_parse_success<toml::value_t::string>(
+        "'" + blob + "\\n" + kanji + blob.substr(0, 13) + "\"" + blob + "'",
+        blob + "\\n" + kanji + blob.substr(0, 13) + "\"" + blob, comments(),
+        string_fmt(toml::string_format::literal), ctx);
+}
+
+TEST_CASE("testing escape sequences in long strings")
+{
+    toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
+
+    std::string basic, ml, expected, ml_expected;
+    for(std::size_t i=0; i<1000; ++i)
+    {
+        basic       += "a\\tb\\\"\\u00E9";
+        ml          += "a\\tb\\\"\\u00E9 \\\n   c\n";
+        expected    += "a\tb\"\xC3\xA9";
+        ml_expected += "a\tb\"\xC3\xA9 c\n";
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("\"" + basic + "\"");
+        const auto res = toml::detail::parse_string(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_string(), expected);
+        CHECK_UNARY(loc.eof());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("\"\"\"\n" + ml + "\"\"\"");
+        const auto res = toml::detail::parse_string(loc, ctx);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap().as_string(), ml_expected);
+        CHECK_UNARY(loc.eof());
+    }
+    {
+        // the error points the escape sequence in the original source
+        auto loc = toml::detail::make_temporary_location(
+                "\"\"\"\n" + ml + "\\uD800\"\"\"");
+        const auto res = toml::detail::parse_string(loc, ctx);
+        REQUIRE_UNARY(res.is_err());
+        CHECK_EQ(res.unwrap_err().locations().front().first.first_line_number(), 2002);
+    }
+}
+
 TEST_CASE("testing multiline basic string")
 {
     toml::detail::context<toml::type_config> ctx(toml::spec::v(1,0,0));
@@ -0,0 +1,161 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+struct pooled_config : toml::type_config
+{
+    using comment_type = toml::pooled_comments;
+};
+using pooled_value = toml::basic_value<pooled_config>;
+} // anonymous
+
+TEST_CASE("testing pooled_comments as a container")
+{
+    CHECK_UNARY(sizeof(toml::pooled_comments) < sizeof(toml::preserve_comments));
+
+    toml::pooled_comments com;
+    CHECK_UNARY(com.empty());
+    CHECK_UNARY(com.begin() == com.end());
+
+    com.push_back("# foo");
+    com.emplace_back("# bar");
+    com.push_back("");
+    CHECK_EQ(com.size(), 3);
+    CHECK_EQ(com.front(), "# foo");
+    CHECK_EQ(com.at(1), "# bar");
+    CHECK_EQ(com.back(), "");
+    CHECK_THROWS_AS(com.at(3), std::out_of_range);
+
+    const std::vector<std::string> lines(com.begin(), com.end());
+    CHECK_EQ(lines, std::vector<std::string>{"# foo", "# bar", ""});
+    CHECK_EQ(*com.rbegin(), "");
+    CHECK_EQ(com.end() - com.begin(), 3);
+
+    com.pop_back();
+    CHECK_EQ(com, toml::pooled_comments{"# foo", "# bar"});
+    CHECK_NE(com, toml::pooled_comments{"# foo"});
+    CHECK_UNARY(toml::pooled_comments{"# foo"} < com);
+    CHECK_UNARY(toml::pooled_comments{"# a", "# z"} < toml::pooled_comments{"# b"});
+
+    // conversions
+    const toml::preserve_comments pre(com);
+    CHECK_EQ(pre, toml::preserve_comments{"# foo", "# bar"});
+    CHECK_EQ(toml::pooled_comments(pre), com);
+    CHECK_UNARY(toml::pooled_comments(toml::discard_comments{}).empty());
+
+    std::ostringstream oss;
+    oss << com;
+    CHECK_EQ(oss.str(), "# foo\n# bar\n");
+
+    com.clear();
+    CHECK_UNARY(com.empty());
+    CHECK_UNARY(com.pool() == nullptr);
+}
+
+TEST_CASE("testing pooled_comments lines are read-only")
+{
+    // a line is a read-only view, so modifying it in place must not compile
+    toml::pooled_comments com{"# foo"};
+    CHECK_UNARY( ! std::is_assignable<decltype(com[0]),        std::string>::value);
+    CHECK_UNARY( ! std::is_assignable<decltype(com.front()),   std::string>::value);
+    CHECK_UNARY( ! std::is_assignable<decltype(*com.begin()),  std::string>::value);
+    CHECK_UNARY( ! std::is_assignable<decltype(*com.rbegin()), std::string>::value);
+    CHECK_UNARY( ! std::is_assignable<toml::pooled_comments::reference, const char*>::value);
+
+    const std::string line = com[0];
+    CHECK_EQ(line, "# foo");
+}
+
+TEST_CASE("testing pooled_comments lines refer to the pool")
+{
+    using iterator = toml::pooled_comments::const_iterator;
+    CHECK_UNARY(std::is_same<std::iterator_traits<iterator>::iterator_category,
+                             std::input_iterator_tag>::value);
+    CHECK_UNARY(std::is_same<std::iterator_traits<iterator>::reference,
+                             const toml::detail::pooled_comment_line>::value);
+#if defined(__cpp_lib_ranges)
+    static_assert(std::random_access_iterator<iterator>, "");
+#endif
+
+    toml::pooled_comments com{"# foo", "# bar"};
+    const auto line = com[1];
+    CHECK_EQ(line.data(), com.pool()->data(1));
+    CHECK_EQ(line.size(), 5);
+    CHECK_EQ(line, "# bar");
+    CHECK_EQ(line, std::string("# bar"));
+    CHECK_NE(line, "# ba");
+    CHECK_NE(line, com[0]);
+    CHECK_UNARY(line < com[0]);
+    CHECK_EQ(line.str(), "# bar");
+    CHECK_EQ(std::string(line.begin(), line.end()), "# bar");
+    CHECK_EQ(com.begin()[1], line);
+}
+
+TEST_CASE("testing pooled_comments copies are independent")
+{
+    toml::pooled_comments a{"# a"};
+    auto b = a;
+    CHECK_EQ(a.pool(), b.pool());
+
+    b.push_back("# b");
+    CHECK_EQ(a, toml::pooled_comments{"# a"});
+    CHECK_EQ(b, toml::pooled_comments{"# a", "# b"});
+
+    a.push_back("# c");
+    CHECK_EQ(a, toml::pooled_comments{"# a", "# c"});
+    CHECK_EQ(b, toml::pooled_comments{"# a", "# b"});
+
+    auto c = std::move(a);
+    CHECK_UNARY(a.empty());
+    CHECK_EQ(c.size(), 2);
+}
+
+TEST_CASE("testing parse with pooled_comments")
+{
+    const std::string content(
+        "# root comment\n"
+        "\n"
+        "# a comment\n"
+        "a = 42 # inline\n"
+        "b = [\n"
+        "  # elem\n"
+        "  1, # one\n"
+        "  2,\n"
+        "]\n"
+        "# table\n"
+        "[t] # header\n"
+        "c = 'c'\n");
+
+    const auto v = toml::parse_str<pooled_config>(content);
+    const auto expected = toml::parse_str(content);
+    CHECK_EQ(toml::value(v), expected);
+    CHECK_EQ(pooled_value(expected), v);
+
+    CHECK_EQ(v.comments(), toml::pooled_comments{"# root comment"});
+    CHECK_EQ(v.at("a").comments(), toml::pooled_comments{"# a comment", "# inline"});
+    CHECK_EQ(v.at("b").at(0).comments(), toml::pooled_comments{"# elem", "# one"});
+    CHECK_UNARY(v.at("b").at(1).comments().empty());
+    CHECK_EQ(v.at("t").comments(), toml::pooled_comments{"# table", "# header"});
+
+    // the comments in a document share one pool
+    CHECK_EQ(v.comments().pool(), v.at("a").comments().pool());
+    CHECK_EQ(v.comments().pool(), v.at("t").comments().pool());
+
+    // modifying a comment does not change the others
+    auto w = v;
+    w.at("a").comments().push_back("# added");
+    CHECK_EQ(w.at("a").comments().size(), 3);
+    CHECK_EQ(v.at("a").comments().size(), 2);
+
+    CHECK_EQ(toml::format(v), toml::format(expected));
+    CHECK_EQ(toml::parse_str<pooled_config>(toml::format(v)), v);
+}
@@ -0,0 +1,139 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+
+namespace
+{
+const std::string config(
+    "title = \"select\"\n"
+    "owner = {name = \"a\", mail = \"a@example.com\"}\n"
+    "server.port = 8080\n"
+    "server.host = \"example.com\" # comment\n"
+    "\n"
+    "[limits]\n"
+    "max = 100\n"
+    "min = [1, 2, {x = 3}]\n"
+    "\n"
+    "[[routes]]\n"
+    "name = \"root\"\n"
+    "path = '/'\n"
+    "[[routes]]\n"
+    "name = \"\\\"quoted\\\"\"\n"
+    "path = \"\"\"\n"
+    "[not.a.table]\n"
+    "\"\"\"\n"
+    "[routes.handler]\n"
+    "name = \"h\"\n"
+    "kind = 1979-05-27T07:32:00Z\n"
+    "\n"
+    "[database]\n"
+    "ports = [ 8000, # comment\n"
+    "  8001 ]\n"
+    "servers = {alpha = {ip = \"10.0.0.1\"}, beta = {ip = \"10.0.0.2\"}}\n");
+} // anonymous
+
+TEST_CASE("testing parse with select")
+{
+    const auto v = toml::parse_str(config, toml::spec::default_version(),
+            toml::select({"server.port", "limits", "routes[*].name",
+                          "database.servers.beta"}));
+
+    const auto expected = toml::parse_str(
+        "server.port = 8080\n"
+        "[limits]\n"
+        "max = 100\n"
+        "min = [1, 2, {x = 3}]\n"
+        "[[routes]]\n"
+        "name = \"root\"\n"
+        "[[routes]]\n"
+        "name = \"\\\"quoted\\\"\"\n"
+        "[database]\n"
+        "servers = {beta = {ip = \"10.0.0.2\"}}\n");
+
+    CHECK_EQ(v, expected);
+    CHECK_EQ(toml::find<int>(v, "server", "port"), 8080);
+    CHECK_EQ(toml::find<std::string>(v, "routes", 1, "name"), "\"quoted\"");
+    CHECK_EQ(v.at("routes").at(1).at("name").location().first_line_number(), 14);
+    CHECK_UNARY_FALSE(v.contains("title"));
+    CHECK_UNARY_FALSE(v.at("routes").at(0).contains("path"));
+}
+
+TEST_CASE("testing select drops the elements that cannot have the keys")
+{
+    const auto v = toml::parse_str(
+        "a = 1\n"
+        "routes = [1, 2]\n"
+        "mixed = [1, {name = \"x\", path = \"/\"}, [2, {name = \"y\"}], []]\n",
+        toml::spec::default_version(), toml::select({"a", "routes.name", "mixed.name"}));
+
+    CHECK_EQ(v, toml::parse_str(
+        "a = 1\n"
+        "mixed = [{name = \"x\"}, [{name = \"y\"}]]\n"));
+    CHECK_UNARY_FALSE(v.contains("routes"));
+}
+
+TEST_CASE("testing parse with select checks the skipped values")
+{
+    const std::vector<std::string> contents{
+        "a = 1\nb = \"unterminated\n",
+        "a = 1\nb = [1, 2\n",
+        "a = 1\nb = {x = 1\n",
+        "a = 1\n[t]\nb = 1.\n",
+        "a = 1\nb = 1 2\n",
+        "a = 1\nb = True\n",
+        "a = 1\nb =\n",
+    };
+    for(const auto& content : contents)
+    {
+        const auto res = toml::try_parse_str(content, toml::spec::default_version(),
+                toml::select({"a"}));
+        CHECK_MESSAGE(res.is_err(), content);
+    }
+    CHECK_THROWS_AS(toml::parse_str("a = 1\nb = [1,,]\n", toml::spec::default_version(),
+                toml::select({"a"})), toml::syntax_error);
+}
+
+TEST_CASE("testing select with quoted keys")
+{
+    const auto v = toml::parse_str(
+        "\"a.b\" = 1\n"
+        "a.b = 2\n"
+        "[' c ']\n"
+        "d = 3\n"
+        "e = 4\n",
+        toml::spec::default_version(), toml::select({"\"a.b\"", "' c ' . d"}));
+
+    CHECK_EQ(v, toml::parse_str("\"a.b\" = 1\n[' c ']\nd = 3\n"));
+
+    CHECK_UNARY(toml::try_parse_str("a = 1", toml::spec::default_version(),
+                toml::select({"a..b"})).is_err());
+    CHECK_UNARY(toml::try_parse_str("a = 1", toml::spec::default_version(),
+                toml::select({""})).is_err());
+    CHECK_UNARY(toml::try_parse_str("a = 1", toml::spec::default_version(),
+                toml::select({"a[0]"})).is_err());
+}
+
+TEST_CASE("testing parse a file with select")
+{
+    const std::string fname("test_select.toml");
+    {
+        std::ofstream ofs(fname);
+        ofs << config;
+    }
+    const auto v = toml::parse(fname, toml::spec::default_version(),
+                               toml::select({"limits.max"}));
+    CHECK_EQ(v, toml::parse_str("[limits]\nmax = 100\n"));
+    std::remove(fname.c_str());
+
+    CHECK_UNARY(toml::try_parse("nonexistent.toml", toml::spec::default_version(),
+                toml::select({"a"})).is_err());
+    CHECK_THROWS_AS(toml::parse("nonexistent.toml", toml::spec::default_version(),
+                toml::select({"a"})), toml::file_io_error);
+}
@@ -0,0 +1,177 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <toml.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(TOML11_HAS_POSIX_FD)
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+std::vector<unsigned char> bytes_of(const std::string& s)
+{
+    return std::vector<unsigned char>(s.begin(), s.end());
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+// a FIFO has no size. `f` reads it while another thread writes `content`.
+template<typename F>
+void read_fifo(const std::string& content, F f)
+{
+    const std::string fname("test_source_buffer_fifo");
+    std::remove(fname.c_str());
+    REQUIRE_EQ(::mkfifo(fname.c_str(), 0600), 0);
+
+    std::thread writer([&fname, &content]() {
+            std::ofstream ofs(fname, std::ios_base::binary);
+            ofs << content;
+        });
+    f(fname);
+    writer.join();
+    std::remove(fname.c_str());
+}
+#endif
+} // anonymous
+
+TEST_CASE("testing source_buffer with the logical newline")
+{
+    const auto src = toml::detail::make_source(bytes_of("a = 1\nb = 2"), true);
+
+    CHECK_UNARY(src->appends_newline());
+    CHECK_EQ(src->size(), 12);
+    CHECK_EQ(src->at(10), '2');
+    CHECK_EQ(src->at(11), '\n');
+    CHECK_THROWS_AS(src->at(12), std::out_of_range);
+
+    // the first line refers to the bytes, the last line is a copy with LF
+    CHECK_EQ(src->end_from(0) - src->pointer_to(0), 11);
+    CHECK_EQ(src->end_from(6) - src->pointer_to(6), 6);
+    CHECK_EQ(*(src->end_from(6) - 1), '\n');
+
+    CHECK_EQ(src->substr(0, 12), "a = 1\nb = 2\n");
+    CHECK_EQ(src->substr(6, 11), "b = 2");
+    CHECK_EQ(src->line_first(8),  6);
+    CHECK_EQ(src->line_last(8),  11);
+    CHECK_EQ(src->line_first(3),  0);
+    CHECK_EQ(src->line_last(3),   5);
+}
+
+TEST_CASE("testing source_buffer without the logical newline")
+{
+    const auto with_lf = toml::detail::make_source(bytes_of("a = 1\n"), true);
+    CHECK_UNARY( ! with_lf->appends_newline());
+    CHECK_EQ(with_lf->size(), 6);
+
+    // if it ends with CR, it is reported as an error by the parser
+    const auto with_cr = toml::detail::make_source(bytes_of("a = 1\r"), true);
+    CHECK_UNARY( ! with_cr->appends_newline());
+    CHECK_EQ(with_cr->size(), 6);
+
+    const auto empty = toml::detail::make_source(bytes_of(""), true);
+    CHECK_UNARY( ! empty->appends_newline());
+    CHECK_UNARY(empty->empty());
+
+    const auto not_appended = toml::detail::make_source(bytes_of("a = 1"), false);
+    CHECK_UNARY( ! not_appended->appends_newline());
+    CHECK_EQ(not_appended->size(), 5);
+}
+
+TEST_CASE("testing parse(byte span)")
+{
+    // it does not have a newline at the end
+    const std::string str("a = 42\n[t]\nb = \"foo\" # comment");
+    const auto first = reinterpret_cast<const unsigned char*>(str.data());
+
+    const auto v = toml::parse(first, str.size(), "span.toml");
+    CHECK_EQ(v.at("a").as_integer(), 42);
+    CHECK_EQ(v.at("t").at("b").as_string(), "foo");
+    CHECK_EQ(v.at("t").at("b").comments().size(), 1);
+    CHECK_EQ(v.at("t").at("b").comments().at(0), "# comment");
+
+    // the buffer is not copied
+    const auto loc = v.at("t").at("b").location();
+    CHECK_EQ(loc.file_name(), "span.toml");
+    CHECK_EQ(loc.first_line_number(), 3);
+    CHECK_EQ(loc.first_column_number(), 5);
+    CHECK_EQ(loc.first_line(), "b = \"foo\" # comment");
+    CHECK_EQ(str, "a = 42\n[t]\nb = \"foo\" # comment");
+
+    const std::string invalid("a = 42\nb = ");
+    const auto res = toml::try_parse(
+        reinterpret_cast<const unsigned char*>(invalid.data()), invalid.size(), "span.toml");
+    REQUIRE_UNARY(res.is_err());
+    CHECK_EQ(res.unwrap_err().at(0).locations().at(0).first.first_line_number(), 2);
+}
+
+TEST_CASE("testing parse_mmap")
+{
+    const std::string fname("test_source_buffer_mmap.toml");
+    {
+        std::ofstream ofs(fname, std::ios_base::binary);
+        ofs << "title = \"mapped\"\n[server]\nports = [8000, 8001]";
+    }
+    {
+        const auto v = toml::parse_mmap(fname);
+        CHECK_EQ(v.at("title").as_string(), "mapped");
+        CHECK_EQ(v.at("server").at("ports").at(1).as_integer(), 8001);
+        CHECK_EQ(v.at("server").at("ports").location().file_name(), fname);
+
+        const auto res = toml::try_parse_mmap(fname);
+        REQUIRE_UNARY(res.is_ok());
+        CHECK_EQ(res.unwrap(), v);
+    }
+    {
+        std::ofstream ofs(fname, std::ios_base::binary | std::ios_base::trunc);
+    }
+    {
+        const auto v = toml::parse_mmap(fname);
+        CHECK_UNARY(v.is_table());
+        CHECK_UNARY(v.as_table().empty());
+    }
+    std::remove(fname.c_str());
+
+    CHECK_UNARY(toml::try_parse_mmap("nonexistent.toml").is_err());
+    CHECK_THROWS_AS(toml::parse_mmap("nonexistent.toml"), toml::file_io_error);
+}
+
+#if defined(TOML11_HAS_POSIX_FD)
+TEST_CASE("testing read_source_file reads a FIFO until EOF")
+{
+    std::string content;
+    for(std::size_t i=0; i<1000; ++i)
+    {
+        content += "key" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+    }
+    read_fifo(content, [&content](const std::string& fname) {
+            const auto src = toml::detail::read_source_file(fname);
+            REQUIRE_UNARY(src.is_ok());
+            CHECK_EQ(src.unwrap()->substr(0, src.unwrap()->size()), content);
+        });
+    read_fifo("x = 1", [](const std::string& fname) {
+            const auto res = toml::try_parse(fname, toml::spec::default_version(), toml::fail_fast);
+            REQUIRE_UNARY(res.is_ok());
+            CHECK_EQ(res.unwrap().at("x").as_integer(), 1);
+        });
+}
+
+TEST_CASE("testing parse_mmap reads a FIFO until EOF")
+{
+    read_fifo("x = 1\n[t]\ny = 2", [](const std::string& fname) {
+            const auto v = toml::parse_mmap(fname);
+            CHECK_EQ(v.at("x").as_integer(), 1);
+            CHECK_EQ(v.at("t").at("y").as_integer(), 2);
+        });
+    read_fifo("x = 1\n[t]\ny = 2", [](const std::string& fname) {
+            const auto v = toml::parse_parallel(fname);
+            CHECK_EQ(v.at("x").as_integer(), 1);
+            CHECK_EQ(v.at("t").at("y").as_integer(), 2);
+        });
+}
+#endif
@@ -56,3 +56,19 @@ TEST_CASE("testing the ordering of semantic_version")
     CHECK(v121 >  v112);
     CHECK(v121 >= v112);
 }
+
+TEST_CASE("testing the equality of spec")
+{
+    constexpr auto v100 = toml::spec::v(1, 0, 0);
+    constexpr auto v110 = toml::spec::v(1, 1, 0);
+
+    CHECK(v100 == toml::spec::v(1, 0, 0));
+    CHECK(v110 == toml::spec::v(1, 1, 0));
+    CHECK(v100 != v110);
+    CHECK_FALSE(v100 == v110);
+
+    auto s = v100;
+    s.ext_null_value = true;
+    CHECK(s != v100);
+    CHECK_FALSE(s == v100);
+}
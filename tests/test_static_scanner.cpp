@@ -0,0 +1,286 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "utility.hpp"
+
+#include <toml11/static_scanner.hpp>
+#include <toml11/syntax.hpp>
+
+#include <string>
+#include <vector>
+
+// static_scanner must accept exactly the same region as the syntax scanners.
+template<typename Scanner>
+void check_same_as(const toml::detail::scanner_base& expected,
+        const std::vector<std::string>& inputs, const toml::spec& s)
+{
+    for(const auto& in : inputs)
+    {
+        auto loc1 = toml::detail::make_temporary_location(in);
+        auto loc2 = toml::detail::make_temporary_location(in);
+
+        const auto reg1 = expected.scan(loc1);
+        const auto reg2 = toml::detail::static_scanner::scan<Scanner>(loc2, s);
+
+        CHECK_MESSAGE(reg1.is_ok() == reg2.is_ok(), in);
+        if(reg1.is_ok() && reg2.is_ok())
+        {
+            CHECK_MESSAGE(reg1.as_string() == reg2.as_string(), in);
+        }
+        CHECK_MESSAGE(loc1.get_location() == loc2.get_location(), in);
+    }
+}
+
+TEST_CASE("testing static_scanner: combinators")
+{
+    namespace ss = toml::detail::static_scanner;
+    const auto s = toml::spec::default_version();
+
+    {
+        auto loc = toml::detail::make_temporary_location("abcd");
+        CHECK_UNARY( ss::scan<ss::literal<'a', 'b'>>(loc, s).is_ok());
+        CHECK_UNARY(!ss::scan<ss::literal<'a', 'b'>>(loc, s).is_ok());
+        CHECK_UNARY( ss::scan<ss::character_either<'x', 'c'>>(loc, s).is_ok());
+        CHECK_UNARY( ss::scan<ss::character_in_range<'a', 'd'>>(loc, s).is_ok());
+        CHECK_UNARY(!ss::scan<ss::character<'d'>>(loc, s).is_ok());
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("aaab");
+        const auto reg = ss::scan<ss::sequence<
+            ss::repeat_at_least<1, ss::character<'a'>>, ss::character<'b'>>>(loc, s);
+        CHECK_UNARY(reg.is_ok());
+        CHECK_EQ(reg.as_string(), "aaab");
+    }
+    {
+        // sequence restores the position if it fails in the middle
+        auto loc = toml::detail::make_temporary_location("aaac");
+        const auto reg = ss::scan<ss::sequence<
+            ss::repeat_at_least<1, ss::character<'a'>>, ss::character<'b'>>>(loc, s);
+        CHECK_UNARY(!reg.is_ok());
+        CHECK_EQ(loc.get_location(), 0);
+    }
+    {
+        auto loc = toml::detail::make_temporary_location("12a");
+        CHECK_UNARY(!ss::scan<ss::repeat_exact<3, ss::digit>>(loc, s).is_ok());
+        CHECK_UNARY( ss::scan<ss::repeat_exact<2, ss::digit>>(loc, s).is_ok());
+        CHECK_UNARY( ss::scan<ss::maybe<ss::digit>>(loc, s).is_ok());
+        CHECK_EQ(loc.get_location(), 2);
+    }
+}
+
+TEST_CASE("testing static_scanner: key")
+{
+    const std::vector<std::string> inputs = {
+        "barekey", "bare-key", "bare_key", "1234", "a.b.c", "x . y",
+        "site.\"google.com\"", "3.14159", "\"127.0.0.1\"", "'key2'",
+        "a.", ".a", "=", "\"unterminated",
+        "\xCA\x8E\xC7\x9D\xCA\x9E", "a.\xCA\x8E\xC7\x9D", "\xC2\xB2", "\xE2\x80\x8C",
+    };
+    check_same_as<toml::detail::static_scanner::key>(
+        toml::detail::syntax::key(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+    check_same_as<toml::detail::static_scanner::key>(
+        toml::detail::syntax::key(toml::spec::v(1,1,0)), inputs, toml::spec::v(1,1,0));
+}
+
+TEST_CASE("testing static_scanner: table headers")
+{
+    const std::vector<std::string> inputs = {
+        "[a]", "[ a.b ]", "[\"a.b\".c]", "['a']", "[[a]]", "[[ a . b ]]",
+        "[a", "[]", "[[a]", "[[a] ]", "[ [a]]", "[a]]", "[a.]",
+    };
+    check_same_as<toml::detail::static_scanner::std_table>(
+        toml::detail::syntax::std_table(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+    check_same_as<toml::detail::static_scanner::array_table>(
+        toml::detail::syntax::array_table(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+}
+
+TEST_CASE("testing static_scanner: basic_string")
+{
+    std::vector<std::string> inputs = {
+        "\"\"", "\"foo\"", "\"foo\\\"bar\"", "\"tab\\tnewline\\n\"",
+        "\"\\u00E9\\U0001F600\"", "\"\\x41\"", "\"\\e[0m\"", "\"\\q\"",
+        "\"\xCA\x8E\xC7\x9D\"", "\"\xC0\x80\"", "\"unterminated", "\"new\nline\"",
+        "\"\\u00\"", "'literal'",
+    };
+    // long enough to use vector instructions
+    const std::string pad(40, 'x');
+    for(const std::string c : {"\\n", "\\u00E9", "\\q", "\t", "\x01", "\x1F", "\x7F",
+                               "\n", "\xE3\x81\x82", "\xC0\x80", "\xE3\x81", "'"})
+    {
+        inputs.push_back("\"" + c + pad + "\"");
+        inputs.push_back("\"" + pad + c + pad + "\"");
+        inputs.push_back("\"" + pad + pad.substr(0, 7) + c + "\"");
+    }
+    inputs.push_back("\"" + pad + pad);
+    check_same_as<toml::detail::static_scanner::basic_string>(
+        toml::detail::syntax::basic_string(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+    check_same_as<toml::detail::static_scanner::basic_string>(
+        toml::detail::syntax::basic_string(toml::spec::v(1,1,0)), inputs, toml::spec::v(1,1,0));
+}
+
+TEST_CASE("testing static_scanner: ml_basic_string")
+{
+    std::vector<std::string> inputs = {
+        "\"\"\"\"\"\"", "\"\"\"\nfoo\"\"\"", "\"\"\"\r\nfoo\nbar\r\n\"\"\"",
+        "\"\"\"a\"b\"\"c\"\"\"", "\"\"\"\"a\"\"\"", "\"\"\"\"\"a\"\"\"",
+        "\"\"\"a\"\"\"\"", "\"\"\"a\"\"\"\"\"", "\"\"\"a\"\"\"\"\"\"",
+        "\"\"\"a \\\n   b\"\"\"", "\"\"\"a \\  \n \n  b\"\"\"", "\"\"\"a \\ b\"\"\"",
+        "\"\"\"\\u00E9\\x41\\e\"\"\"", "\"\"\"\\q\"\"\"", "\"\"\"a\rb\"\"\"",
+        "\"\"\"\xCA\x8E\xC7\x9D\"\"\"", "\"\"\"\xC0\x80\"\"\"", "\"\"\"unterminated\"\"",
+        "\"\"\"a\"\"", "\"foo\"",
+    };
+    const std::string pad(40, 'x');
+    for(const std::string c : {"\\n", "\\\n  ", "\"", "\"\"", "\n", "\r\n", "\t",
+                               "\x01", "\x7F", "\xE3\x81\x82", "\xE3\x81"})
+    {
+        inputs.push_back("\"\"\"" + c + pad + "\"\"\"");
+        inputs.push_back("\"\"\"" + pad + c + pad + "\"\"\"");
+        inputs.push_back("\"\"\"" + pad + pad.substr(0, 7) + c + "\"\"\"");
+    }
+    check_same_as<toml::detail::static_scanner::ml_basic_string>(
+        toml::detail::syntax::ml_basic_string(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+    check_same_as<toml::detail::static_scanner::ml_basic_string>(
+        toml::detail::syntax::ml_basic_string(toml::spec::v(1,1,0)), inputs, toml::spec::v(1,1,0));
+}
+
+TEST_CASE("testing static_scanner: literal_string")
+{
+    std::vector<std::string> inputs = {
+        "''", "'foo'", "'C:\\Users\\nodejs'", "'<\\i\\c*\\s*>'", "'\"quoted\"'",
+        "'\xCA\x8E\xC7\x9D'", "'\xC0\x80'", "'unterminated", "'new\nline'",
+        "\"basic\"",
+    };
+    const std::string pad(40, 'x');
+    for(const std::string c : {"\\", "\"", "\t", "\x01", "\x1F", "\x7F", "\n",
+                               "\xE3\x81\x82", "\xF0\x9F\x98\x80", "\xC0\x80", "\xFF"})
+    {
+        inputs.push_back("'" + c + pad + "'");
+        inputs.push_back("'" + pad + c + pad + "'");
+        inputs.push_back("'" + pad + pad.substr(0, 7) + c + "'");
+    }
+    inputs.push_back("'" + pad + pad);
+    check_same_as<toml::detail::static_scanner::literal_string>(
+        toml::detail::syntax::literal_string(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+}
+
+TEST_CASE("testing static_scanner: floating")
+{
+    const std::vector<std::string> inputs = {
+        "+1.0", "3.1415", "-0.01", "5e+22", "1e06", "-2E-2", "6.626e-34",
+        "224_617.445_991_228", "inf", "+inf", "-nan", "1.", ".5", "1e", "1_.0",
+        "1__0.0", "01.0", "0.0", "1234", "1.0e_3", "infinity",
+    };
+    check_same_as<toml::detail::static_scanner::floating>(
+        toml::detail::syntax::floating(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+}
+
+TEST_CASE("testing static_scanner: comment")
+{
+    // long enough to use vector instructions
+    const std::string pad(40, 'x');
+
+    std::vector<std::string> inputs = {
+        "#", "# comment", "#\tcomment\n", "# comment\r\n", "not a comment",
+        "# \xCA\x8E\xC7\x9D\xCA\x9E", "# invalid UTF-8 \xC0\x80", "# DEL \x7F",
+        "# truncated \xE3\x81",
+    };
+    for(const std::string c : {"\x01", "\x08", "\x0B", "\x0D", "\x1F", "\x7F",
+                               "\xE3\x81\x82", "\xFF", "\n", "\r\n"})
+    {
+        inputs.push_back("#" + c + pad);
+        inputs.push_back("#" + pad + c + pad);
+        inputs.push_back("#" + pad + pad.substr(0, 7) + c);
+    }
+    inputs.push_back(std::string("#") + pad + std::string(1, '\0') + pad);
+
+    check_same_as<toml::detail::static_scanner::comment>(
+        toml::detail::syntax::comment(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+    check_same_as<toml::detail::static_scanner::comment>(
+        toml::detail::syntax::comment(toml::spec::v(1,1,0)), inputs, toml::spec::v(1,1,0));
+}
+
+TEST_CASE("testing static_scanner: whitespace")
+{
+    std::vector<std::string> inputs = {"", "a", " a", "\t\t a", " \n"};
+    for(const std::size_t n : std::vector<std::size_t>{15, 16, 17, 31, 32, 33, 64, 100})
+    {
+        inputs.push_back(std::string(n, ' ') + "x");
+        inputs.push_back(std::string(n, '\t') + "\n");
+        inputs.push_back(std::string(n, ' '));
+    }
+    check_same_as<toml::detail::static_scanner::ws>(
+        toml::detail::syntax::ws(toml::spec::v(1,0,0)), inputs, toml::spec::v(1,0,0));
+}
+
+TEST_CASE("testing static_scanner: lex_number")
+{
+    const auto lex = [](const std::string& in, const toml::spec& s) {
+        const auto loc = toml::detail::make_temporary_location(in);
+        return toml::detail::static_scanner::lex_number(loc, s);
+    };
+    const auto v100 = toml::spec::v(1,0,0);
+    const auto v110 = toml::spec::v(1,1,0);
+
+    const std::vector<std::pair<std::string, toml::value_t>> valid = {
+        {"42",             toml::value_t::integer},
+        {"-17",            toml::value_t::integer},
+        {"+0",             toml::value_t::integer},
+        {"1_000_000",      toml::value_t::integer},
+        {"0xDEAD_beef",    toml::value_t::integer},
+        {"0o755",          toml::value_t::integer},
+        {"0b1101_0101",    toml::value_t::integer},
+        {"3.14",           toml::value_t::floating},
+        {"-0.0",           toml::value_t::floating},
+        {"6.626e-34",      toml::value_t::floating},
+        {"1E+6",           toml::value_t::floating},
+        {"224_617.445_991", toml::value_t::floating},
+        {"+inf",           toml::value_t::floating},
+        {"-nan",           toml::value_t::floating},
+        {"07:32:00",       toml::value_t::local_time},
+        {"00:32:00.999999", toml::value_t::local_time},
+        {"1979-05-27",     toml::value_t::local_date},
+        {"1979-05-27T07:32:00",       toml::value_t::local_datetime},
+        {"1979-05-27 07:32:00.999",   toml::value_t::local_datetime},
+        {"1979-05-27T07:32:00Z",      toml::value_t::offset_datetime},
+        {"1979-05-27t00:32:00-07:00", toml::value_t::offset_datetime},
+    };
+    for(const auto& v : valid)
+    {
+        for(const std::string tail : {"", "\n", " # comment", ",", "]", "}"})
+        {
+            const auto tk = lex(v.first + tail, v100);
+            CHECK_MESSAGE(tk.type == v.second, v.first + tail);
+            CHECK_MESSAGE(tk.length == v.first.size(), v.first + tail);
+        }
+    }
+
+    // the lengths of the date and the time parts
+    CHECK_EQ(lex("1979-05-27",                 v100).date_length, 10);
+    CHECK_EQ(lex("1979-05-27",                 v100).time_length, 0);
+    CHECK_EQ(lex("07:32:00.999",               v100).time_length, 12);
+    CHECK_EQ(lex("1979-05-27T07:32:00.5+09:00", v100).date_length, 10);
+    CHECK_EQ(lex("1979-05-27T07:32:00.5+09:00", v100).time_length, 10);
+    CHECK_EQ(lex("1979-05-27 07:32Z",          v110).time_length, 5);
+    CHECK_EQ(lex("3.14",                       v100).date_length, 0);
+
+    // a space followed by a non-digit is not a part of the datetime
+    CHECK_EQ(lex("1979-05-27 # date", v100).type,   toml::value_t::local_date);
+    CHECK_EQ(lex("1979-05-27 # date", v100).length, 10);
+
+    // seconds are optional in v1.1.0
+    CHECK_EQ(lex("07:32",            v100).type, toml::value_t::empty);
+    CHECK_EQ(lex("07:32",            v110).type, toml::value_t::local_time);
+    CHECK_EQ(lex("1979-05-27T07:32", v110).type, toml::value_t::local_datetime);
+
+    // malformed tokens are left to the syntax rules
+    const std::vector<std::string> invalid = {
+        "0123", "1__0", "_1", "1_", "1.", ".5", "1e", "1.0e_3", "+0x1F", "0xG",
+        "0o8", "0b2", "1979-5-27", "1979-05-27T7:32:00", "1979-05-27 7:32:00",
+        "1979-05-27T07:32:00+9:00", "7:32:00", "07:32:00.", "1.0_ms", "42abc",
+        "infinity", "1979-05-2", "12-34",
+    };
+    for(const auto& in : invalid)
+    {
+        CHECK_MESSAGE(lex(in, v100).type == toml::value_t::empty, in);
+    }
+}
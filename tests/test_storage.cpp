@@ -76,3 +76,36 @@ TEST_CASE("testing storage move")
     CHECK_EQ(x.get(), 42);
     CHECK_NE(x.get(), 6*9);
 }
+
+TEST_CASE("testing shared_storage copy-on-write")
+{
+    toml::detail::shared_storage<int> x(42);
+    toml::detail::shared_storage<int> y(x);
+
+    REQUIRE_UNARY(x.is_ok());
+    REQUIRE_UNARY(y.is_ok());
+    CHECK_UNARY(x.is_shared());
+    CHECK_EQ(&x.get(), &y.get());
+
+    x.get_mutable() = 6 * 9;
+
+    CHECK_UNARY( ! x.is_shared());
+    CHECK_UNARY( ! y.is_shared());
+    CHECK_EQ(x.get(), 6*9);
+    CHECK_EQ(y.get(), 42);
+
+    // not shared. modified in place
+    const int* p = &y.get();
+    y.get_mutable() = 0;
+    CHECK_EQ(&y.get(), p);
+    CHECK_EQ(y.get(), 0);
+
+    x = y;
+    CHECK_UNARY(x.is_shared());
+    CHECK_EQ(x.get(), 0);
+
+    toml::detail::shared_storage<int> z(std::move(y));
+    CHECK_UNARY( ! y.is_ok());
+    CHECK_UNARY(z.is_shared());
+    CHECK_EQ(z.get(), 0);
+}
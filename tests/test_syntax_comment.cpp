@@ -14,3 +14,19 @@ TEST_CASE("testing comment")
     test_scan_success(scanner, "#   \r\n", "#   ");
     test_scan_success(scanner, "# # \n",   "# # ");
 }
+
+TEST_CASE("testing scanner cache")
+{
+    const auto v100 = toml::spec::v(1,0,0);
+    const auto v110 = toml::spec::v(1,1,0);
+
+    const auto& s1 = toml::detail::syntax::comment(v100);
+    const auto& s2 = toml::detail::syntax::comment(v100);
+    CHECK(&s1 == &s2);
+
+    // control characters are allowed only in v1.1.0
+    const auto scanner100 = toml::detail::syntax::comment(v100);
+    const auto scanner110 = toml::detail::syntax::comment(v110);
+    test_scan_success(scanner100, "#\x01", "#");
+    test_scan_success(scanner110, "#\x01", "#\x01");
+}
@@ -23,6 +23,16 @@ void test_scan_failure(const toml::detail::scanner_base& s,
     CHECK_UNARY_FALSE(reg.is_ok());
 }
 
+std::string format_errors(const std::vector<toml::error_info>& errs)
+{
+    std::string msg;
+    for(const auto& e : errs)
+    {
+        msg += toml::format_error(e);
+    }
+    return msg;
+}
+
 namespace toml
 {
 
@@ -35,6 +35,9 @@ void test_scan_success(const toml::detail::scanner_base& s,
 void test_scan_failure(const toml::detail::scanner_base& s,
         const std::string& in);
 
+// concatenates the formatted messages to show them on failure
+std::string format_errors(const std::vector<toml::error_info>& errs);
+
 template<toml::value_t VT, typename T, typename Format, typename TC>
 void toml11_test_parse_success(
         std::string in, const T& out,